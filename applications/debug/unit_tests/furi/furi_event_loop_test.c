@@ -0,0 +1,146 @@
+#include <furi.h>
+#include "../minunit.h"
+
+#define EVENT_LOOP_TEST_EVENTS 16
+#define EVENT_LOOP_TEST_TIMER_INTERVAL 5
+#define EVENT_LOOP_TEST_TIMER_TICKS 3
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriMessageQueue* message_queue;
+    FuriPoolQueue* pool_queue;
+    FuriStreamBuffer* stream_buffer;
+    FuriSemaphore* semaphore;
+    FuriEventLoopTimer* timer;
+
+    uint32_t messages;
+    uint32_t pool_messages;
+    uint32_t bytes;
+    uint32_t releases;
+    uint32_t ticks;
+    bool failed;
+} EventLoopTest;
+
+static void test_event_loop_check_done(EventLoopTest* test) {
+    if(test->messages == EVENT_LOOP_TEST_EVENTS && test->pool_messages == EVENT_LOOP_TEST_EVENTS &&
+       test->bytes == EVENT_LOOP_TEST_EVENTS && test->releases == EVENT_LOOP_TEST_EVENTS &&
+       test->ticks == EVENT_LOOP_TEST_TIMER_TICKS) {
+        furi_event_loop_stop(test->event_loop);
+    }
+}
+
+static void test_event_loop_message_queue_callback(void* object, void* context) {
+    EventLoopTest* test = context;
+    uint32_t message;
+    furi_check(furi_message_queue_get(object, &message, 0) == FuriStatusOk);
+    test->failed |= (message != test->messages++);
+    test_event_loop_check_done(test);
+}
+
+static void test_event_loop_pool_queue_callback(void* object, void* context) {
+    EventLoopTest* test = context;
+    uint32_t* message = furi_pool_queue_get(object, 0);
+    furi_check(message);
+    test->failed |= (*message != test->pool_messages++);
+    furi_pool_queue_release(object, message);
+    test_event_loop_check_done(test);
+}
+
+static void test_event_loop_stream_buffer_callback(void* object, void* context) {
+    EventLoopTest* test = context;
+    uint8_t data;
+    while(furi_stream_buffer_receive(object, &data, sizeof(data), 0) == sizeof(data)) {
+        test->failed |= (data != (uint8_t)test->bytes++);
+    }
+    test_event_loop_check_done(test);
+}
+
+static void test_event_loop_semaphore_callback(void* object, void* context) {
+    EventLoopTest* test = context;
+    furi_check(furi_semaphore_acquire(object, 0) == FuriStatusOk);
+    test->releases++;
+    test_event_loop_check_done(test);
+}
+
+static void test_event_loop_timer_callback(void* context) {
+    EventLoopTest* test = context;
+    if(++test->ticks == EVENT_LOOP_TEST_TIMER_TICKS) {
+        furi_event_loop_timer_stop(test->timer);
+    }
+    test_event_loop_check_done(test);
+}
+
+static int32_t test_event_loop_producer(void* context) {
+    EventLoopTest* test = context;
+
+    for(uint32_t i = 0; i < EVENT_LOOP_TEST_EVENTS; i++) {
+        uint8_t data = i;
+        furi_check(
+            furi_message_queue_put(test->message_queue, &i, FuriWaitForever) == FuriStatusOk);
+        uint32_t* message = furi_pool_queue_acquire(test->pool_queue, FuriWaitForever);
+        *message = i;
+        furi_pool_queue_put(test->pool_queue, message);
+        furi_check(furi_stream_buffer_send(test->stream_buffer, &data, 1, FuriWaitForever) == 1);
+        furi_check(furi_semaphore_release(test->semaphore) == FuriStatusOk);
+        furi_delay_tick(1);
+    }
+
+    return 0;
+}
+
+void test_furi_event_loop() {
+    EventLoopTest test = {0};
+
+    test.event_loop = furi_event_loop_alloc();
+    test.message_queue = furi_message_queue_alloc(4, sizeof(uint32_t));
+    test.pool_queue = furi_pool_queue_alloc(4, sizeof(uint32_t));
+    test.stream_buffer = furi_stream_buffer_alloc(EVENT_LOOP_TEST_EVENTS, 1);
+    test.semaphore = furi_semaphore_alloc(EVENT_LOOP_TEST_EVENTS, 0);
+
+    furi_event_loop_subscribe_message_queue(
+        test.event_loop, test.message_queue, test_event_loop_message_queue_callback, &test);
+    furi_event_loop_subscribe_pool_queue(
+        test.event_loop, test.pool_queue, test_event_loop_pool_queue_callback, &test);
+    furi_event_loop_subscribe_stream_buffer(
+        test.event_loop, test.stream_buffer, test_event_loop_stream_buffer_callback, &test);
+    furi_event_loop_subscribe_semaphore(
+        test.event_loop, test.semaphore, test_event_loop_semaphore_callback, &test);
+
+    test.timer = furi_event_loop_timer_alloc(
+        test.event_loop, test_event_loop_timer_callback, FuriTimerTypePeriodic, &test);
+    furi_event_loop_timer_start(test.timer, EVENT_LOOP_TEST_TIMER_INTERVAL);
+
+    FuriThread* producer =
+        furi_thread_alloc_ex("EventLoopTestProducer", 1024, test_event_loop_producer, &test);
+    furi_thread_start(producer);
+
+    // Runs until every event and timer tick is received
+    uint32_t start = furi_get_tick();
+    furi_event_loop_run(test.event_loop);
+    uint32_t duration = furi_get_tick() - start;
+
+    furi_thread_join(producer);
+    furi_thread_free(producer);
+
+    furi_event_loop_timer_free(test.timer);
+    furi_event_loop_unsubscribe(test.event_loop, test.semaphore);
+    furi_event_loop_unsubscribe(test.event_loop, test.stream_buffer);
+    furi_event_loop_unsubscribe(test.event_loop, test.pool_queue);
+    furi_event_loop_unsubscribe(test.event_loop, test.message_queue);
+
+    furi_semaphore_free(test.semaphore);
+    furi_stream_buffer_free(test.stream_buffer);
+    furi_pool_queue_free(test.pool_queue);
+    furi_message_queue_free(test.message_queue);
+    furi_event_loop_free(test.event_loop);
+
+    mu_assert(!test.failed, "events out of order");
+    mu_assert_int_eq(EVENT_LOOP_TEST_EVENTS, test.messages);
+    mu_assert_int_eq(EVENT_LOOP_TEST_EVENTS, test.pool_messages);
+    mu_assert_int_eq(EVENT_LOOP_TEST_EVENTS, test.bytes);
+    mu_assert_int_eq(EVENT_LOOP_TEST_EVENTS, test.releases);
+    mu_assert_int_eq(EVENT_LOOP_TEST_TIMER_TICKS, test.ticks);
+    mu_assert(
+        duration >= EVENT_LOOP_TEST_TIMER_INTERVAL * EVENT_LOOP_TEST_TIMER_TICKS,
+        "timer is too fast");
+}
@@ -0,0 +1,79 @@
+#include <furi.h>
+#include "../minunit.h"
+
+#define POOL_QUEUE_TEST_COUNT 4
+#define POOL_QUEUE_TEST_MESSAGES 64
+
+typedef struct {
+    uint32_t sequence;
+    uint8_t payload[250];
+} PoolQueueTestMessage;
+
+static int32_t test_pool_queue_producer(void* context) {
+    FuriPoolQueue* pool_queue = context;
+
+    for(uint32_t i = 0; i < POOL_QUEUE_TEST_MESSAGES; i++) {
+        PoolQueueTestMessage* message = furi_pool_queue_acquire(pool_queue, FuriWaitForever);
+        message->sequence = i;
+        memset(message->payload, i, sizeof(message->payload));
+        furi_pool_queue_put(pool_queue, message);
+    }
+
+    return 0;
+}
+
+void test_furi_pool_queue() {
+    FuriPoolQueue* pool_queue =
+        furi_pool_queue_alloc(POOL_QUEUE_TEST_COUNT, sizeof(PoolQueueTestMessage));
+    mu_assert_int_eq(sizeof(PoolQueueTestMessage), furi_pool_queue_get_message_size(pool_queue));
+
+    // Pool exhaustion
+    void* blocks[POOL_QUEUE_TEST_COUNT];
+    for(size_t i = 0; i < POOL_QUEUE_TEST_COUNT; i++) {
+        blocks[i] = furi_pool_queue_acquire(pool_queue, 0);
+        mu_assert_pointers_not_eq(blocks[i], NULL);
+        mu_assert_int_eq(0, (uint32_t)blocks[i] % 8);
+    }
+    mu_assert_pointers_eq(furi_pool_queue_acquire(pool_queue, 0), NULL);
+
+    FuriPoolQueueStats stats;
+    furi_pool_queue_get_stats(pool_queue, &stats);
+    mu_assert_int_eq(POOL_QUEUE_TEST_COUNT, stats.capacity);
+    mu_assert_int_eq(POOL_QUEUE_TEST_COUNT, stats.used);
+    mu_assert_int_eq(POOL_QUEUE_TEST_COUNT, stats.used_max);
+    mu_assert_int_eq(1, stats.acquire_failed);
+
+    // Ownership passes by pointer, nothing is copied
+    furi_pool_queue_put(pool_queue, blocks[0]);
+    mu_assert_pointers_eq(blocks[0], furi_pool_queue_get(pool_queue, 0));
+    mu_assert_pointers_eq(furi_pool_queue_get(pool_queue, 0), NULL);
+
+    for(size_t i = 0; i < POOL_QUEUE_TEST_COUNT; i++) {
+        furi_pool_queue_release(pool_queue, blocks[i]);
+    }
+    furi_pool_queue_get_stats(pool_queue, &stats);
+    mu_assert_int_eq(0, stats.used);
+
+    // Producer is throttled by the pool size
+    FuriThread* producer = furi_thread_alloc_ex(
+        "PoolQueueTestProducer", 1024, test_pool_queue_producer, pool_queue);
+    furi_thread_start(producer);
+
+    for(uint32_t i = 0; i < POOL_QUEUE_TEST_MESSAGES; i++) {
+        PoolQueueTestMessage* message = furi_pool_queue_get(pool_queue, 1000);
+        mu_assert_pointers_not_eq(message, NULL);
+        mu_assert_int_eq(i, message->sequence);
+        mu_assert_int_eq((uint8_t)i, message->payload[sizeof(message->payload) - 1]);
+        furi_pool_queue_release(pool_queue, message);
+    }
+
+    furi_thread_join(producer);
+    furi_thread_free(producer);
+
+    furi_pool_queue_get_stats(pool_queue, &stats);
+    mu_assert_int_eq(0, stats.used);
+    mu_assert_int_eq(0, stats.pending);
+    mu_assert_int_eq(POOL_QUEUE_TEST_COUNT, stats.used_max);
+
+    furi_pool_queue_free(pool_queue);
+}
@@ -9,6 +9,9 @@ void test_furi_concurrent_access();
 void test_furi_pubsub();
 
 void test_furi_memmgr();
+void test_furi_thread_stats();
+void test_furi_pool_queue();
+void test_furi_event_loop();
 
 static int foo = 0;
 
@@ -39,6 +42,18 @@ MU_TEST(mu_test_furi_memmgr) {
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_thread_stats) {
+    test_furi_thread_stats();
+}
+
+MU_TEST(mu_test_furi_pool_queue) {
+    test_furi_pool_queue();
+}
+
+MU_TEST(mu_test_furi_event_loop) {
+    test_furi_event_loop();
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -48,6 +63,9 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_thread_stats);
+    MU_RUN_TEST(mu_test_furi_pool_queue);
+    MU_RUN_TEST(mu_test_furi_event_loop);
 }
 
 int run_minunit_test_furi() {
@@ -0,0 +1,43 @@
+#include <furi.h>
+#include "../minunit.h"
+
+#define THREAD_STATS_TEST_WAKEUPS 10
+#define THREAD_STATS_TEST_FLAG (1UL << 0)
+
+static int32_t test_thread_stats_callback(void* context) {
+    FuriThreadStats* stats = context;
+
+    for(size_t i = 0; i < THREAD_STATS_TEST_WAKEUPS; i++) {
+        furi_thread_flags_wait(THREAD_STATS_TEST_FLAG, FuriFlagWaitAny, FuriWaitForever);
+    }
+
+    // Statistics are gone with the task, take them while alive
+    return furi_thread_get_stats(furi_thread_get_current_id(), stats);
+}
+
+void test_furi_thread_stats() {
+    FuriThreadStats stats;
+    FuriThread* thread =
+        furi_thread_alloc_ex("ThreadStatsTest", 1024, test_thread_stats_callback, &stats);
+    furi_thread_start(thread);
+
+    for(size_t i = 0; i < THREAD_STATS_TEST_WAKEUPS; i++) {
+        furi_delay_ms(2);
+        furi_thread_flags_set(furi_thread_get_id(thread), THREAD_STATS_TEST_FLAG);
+    }
+
+    furi_thread_join(thread);
+    mu_assert_int_eq(true, furi_thread_get_return_code(thread));
+    furi_thread_free(thread);
+
+    mu_assert(stats.run_time > 0, "no run time");
+    mu_assert(stats.wakeups >= THREAD_STATS_TEST_WAKEUPS, "wakeups are not counted");
+    mu_assert(stats.switches >= stats.wakeups, "less switches than wakeups");
+    mu_assert(stats.latency_total >= stats.latency_max, "latency total is too small");
+
+    uint32_t histogram_count = 0;
+    for(size_t i = 0; i < FURI_THREAD_LATENCY_HISTOGRAM_SIZE; i++) {
+        histogram_count += stats.latency_histogram[i];
+    }
+    mu_assert_int_eq(stats.wakeups, histogram_count);
+}
@@ -1,12 +1,16 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include <flipper_format.h>
 #include <infrared.h>
 #include <common/infrared_common_i.h>
 #include "../minunit.h"
 
+#define TAG "InfraredTest"
+
 #define IR_TEST_FILES_DIR EXT_PATH("unit_tests/infrared/")
 #define IR_TEST_FILE_PREFIX "test_"
 #define IR_TEST_FILE_SUFFIX ".irtest"
+#define IR_TEST_BENCHMARK_ROUNDS 100
 
 typedef struct {
     InfraredDecoderHandler* decoder_handler;
@@ -400,6 +404,65 @@ static void infrared_test_run_decoder(InfraredProtocol protocol, uint32_t test_i
     mu_assert(message_counter == messages_count, "decoded less than expected");
 }
 
+static void infrared_test_benchmark_decoder(InfraredProtocol protocol, uint32_t test_index) {
+    uint32_t* timings;
+    uint32_t timings_count;
+
+    FuriString* buf;
+    buf = furi_string_alloc();
+
+    mu_assert(
+        infrared_test_prepare_file(infrared_get_protocol_name(protocol)),
+        "Failed to prepare test file");
+
+    furi_string_printf(buf, "decoder_input%ld", test_index);
+    mu_assert(
+        infrared_test_load_raw_signal(
+            test->ff, furi_string_get_cstr(buf), &timings, &timings_count),
+        "Failed to load raw signal from file");
+
+    flipper_format_buffered_file_close(test->ff);
+    furi_string_free(buf);
+
+    uint32_t first_round_count = 0;
+    uint64_t cycles = 0;
+
+    for(uint32_t round = 0; round < IR_TEST_BENCHMARK_ROUNDS; ++round) {
+        uint32_t message_count = 0;
+        bool level = false;
+
+        infrared_reset_decoder(test->decoder_handler);
+        uint32_t start = DWT->CYCCNT;
+        for(uint32_t i = 0; i < timings_count; ++i) {
+            if(timings[i] > INFRARED_RAW_RX_TIMING_DELAY_US) {
+                message_count += !!infrared_check_decoder_ready(test->decoder_handler);
+            }
+            message_count += !!infrared_decode(test->decoder_handler, level, timings[i]);
+            level = !level;
+        }
+        message_count += !!infrared_check_decoder_ready(test->decoder_handler);
+        cycles += DWT->CYCCNT - start;
+
+        if(round == 0) {
+            first_round_count = message_count;
+        } else {
+            mu_assert(message_count == first_round_count, "decoding is not repeatable");
+        }
+    }
+
+    const uint32_t edges = timings_count * IR_TEST_BENCHMARK_ROUNDS;
+    const uint32_t us = cycles / furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu edges in %luus, %lu edges/s",
+        infrared_get_protocol_name(protocol),
+        edges,
+        us,
+        us ? (uint32_t)((uint64_t)edges * 1000000 / us) : 0);
+
+    free(timings);
+}
+
 MU_TEST(infrared_test_decoder_samsung32) {
     infrared_test_run_decoder(InfraredProtocolSamsung32, 1);
 }
@@ -522,6 +585,16 @@ MU_TEST(infrared_test_encoder_decoder_all) {
     infrared_test_run_encoder_decoder(InfraredProtocolRCA, 1);
 }
 
+MU_TEST(infrared_test_decoder_benchmark) {
+    infrared_test_benchmark_decoder(InfraredProtocolNEC, 3);
+    infrared_test_benchmark_decoder(InfraredProtocolSamsung32, 1);
+    infrared_test_benchmark_decoder(InfraredProtocolRC5, 1);
+    infrared_test_benchmark_decoder(InfraredProtocolRC6, 1);
+    infrared_test_benchmark_decoder(InfraredProtocolSIRC, 5);
+    infrared_test_benchmark_decoder(InfraredProtocolKaseikyo, 1);
+    infrared_test_benchmark_decoder(InfraredProtocolRCA, 1);
+}
+
 MU_TEST_SUITE(infrared_test) {
     MU_SUITE_CONFIGURE(&infrared_test_alloc, &infrared_test_free);
 
@@ -541,6 +614,7 @@ MU_TEST_SUITE(infrared_test) {
     MU_RUN_TEST(infrared_test_decoder_rca);
     MU_RUN_TEST(infrared_test_decoder_mixed);
     MU_RUN_TEST(infrared_test_encoder_decoder_all);
+    MU_RUN_TEST(infrared_test_decoder_benchmark);
 }
 
 int run_minunit_test_infrared() {
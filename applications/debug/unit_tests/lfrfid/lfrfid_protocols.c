@@ -320,6 +320,52 @@ MU_TEST(test_lfrfid_protocol_h10301_read_simple) {
     protocol_dict_free(dict);
 }
 
+MU_TEST(test_lfrfid_protocol_h10301_read_batch) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    const uint8_t data[HID10301_TEST_DATA_SIZE] = HID10301_TEST_DATA;
+    const size_t durations_max = HID10301_TEST_EMULATION_TIMINGS_COUNT * 10;
+    uint32_t* durations = malloc(durations_max * sizeof(uint32_t));
+    size_t durations_count = 0;
+
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+    for(size_t i = 0; i < durations_max; i++) {
+        bool pulse_pop = pulse_glue_push(
+            pulse_glue,
+            hid10301_test_timings[i % HID10301_TEST_EMULATION_TIMINGS_COUNT] >= 0,
+            abs(hid10301_test_timings[i % HID10301_TEST_EMULATION_TIMINGS_COUNT]) *
+                LF_RFID_READ_TIMING_MULTIPLIER);
+
+        if(pulse_pop) {
+            uint32_t length, period;
+            pulse_glue_pop(pulse_glue, &length, &period);
+            durations[durations_count++] = period;
+            durations[durations_count++] = length - period;
+        }
+    }
+    pulse_glue_free(pulse_glue);
+
+    protocol_dict_decoders_start(dict);
+    size_t consumed = 0;
+    ProtocolId protocol = protocol_dict_decoders_feed_batch_by_feature(
+        dict, LFRFIDFeatureASK, true, durations, durations_count, &consumed);
+
+    mu_assert_int_eq(LFRFIDProtocolH10301, protocol);
+    mu_check(consumed > 0 && consumed < durations_count);
+    uint8_t received_data[HID10301_TEST_DATA_SIZE] = {0};
+    protocol_dict_get_data(dict, protocol, received_data, HID10301_TEST_DATA_SIZE);
+    mu_assert_mem_eq(data, received_data, HID10301_TEST_DATA_SIZE);
+
+    // No decoder is fed without matching feature
+    protocol_dict_decoders_start(dict);
+    protocol = protocol_dict_decoders_feed_batch_by_feature(
+        dict, 0, true, durations, durations_count, &consumed);
+    mu_assert_int_eq(PROTOCOL_NO, protocol);
+    mu_assert_int_eq(durations_count, consumed);
+
+    free(durations);
+    protocol_dict_free(dict);
+}
+
 MU_TEST(test_lfrfid_protocol_h10301_emulate_simple) {
     ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
     mu_assert_int_eq(
@@ -450,6 +496,7 @@ MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_em_emulate_simple);
 
     MU_RUN_TEST(test_lfrfid_protocol_h10301_read_simple);
+    MU_RUN_TEST(test_lfrfid_protocol_h10301_read_batch);
     MU_RUN_TEST(test_lfrfid_protocol_h10301_emulate_simple);
 
     MU_RUN_TEST(test_lfrfid_protocol_ioprox_xsf_read_simple);
@@ -5,6 +5,7 @@
 #include <lib/flipper_format/flipper_format.h>
 #include <lib/nfc/protocols/nfca.h>
 #include <lib/nfc/helpers/mf_classic_dict.h>
+#include <lib/nfc/helpers/mf_classic_key_stats.h>
 #include <lib/digital_signal/digital_signal.h>
 #include <lib/pulse_reader/pulse_reader.h>
 #include <lib/nfc/nfc_device.h>
@@ -21,6 +22,7 @@
 #define NFC_TEST_SIGNAL_SHORT_FILE "nfc_nfca_signal_short.nfc"
 #define NFC_TEST_SIGNAL_LONG_FILE "nfc_nfca_signal_long.nfc"
 #define NFC_TEST_DICT_PATH EXT_PATH("unit_tests/mf_classic_dict.nfc")
+#define NFC_TEST_KEY_STATS_PATH EXT_PATH("unit_tests/mf_classic_key_stats.txt")
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_dev_test.nfc")
 
 static const char* nfc_test_file_type = "Flipper NFC test";
@@ -485,6 +487,68 @@ MU_TEST(mf_classic_dict_load_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+MU_TEST(mf_classic_key_stats_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage != NULL, "storage != NULL assert failed\r\n");
+
+    if(storage_file_exists(storage, NFC_TEST_KEY_STATS_PATH)) {
+        mu_assert(
+            storage_simply_remove(storage, NFC_TEST_KEY_STATS_PATH),
+            "remove == true assert failed\r\n");
+    }
+
+    const uint32_t card_class = 0x00040800;
+    const uint32_t other_class = 0x00440800;
+    const uint64_t key_common = 0xffffffffffff;
+    const uint64_t key_class = 0xa0a1a2a3a4a5;
+    const uint64_t key_other = 0xd3f7d3f7d3f7;
+
+    MfClassicKeyStats* instance = mf_classic_key_stats_alloc(storage, NFC_TEST_KEY_STATS_PATH);
+    mu_assert(instance != NULL, "mf_classic_key_stats_alloc\r\n");
+    mu_assert(
+        mf_classic_key_stats_rank(instance, card_class) == 0,
+        "empty stats rank == 0 assert failed\r\n");
+
+    // 3 hits on other cards, 1 hit of same class weighs 4
+    for(size_t i = 0; i < 3; i++) {
+        mf_classic_key_stats_add_hit(instance, key_other, other_class);
+    }
+    mf_classic_key_stats_add_hit(instance, key_class, card_class);
+    mf_classic_key_stats_add_hit(instance, key_common, card_class);
+    mf_classic_key_stats_add_hit(instance, key_common, other_class);
+    mu_assert(mf_classic_key_stats_save(instance), "mf_classic_key_stats_save\r\n");
+    mf_classic_key_stats_free(instance);
+
+    // Reload and check ranking
+    instance = mf_classic_key_stats_alloc(storage, NFC_TEST_KEY_STATS_PATH);
+    mu_assert(
+        mf_classic_key_stats_rank(instance, card_class) == 3,
+        "loaded stats rank == 3 assert failed\r\n");
+
+    uint64_t key = 0;
+    mu_assert(mf_classic_key_stats_get_next_key(instance, &key), "get_next_key 1\r\n");
+    mu_assert(key == key_common, "key_common expected first\r\n");
+    mu_assert(mf_classic_key_stats_get_next_key(instance, &key), "get_next_key 2\r\n");
+    mu_assert(key == key_class, "key_class expected second\r\n");
+    mu_assert(mf_classic_key_stats_get_next_key(instance, &key), "get_next_key 3\r\n");
+    mu_assert(key == key_other, "key_other expected third\r\n");
+    mu_assert(!mf_classic_key_stats_get_next_key(instance, &key), "get_next_key end\r\n");
+
+    mu_assert(mf_classic_key_stats_is_ranked(instance, key_class), "is_ranked key_class\r\n");
+    mu_assert(!mf_classic_key_stats_is_ranked(instance, 0x123456789abc), "is_ranked unknown\r\n");
+
+    // For the other class its own key goes first
+    mf_classic_key_stats_rank(instance, other_class);
+    mu_assert(mf_classic_key_stats_get_next_key(instance, &key), "get_next_key other\r\n");
+    mu_assert(key == key_other, "key_other expected first for other class\r\n");
+    mf_classic_key_stats_free(instance);
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_TEST_KEY_STATS_PATH),
+        "remove == true assert failed\r\n");
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST(nfca_file_test) {
     NfcDevice* nfc = nfc_device_alloc();
     mu_assert(nfc != NULL, "nfc_device_data != NULL assert failed\r\n");
@@ -715,6 +779,7 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(nfc_digital_signal_test);
     MU_RUN_TEST(mf_classic_dict_test);
     MU_RUN_TEST(mf_classic_dict_load_test);
+    MU_RUN_TEST(mf_classic_key_stats_test);
 
     nfc_test_free();
 }
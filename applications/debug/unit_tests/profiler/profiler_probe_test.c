@@ -0,0 +1,86 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <toolbox/profiler_probe.h>
+
+#include "../minunit.h"
+
+#define PROFILER_PROBE_TEST_DELAY_US 100
+
+PROFILER_PROBE_DEFINE(unit_test_probe);
+
+static void profiler_probe_test_recurse(uint32_t depth) {
+    PROFILER_PROBE_SCOPE(unit_test_probe);
+
+    if(depth) {
+        profiler_probe_test_recurse(depth - 1);
+    } else {
+        furi_delay_us(PROFILER_PROBE_TEST_DELAY_US);
+    }
+}
+
+MU_TEST(profiler_probe_registry_test) {
+    ProfilerProbe* probe = PROFILER_PROBE(unit_test_probe);
+    mu_assert(profiler_probe_find("unit_test_probe") == probe, "probe not found by name");
+    mu_assert(profiler_probe_find("no_such_probe") == NULL, "unknown probe found");
+
+    bool listed = false;
+    for(size_t i = 0; i < profiler_probe_get_count(); i++) {
+        listed |= (profiler_probe_get(i) == probe);
+    }
+    mu_assert(listed, "probe not listed");
+}
+
+MU_TEST(profiler_probe_nesting_test) {
+    ProfilerProbe* probe = PROFILER_PROBE(unit_test_probe);
+    profiler_probe_reset(probe);
+
+    profiler_probe_test_recurse(3);
+
+    mu_assert_int_eq(1, probe->count);
+    mu_assert_int_eq(0, probe->depth);
+    mu_assert_int_eq(probe->min, probe->max);
+    mu_assert(
+        probe->min >=
+            PROFILER_PROBE_TEST_DELAY_US * furi_hal_cortex_instructions_per_microsecond(),
+        "measured less than the delay");
+}
+
+MU_TEST(profiler_probe_stats_test) {
+    ProfilerProbe* probe = PROFILER_PROBE(unit_test_probe);
+    profiler_probe_reset(probe);
+
+    // Unbalanced stop must be ignored
+    profiler_probe_stop(probe);
+    mu_assert_int_eq(0, probe->count);
+
+    for(size_t i = 1; i <= 10; i++) {
+        profiler_probe_start(probe);
+        furi_delay_us(i * 10);
+        profiler_probe_stop(probe);
+    }
+
+    mu_assert_int_eq(10, probe->count);
+    mu_assert(probe->min < probe->max, "min is not less than max");
+    mu_assert(probe->total >= (uint64_t)probe->max + probe->min, "total is too small");
+
+    uint32_t histogram_count = 0;
+    for(size_t i = 0; i < PROFILER_PROBE_HISTOGRAM_SIZE; i++) {
+        histogram_count += probe->histogram[i];
+    }
+    mu_assert_int_eq(10, histogram_count);
+
+    profiler_probe_reset(probe);
+    mu_assert_int_eq(0, probe->count);
+    mu_assert_int_eq(UINT32_MAX, probe->min);
+}
+
+MU_TEST_SUITE(profiler_probe_suite) {
+    MU_RUN_TEST(profiler_probe_registry_test);
+    MU_RUN_TEST(profiler_probe_nesting_test);
+    MU_RUN_TEST(profiler_probe_stats_test);
+}
+
+int run_minunit_test_profiler_probe() {
+    MU_RUN_SUITE(profiler_probe_suite);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,102 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <lib/pulse_reader/pulse_capture.h>
+#include <stm32wbxx_ll_gpio.h>
+
+#include "../minunit.h"
+
+#define PULSE_CAPTURE_TEST_SIZE 8
+#define PULSE_CAPTURE_TEST_EDGE_DELAY_US 10
+#define PULSE_CAPTURE_TEST_TIMEOUT_US 1000
+
+static const GpioPin* const pulse_capture_test_gpios[] = {&gpio_ext_pc0, &gpio_ext_pc1};
+
+/* Capture keeps EXTI lines set up, edges come from driving the pins ourselves */
+static void pulse_capture_test_drive() {
+    for(size_t i = 0; i < COUNT_OF(pulse_capture_test_gpios); i++) {
+        const GpioPin* gpio = pulse_capture_test_gpios[i];
+        furi_hal_gpio_write(gpio, false);
+        LL_GPIO_SetPinOutputType(gpio->port, gpio->pin, LL_GPIO_OUTPUT_PUSHPULL);
+        LL_GPIO_SetPinMode(gpio->port, gpio->pin, LL_GPIO_MODE_OUTPUT);
+    }
+}
+
+static void pulse_capture_test_edge(const GpioPin* gpio, bool level) {
+    furi_hal_gpio_write(gpio, level);
+    furi_delay_us(PULSE_CAPTURE_TEST_EDGE_DELAY_US);
+}
+
+MU_TEST(pulse_capture_merge_test) {
+    PulseCapture* capture = pulse_capture_alloc(
+        pulse_capture_test_gpios, COUNT_OF(pulse_capture_test_gpios), PULSE_CAPTURE_TEST_SIZE);
+    pulse_capture_set_pull(capture, GpioPullDown);
+    pulse_capture_start(capture);
+    pulse_capture_test_drive();
+
+    pulse_capture_test_edge(&gpio_ext_pc0, true);
+    pulse_capture_test_edge(&gpio_ext_pc1, true);
+    pulse_capture_test_edge(&gpio_ext_pc0, false);
+    pulse_capture_test_edge(&gpio_ext_pc1, false);
+
+    PulseCaptureEdge edges[PULSE_CAPTURE_TEST_SIZE];
+    size_t count =
+        pulse_capture_read(capture, edges, COUNT_OF(edges), PULSE_CAPTURE_TEST_TIMEOUT_US);
+    PulseCaptureStats stats;
+    pulse_capture_get_stats(capture, &stats);
+    pulse_capture_stop(capture);
+    pulse_capture_free(capture);
+
+    mu_assert_int_eq(4, count);
+    const uint8_t channels[] = {0, 1, 0, 1};
+    const bool levels[] = {true, true, false, false};
+    for(size_t i = 0; i < count; i++) {
+        mu_assert_int_eq(channels[i], edges[i].channel);
+        mu_assert_int_eq(levels[i], edges[i].level);
+        if(i) {
+            mu_assert(
+                (int32_t)(edges[i].timestamp - edges[i - 1].timestamp) > 0,
+                "edges are not ordered by time");
+        }
+    }
+    mu_assert_int_eq(4, stats.edges);
+    mu_assert_int_eq(0, stats.lost_edges);
+    mu_assert_int_eq(0, stats.overruns);
+}
+
+MU_TEST(pulse_capture_overrun_test) {
+    PulseCapture* capture =
+        pulse_capture_alloc(pulse_capture_test_gpios, 1, PULSE_CAPTURE_TEST_SIZE);
+    pulse_capture_set_pull(capture, GpioPullDown);
+    pulse_capture_start(capture);
+    pulse_capture_test_drive();
+
+    // Lap the ring a couple of times before reading
+    const size_t toggles = PULSE_CAPTURE_TEST_SIZE * 2 + 4;
+    for(size_t i = 0; i < toggles; i++) {
+        pulse_capture_test_edge(&gpio_ext_pc0, !(i % 2));
+    }
+
+    PulseCaptureEdge edges[PULSE_CAPTURE_TEST_SIZE * 2];
+    size_t count =
+        pulse_capture_read(capture, edges, COUNT_OF(edges), PULSE_CAPTURE_TEST_TIMEOUT_US);
+    PulseCaptureStats stats;
+    pulse_capture_get_stats(capture, &stats);
+    pulse_capture_stop(capture);
+    pulse_capture_free(capture);
+
+    // Only newest half of the ring is kept, levels still alternate
+    mu_assert_int_eq(PULSE_CAPTURE_TEST_SIZE / 2, count);
+    mu_assert_int_eq(1, stats.overruns);
+    mu_assert_int_eq(0, stats.lost_edges);
+    mu_assert_int_eq(false, edges[count - 1].level);
+}
+
+MU_TEST_SUITE(pulse_capture_suite) {
+    MU_RUN_TEST(pulse_capture_merge_test);
+    MU_RUN_TEST(pulse_capture_overrun_test);
+}
+
+int run_minunit_test_pulse_capture() {
+    MU_RUN_SUITE(pulse_capture_suite);
+    return MU_EXIT_CODE;
+}
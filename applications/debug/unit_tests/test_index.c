@@ -27,6 +27,8 @@ int run_minunit_test_lfrfid_protocols();
 int run_minunit_test_nfc();
 int run_minunit_test_bit_lib();
 int run_minunit_test_float_tools();
+int run_minunit_test_profiler_probe();
+int run_minunit_test_pulse_capture();
 int run_minunit_test_bt();
 int run_minunit_test_dialogs_file_browser_options();
 
@@ -57,6 +59,8 @@ const UnitTest unit_tests[] = {
     {.name = "lfrfid", .entry = run_minunit_test_lfrfid_protocols},
     {.name = "bit_lib", .entry = run_minunit_test_bit_lib},
     {.name = "float_tools", .entry = run_minunit_test_float_tools},
+    {.name = "profiler_probe", .entry = run_minunit_test_profiler_probe},
+    {.name = "pulse_capture", .entry = run_minunit_test_pulse_capture},
     {.name = "bt", .entry = run_minunit_test_bt},
     {.name = "dialogs_file_browser_options",
      .entry = run_minunit_test_dialogs_file_browser_options},
@@ -122,8 +122,7 @@ BadUsbApp* bad_usb_app_alloc(char* arg) {
         furi_check(furi_hal_usb_set_config(NULL, NULL));
 
         if(!furi_string_empty(app->file_path)) {
-            app->bad_usb_script = bad_usb_script_open(app->file_path);
-            bad_usb_script_set_keyboard_layout(app->bad_usb_script, app->keyboard_layout);
+            app->bad_usb_script = bad_usb_script_open(app->file_path, app->keyboard_layout);
             scene_manager_next_scene(app->scene_manager, BadUsbSceneWork);
         } else {
             furi_string_set(app->file_path, BAD_USB_APP_BASE_FOLDER);
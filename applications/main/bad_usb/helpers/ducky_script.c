@@ -12,9 +12,6 @@
 #define TAG "BadUsb"
 #define WORKER_TAG TAG "Worker"
 
-#define BADUSB_ASCII_TO_KEY(script, x) \
-    (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
-
 typedef enum {
     WorkerEvtStartStop = (1 << 0),
     WorkerEvtPauseResume = (1 << 1),
@@ -23,21 +20,6 @@ typedef enum {
     WorkerEvtDisconnect = (1 << 4),
 } WorkerEvtFlags;
 
-static const char ducky_cmd_id[] = {"ID"};
-
-static const uint8_t numpad_keys[10] = {
-    HID_KEYPAD_0,
-    HID_KEYPAD_1,
-    HID_KEYPAD_2,
-    HID_KEYPAD_3,
-    HID_KEYPAD_4,
-    HID_KEYPAD_5,
-    HID_KEYPAD_6,
-    HID_KEYPAD_7,
-    HID_KEYPAD_8,
-    HID_KEYPAD_9,
-};
-
 uint32_t ducky_get_command_len(const char* line) {
     uint32_t len = strlen(line);
     for(uint32_t i = 0; i < len; i++) {
@@ -77,51 +59,6 @@ void ducky_numlock_on() {
         furi_hal_hid_kb_release(HID_KEYBOARD_LOCK_NUM_LOCK);
     }
 }
-bool ducky_numpad_press(const char num) {
-    if((num < '0') || (num > '9')) return false;
-
-    uint16_t key = numpad_keys[num - '0'];
-    furi_hal_hid_kb_press(key);
-    furi_hal_hid_kb_release(key);
-
-    return true;
-}
-
-bool ducky_altchar(const char* charcode) {
-    uint8_t i = 0;
-    bool state = false;
-
-    furi_hal_hid_kb_press(KEY_MOD_LEFT_ALT);
-
-    while(!ducky_is_line_end(charcode[i])) {
-        state = ducky_numpad_press(charcode[i]);
-        if(state == false) break;
-        i++;
-    }
-
-    furi_hal_hid_kb_release(KEY_MOD_LEFT_ALT);
-    return state;
-}
-
-bool ducky_altstring(const char* param) {
-    uint32_t i = 0;
-    bool state = false;
-
-    while(param[i] != '\0') {
-        if((param[i] < ' ') || (param[i] > '~')) {
-            i++;
-            continue; // Skip non-printable chars
-        }
-
-        char temp_str[4];
-        snprintf(temp_str, 4, "%u", param[i]);
-
-        state = ducky_altchar(temp_str);
-        if(state == false) break;
-        i++;
-    }
-    return state;
-}
 
 int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...) {
     va_list args;
@@ -133,220 +70,230 @@ int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...) {
     return SCRIPT_STATE_ERROR;
 }
 
-bool ducky_string(BadUsbScript* bad_usb, const char* param) {
-    uint32_t i = 0;
-
-    while(param[i] != '\0') {
-        if(param[i] != '\n') {
-            uint16_t keycode = BADUSB_ASCII_TO_KEY(bad_usb, param[i]);
-            if(keycode != HID_KEYBOARD_NONE) {
-                furi_hal_hid_kb_press(keycode);
-                furi_hal_hid_kb_release(keycode);
-            }
-        } else {
-            furi_hal_hid_kb_press(HID_KEYBOARD_RETURN);
-            furi_hal_hid_kb_release(HID_KEYBOARD_RETURN);
-        }
-        i++;
-    }
-    bad_usb->stringdelay = 0;
-    return true;
-}
-
 static bool ducky_string_next(BadUsbScript* bad_usb) {
-    if(bad_usb->string_print_pos >= furi_string_size(bad_usb->string_print)) {
+    if(bad_usb->string_print_pos >= bad_usb->string_len) {
         return true;
     }
 
-    char print_char = furi_string_get_char(bad_usb->string_print, bad_usb->string_print_pos);
-
-    if(print_char != '\n') {
-        uint16_t keycode = BADUSB_ASCII_TO_KEY(bad_usb, print_char);
-        if(keycode != HID_KEYBOARD_NONE) {
-            furi_hal_hid_kb_press(keycode);
-            furi_hal_hid_kb_release(keycode);
-        }
-    } else {
-        furi_hal_hid_kb_press(HID_KEYBOARD_RETURN);
-        furi_hal_hid_kb_release(HID_KEYBOARD_RETURN);
-    }
+    uint16_t keycode = bad_usb->string_keys[bad_usb->string_print_pos];
+    furi_hal_hid_kb_press(keycode);
+    furi_hal_hid_kb_release(keycode);
 
     bad_usb->string_print_pos++;
 
     return false;
 }
 
-static int32_t ducky_parse_line(BadUsbScript* bad_usb, FuriString* line) {
-    uint32_t line_len = furi_string_size(line);
-    const char* line_tmp = furi_string_get_cstr(line);
-
-    if(line_len == 0) {
-        return SCRIPT_STATE_NEXT_LINE; // Skip empty lines
+static void ducky_string(BadUsbScript* bad_usb) {
+    size_t typed = furi_hal_hid_kb_type(
+        bad_usb->string_keys, bad_usb->string_len, bad_usb->string_mode, bad_usb->string_interval);
+    if((typed < bad_usb->string_len) && (bad_usb->string_mode != HidKbTypeModeNormal) &&
+       furi_hal_hid_is_connected()) {
+        // Host did not keep up, type the rest with a report per key press and release
+        typed += furi_hal_hid_kb_type(
+            &bad_usb->string_keys[typed],
+            bad_usb->string_len - typed,
+            HidKbTypeModeNormal,
+            bad_usb->string_interval);
     }
-    FURI_LOG_D(WORKER_TAG, "line:%s", line_tmp);
-
-    // Ducky Lang Functions
-    int32_t cmd_result = ducky_execute_cmd(bad_usb, line_tmp);
-    if(cmd_result != SCRIPT_STATE_CMD_UNKNOWN) {
-        return cmd_result;
+    if(typed < bad_usb->string_len) {
+        FURI_LOG_W(WORKER_TAG, "Typed %zu of %zu keys", typed, bad_usb->string_len);
     }
+}
 
-    // Special keys + modifiers
-    uint16_t key = ducky_get_keycode(bad_usb, line_tmp, false);
-    if(key == HID_KEYBOARD_NONE) {
-        return ducky_error(bad_usb, "No keycode defined for %s", line_tmp);
-    }
-    if((key & 0xFF00) != 0) {
-        // It's a modifier key
-        uint32_t offset = ducky_get_command_len(line_tmp) + 1;
-        // ducky_get_command_len() returns 0 without space, so check for != 1
-        if(offset != 1 && line_len > offset) {
-            // It's also a key combination
-            key |= ducky_get_keycode(bad_usb, line_tmp + offset, true);
-        }
+static bool ducky_read_keys(BadUsbScript* bad_usb, Stream* bytecode, size_t count) {
+    if(count > bad_usb->string_keys_max) {
+        free(bad_usb->string_keys);
+        bad_usb->string_keys = malloc(count * sizeof(uint16_t));
+        bad_usb->string_keys_max = count;
     }
-    furi_hal_hid_kb_press(key);
-    furi_hal_hid_kb_release(key);
-    return 0;
+    bad_usb->string_len = count;
+    bad_usb->string_print_pos = 0;
+
+    size_t size = count * sizeof(uint16_t);
+    return (size == 0) || (stream_read(bytecode, (uint8_t*)bad_usb->string_keys, size) == size);
 }
 
-static bool ducky_set_usb_id(BadUsbScript* bad_usb, const char* line) {
-    if(sscanf(line, "%lX:%lX", &bad_usb->hid_cfg.vid, &bad_usb->hid_cfg.pid) == 2) {
-        bad_usb->hid_cfg.manuf[0] = '\0';
-        bad_usb->hid_cfg.product[0] = '\0';
-
-        uint8_t id_len = ducky_get_command_len(line);
-        if(!ducky_is_line_end(line[id_len + 1])) {
-            sscanf(
-                &line[id_len + 1],
-                "%31[^\r\n:]:%31[^\r\n]",
-                bad_usb->hid_cfg.manuf,
-                bad_usb->hid_cfg.product);
+static void ducky_altcodes(BadUsbScript* bad_usb) {
+    ducky_numlock_on();
+    furi_hal_hid_kb_press(KEY_MOD_LEFT_ALT);
+    for(size_t i = 0; i < bad_usb->string_len; i++) {
+        uint16_t key = bad_usb->string_keys[i];
+        if(key == HID_KEYBOARD_NONE) { // Next char
+            furi_hal_hid_kb_release(KEY_MOD_LEFT_ALT);
+            furi_hal_hid_kb_press(KEY_MOD_LEFT_ALT);
+        } else {
+            furi_hal_hid_kb_press(key);
+            furi_hal_hid_kb_release(key);
         }
-        FURI_LOG_D(
-            WORKER_TAG,
-            "set id: %04lX:%04lX mfr:%s product:%s",
-            bad_usb->hid_cfg.vid,
-            bad_usb->hid_cfg.pid,
-            bad_usb->hid_cfg.manuf,
-            bad_usb->hid_cfg.product);
-        return true;
     }
-    return false;
+    furi_hal_hid_kb_release(KEY_MOD_LEFT_ALT);
 }
 
-static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
-    uint8_t ret = 0;
-    uint32_t line_len = 0;
-
-    furi_string_reset(bad_usb->line);
-
-    do {
-        ret = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
-        for(uint16_t i = 0; i < ret; i++) {
-            if(bad_usb->file_buf[i] == '\n' && line_len > 0) {
-                bad_usb->st.line_nb++;
-                line_len = 0;
-            } else {
-                if(bad_usb->st.line_nb == 0) { // Save first line
-                    furi_string_push_back(bad_usb->line, bad_usb->file_buf[i]);
-                }
-                line_len++;
-            }
+static int32_t
+    ducky_execute(BadUsbScript* bad_usb, Stream* bytecode, const DuckyInstruction* instruction) {
+    uint16_t key = instruction->arg;
+
+    switch(instruction->op) {
+    case DuckyOpSkip:
+        return SCRIPT_STATE_NEXT_LINE;
+    case DuckyOpNone:
+        return 0;
+    case DuckyOpKey:
+        furi_hal_hid_kb_press(key);
+        furi_hal_hid_kb_release(key);
+        return 0;
+    case DuckyOpHold:
+        bad_usb->key_hold_nb++;
+        if(bad_usb->key_hold_nb > (HID_KB_MAX_KEYS - 1)) {
+            return ducky_error(bad_usb, "Too many keys are hold");
         }
-        if(storage_file_eof(script_file)) {
-            if(line_len > 0) {
-                bad_usb->st.line_nb++;
-                break;
-            }
+        furi_hal_hid_kb_press(key);
+        return 0;
+    case DuckyOpRelease:
+        if(bad_usb->key_hold_nb == 0) {
+            return ducky_error(bad_usb, "No keys are hold");
+        }
+        bad_usb->key_hold_nb--;
+        furi_hal_hid_kb_release(key);
+        return 0;
+    case DuckyOpSysrq:
+        furi_hal_hid_kb_press(KEY_MOD_LEFT_ALT | HID_KEYBOARD_PRINT_SCREEN);
+        furi_hal_hid_kb_press(key);
+        furi_hal_hid_kb_release_all();
+        return 0;
+    case DuckyOpDelay:
+        return instruction->arg;
+    case DuckyOpDefaultDelay:
+        bad_usb->defdelay = instruction->arg;
+        return 0;
+    case DuckyOpStringDelay:
+        bad_usb->stringdelay = instruction->arg;
+        return 0;
+    case DuckyOpString:
+        if(!ducky_read_keys(bad_usb, bytecode, instruction->arg)) break;
+        if(bad_usb->stringdelay == 0) { // stringdelay not set - run command immediately
+            ducky_string(bad_usb);
+            return 0;
+        }
+        // stringdelay is set - run command in thread to keep handling external events
+        return SCRIPT_STATE_STRING_START;
+    case DuckyOpAltCodes:
+        if(!ducky_read_keys(bad_usb, bytecode, instruction->arg)) break;
+        ducky_altcodes(bad_usb);
+        return 0;
+    case DuckyOpRepeat:
+        bad_usb->repeat_cnt = instruction->arg;
+        return 0;
+    case DuckyOpWaitForButton:
+        return SCRIPT_STATE_WAIT_FOR_BTN;
+    case DuckyOpTurbo:
+        if(instruction->arg == DUCKY_TURBO_OFF) {
+            bad_usb->string_mode = HidKbTypeModeNormal;
+            bad_usb->string_interval = 0;
+        } else if(instruction->arg == DUCKY_TURBO_COLLAPSE) {
+            bad_usb->string_mode = HidKbTypeModeCollapse;
+            bad_usb->string_interval = 0;
+        } else {
+            bad_usb->string_mode = HidKbTypeModePacked;
+            bad_usb->string_interval = instruction->arg;
         }
-    } while(ret > 0);
+        return 0;
+    case DuckyOpError: {
+        size_t len = MIN(instruction->arg, sizeof(bad_usb->st.error) - 1);
+        if(stream_read(bytecode, (uint8_t*)bad_usb->st.error, len) != len) break;
+        // Skip the rest of a longer message, so the next instruction is read from its start
+        if(!stream_seek(bytecode, instruction->arg - len, StreamOffsetFromCurrent)) break;
+        bad_usb->st.error[len] = '\0';
+        return SCRIPT_STATE_ERROR;
+    }
+    default:
+        break;
+    }
+
+    return ducky_error(bad_usb, "Script cache is damaged");
+}
+
+static int32_t ducky_script_repeat(BadUsbScript* bad_usb, Stream* bytecode) {
+    DuckyInstruction instruction;
+    uint32_t pos = stream_tell(bytecode);
+    int32_t delay_val = 0;
 
-    const char* line_tmp = furi_string_get_cstr(bad_usb->line);
-    bool id_set = false; // Looking for ID command at first line
-    if(strncmp(line_tmp, ducky_cmd_id, strlen(ducky_cmd_id)) == 0) {
-        id_set = ducky_set_usb_id(bad_usb, &line_tmp[strlen(ducky_cmd_id) + 1]);
+    if(bad_usb->repeat_pos == 0) {
+        return SCRIPT_STATE_NEXT_LINE; // Nothing to repeat
     }
 
-    if(id_set) {
-        furi_check(furi_hal_usb_set_config(&usb_hid, &bad_usb->hid_cfg));
+    if(!stream_seek(bytecode, bad_usb->repeat_pos, StreamOffsetFromStart) ||
+       stream_read(bytecode, (uint8_t*)&instruction, sizeof(instruction)) != sizeof(instruction)) {
+        delay_val = ducky_error(bad_usb, "Script cache is damaged");
     } else {
-        furi_check(furi_hal_usb_set_config(&usb_hid, NULL));
+        delay_val = ducky_execute(bad_usb, bytecode, &instruction);
     }
 
-    storage_file_seek(script_file, 0, true);
-    furi_string_reset(bad_usb->line);
-
-    return true;
+    if(!stream_seek(bytecode, pos, StreamOffsetFromStart)) {
+        delay_val = ducky_error(bad_usb, "Script cache is damaged");
+    }
+    return delay_val;
 }
 
-static int32_t ducky_script_execute_next(BadUsbScript* bad_usb, File* script_file) {
+static int32_t ducky_script_execute_next(BadUsbScript* bad_usb, Stream* bytecode) {
     int32_t delay_val = 0;
+    size_t line_cur = 0;
 
     if(bad_usb->repeat_cnt > 0) {
         bad_usb->repeat_cnt--;
-        delay_val = ducky_parse_line(bad_usb, bad_usb->line_prev);
-        if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-            return 0;
-        } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
-            return delay_val;
-        } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
-            return delay_val;
-        } else if(delay_val < 0) { // Script error
-            bad_usb->st.error_line = bad_usb->st.line_cur - 1;
-            FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_usb->st.line_cur - 1U);
+        line_cur = bad_usb->st.line_cur - 1;
+        delay_val = ducky_script_repeat(bad_usb, bytecode);
+    } else {
+        if(bad_usb->script && !ducky_script_line_next(bad_usb)) {
+            bad_usb->st.error_line = bad_usb->st.line_cur + 1;
+            ducky_error(bad_usb, "Script read error");
             return SCRIPT_STATE_ERROR;
-        } else {
-            return (delay_val + bad_usb->defdelay);
         }
-    }
 
-    furi_string_set(bad_usb->line_prev, bad_usb->line);
-    furi_string_reset(bad_usb->line);
+        DuckyInstruction instruction;
+        uint32_t pos = stream_tell(bytecode);
+        size_t read_len = stream_read(bytecode, (uint8_t*)&instruction, sizeof(instruction));
+        if(read_len == 0) return SCRIPT_STATE_END;
 
-    while(1) {
-        if(bad_usb->buf_len == 0) {
-            bad_usb->buf_len = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
-            if(storage_file_eof(script_file)) {
-                if((bad_usb->buf_len < FILE_BUFFER_LEN) && (bad_usb->file_end == false)) {
-                    bad_usb->file_buf[bad_usb->buf_len] = '\n';
-                    bad_usb->buf_len++;
-                    bad_usb->file_end = true;
-                }
-            }
-
-            bad_usb->buf_start = 0;
-            if(bad_usb->buf_len == 0) return SCRIPT_STATE_END;
-        }
-        for(uint8_t i = bad_usb->buf_start; i < (bad_usb->buf_start + bad_usb->buf_len); i++) {
-            if(bad_usb->file_buf[i] == '\n' && furi_string_size(bad_usb->line) > 0) {
-                bad_usb->st.line_cur++;
-                bad_usb->buf_len = bad_usb->buf_len + bad_usb->buf_start - (i + 1);
-                bad_usb->buf_start = i + 1;
-                furi_string_trim(bad_usb->line);
-                delay_val = ducky_parse_line(bad_usb, bad_usb->line);
-                if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-                    return 0;
-                } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
-                    return delay_val;
-                } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
-                    return delay_val;
-                } else if(delay_val < 0) {
-                    bad_usb->st.error_line = bad_usb->st.line_cur;
-                    FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_usb->st.line_cur);
-                    return SCRIPT_STATE_ERROR;
-                } else {
-                    return (delay_val + bad_usb->defdelay);
-                }
-            } else {
-                furi_string_push_back(bad_usb->line, bad_usb->file_buf[i]);
+        bad_usb->st.line_cur++;
+        line_cur = bad_usb->st.line_cur;
+        if(read_len != sizeof(instruction)) {
+            delay_val = ducky_error(bad_usb, "Script cache is damaged");
+        } else {
+            if(instruction.op != DuckyOpRepeat) {
+                bad_usb->repeat_pos = pos;
             }
+            delay_val = ducky_execute(bad_usb, bytecode, &instruction);
         }
-        bad_usb->buf_len = 0;
-        if(bad_usb->file_end) return SCRIPT_STATE_END;
     }
 
-    return 0;
+    if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
+        return 0;
+    } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
+        return delay_val;
+    } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
+        return delay_val;
+    } else if(delay_val < 0) { // Script error
+        bad_usb->st.error_line = line_cur;
+        FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", line_cur);
+        return SCRIPT_STATE_ERROR;
+    } else {
+        return (delay_val + bad_usb->defdelay);
+    }
+}
+
+static bool ducky_script_rewind(BadUsbScript* bad_usb) {
+    if(bad_usb->layout_changed) {
+        // Keycodes are resolved at compile time
+        if(!ducky_script_bytecode_open(bad_usb)) return false;
+    }
+    bad_usb->repeat_pos = 0;
+    if(bad_usb->script) {
+        // Line by line mode, bytecode is rebuilt for every line
+        return stream_rewind(bad_usb->script);
+    }
+    return stream_seek(bad_usb->bytecode, bad_usb->bytecode_start, StreamOffsetFromStart);
 }
 
 static void bad_usb_hid_state_callback(bool state, void* context) {
@@ -381,21 +328,18 @@ static int32_t bad_usb_worker(void* context) {
     int32_t delay_val = 0;
 
     FURI_LOG_I(WORKER_TAG, "Init");
-    File* script_file = storage_file_alloc(furi_record_open(RECORD_STORAGE));
-    bad_usb->line = furi_string_alloc();
-    bad_usb->line_prev = furi_string_alloc();
-    bad_usb->string_print = furi_string_alloc();
-
     furi_hal_hid_set_state_callback(bad_usb_hid_state_callback, bad_usb);
 
     while(1) {
         if(worker_state == BadUsbStateInit) { // State: initialization
-            if(storage_file_open(
-                   script_file,
-                   furi_string_get_cstr(bad_usb->file_path),
-                   FSAM_READ,
-                   FSOM_OPEN_EXISTING)) {
-                if((ducky_script_preload(bad_usb, script_file)) && (bad_usb->st.line_nb > 0)) {
+            if(ducky_script_bytecode_open(bad_usb)) {
+                if(bad_usb->id_set) {
+                    furi_check(furi_hal_usb_set_config(&usb_hid, &bad_usb->hid_cfg));
+                } else {
+                    furi_check(furi_hal_usb_set_config(&usb_hid, NULL));
+                }
+
+                if(bad_usb->st.line_nb > 0) {
                     if(furi_hal_hid_is_connected()) {
                         worker_state = BadUsbStateIdle; // Ready to run
                     } else {
@@ -432,15 +376,19 @@ static int32_t bad_usb_worker(void* context) {
             } else if(flags & WorkerEvtStartStop) { // Start executing script
                 dolphin_deed(DolphinDeedBadUsbPlayScript);
                 delay_val = 0;
-                bad_usb->buf_len = 0;
                 bad_usb->st.line_cur = 0;
                 bad_usb->defdelay = 0;
                 bad_usb->stringdelay = 0;
+                bad_usb->string_mode = HidKbTypeModeNormal;
+                bad_usb->string_interval = 0;
                 bad_usb->repeat_cnt = 0;
                 bad_usb->key_hold_nb = 0;
-                bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
-                worker_state = BadUsbStateRunning;
+                if(ducky_script_rewind(bad_usb)) {
+                    worker_state = BadUsbStateRunning;
+                } else {
+                    FURI_LOG_E(WORKER_TAG, "File open error");
+                    worker_state = BadUsbStateFileError;
+                }
             } else if(flags & WorkerEvtDisconnect) {
                 worker_state = BadUsbStateNotConnected; // USB disconnected
             }
@@ -455,13 +403,18 @@ static int32_t bad_usb_worker(void* context) {
             } else if(flags & WorkerEvtConnect) { // Start executing script
                 dolphin_deed(DolphinDeedBadUsbPlayScript);
                 delay_val = 0;
-                bad_usb->buf_len = 0;
                 bad_usb->st.line_cur = 0;
                 bad_usb->defdelay = 0;
                 bad_usb->stringdelay = 0;
+                bad_usb->string_mode = HidKbTypeModeNormal;
+                bad_usb->string_interval = 0;
                 bad_usb->repeat_cnt = 0;
-                bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
+                if(!ducky_script_rewind(bad_usb)) {
+                    FURI_LOG_E(WORKER_TAG, "File open error");
+                    worker_state = BadUsbStateFileError;
+                    bad_usb->st.state = worker_state;
+                    continue;
+                }
                 // extra time for PC to recognize Flipper as keyboard
                 flags = furi_thread_flags_wait(
                     WorkerEvtEnd | WorkerEvtDisconnect | WorkerEvtStartStop,
@@ -510,7 +463,7 @@ static int32_t bad_usb_worker(void* context) {
                     continue;
                 }
                 bad_usb->st.state = BadUsbStateRunning;
-                delay_val = ducky_script_execute_next(bad_usb, script_file);
+                delay_val = ducky_script_execute_next(bad_usb, bad_usb->bytecode);
                 if(delay_val == SCRIPT_STATE_ERROR) { // Script error
                     delay_val = 0;
                     worker_state = BadUsbStateScriptError;
@@ -630,11 +583,8 @@ static int32_t bad_usb_worker(void* context) {
 
     furi_hal_hid_set_state_callback(NULL, NULL);
 
-    storage_file_close(script_file);
-    storage_file_free(script_file);
-    furi_string_free(bad_usb->line);
-    furi_string_free(bad_usb->line_prev);
-    furi_string_free(bad_usb->string_print);
+    ducky_script_bytecode_close(bad_usb);
+    free(bad_usb->string_keys);
 
     FURI_LOG_I(WORKER_TAG, "End");
 
@@ -647,13 +597,16 @@ static void bad_usb_script_set_default_keyboard_layout(BadUsbScript* bad_usb) {
     memcpy(bad_usb->layout, hid_asciimap, MIN(sizeof(hid_asciimap), sizeof(bad_usb->layout)));
 }
 
-BadUsbScript* bad_usb_script_open(FuriString* file_path) {
+BadUsbScript* bad_usb_script_open(FuriString* file_path, FuriString* layout_path) {
     furi_assert(file_path);
+    furi_assert(layout_path);
 
     BadUsbScript* bad_usb = malloc(sizeof(BadUsbScript));
     bad_usb->file_path = furi_string_alloc();
     furi_string_set(bad_usb->file_path, file_path);
     bad_usb_script_set_default_keyboard_layout(bad_usb);
+    // Layout is needed before the worker validates or compiles the bytecode
+    bad_usb_script_set_keyboard_layout(bad_usb, layout_path);
 
     bad_usb->st.state = BadUsbStateInit;
     bad_usb->st.error[0] = '\0';
@@ -680,6 +633,9 @@ void bad_usb_script_set_keyboard_layout(BadUsbScript* bad_usb, FuriString* layou
         return;
     }
 
+    uint16_t layout_prev[128];
+    memcpy(layout_prev, bad_usb->layout, sizeof(layout_prev));
+
     File* layout_file = storage_file_alloc(furi_record_open(RECORD_STORAGE));
     if(!furi_string_empty(layout_path)) { //-V1051
         if(storage_file_open(
@@ -694,6 +650,10 @@ void bad_usb_script_set_keyboard_layout(BadUsbScript* bad_usb, FuriString* layou
         bad_usb_script_set_default_keyboard_layout(bad_usb);
     }
     storage_file_free(layout_file);
+
+    if(memcmp(layout_prev, bad_usb->layout, sizeof(layout_prev)) != 0) {
+        bad_usb->layout_changed = true; // Bytecode gets rebuilt on next start
+    }
 }
 
 void bad_usb_script_start_stop(BadUsbScript* bad_usb) {
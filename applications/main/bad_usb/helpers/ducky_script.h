@@ -33,7 +33,7 @@ typedef struct {
 
 typedef struct BadUsbScript BadUsbScript;
 
-BadUsbScript* bad_usb_script_open(FuriString* file_path);
+BadUsbScript* bad_usb_script_open(FuriString* file_path, FuriString* layout_path);
 
 void bad_usb_script_close(BadUsbScript* bad_usb);
 
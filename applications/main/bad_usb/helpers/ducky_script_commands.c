@@ -11,6 +11,19 @@ typedef struct {
     int32_t param;
 } DuckyCmd;
 
+static const uint8_t numpad_keys[10] = {
+    HID_KEYPAD_0,
+    HID_KEYPAD_1,
+    HID_KEYPAD_2,
+    HID_KEYPAD_3,
+    HID_KEYPAD_4,
+    HID_KEYPAD_5,
+    HID_KEYPAD_6,
+    HID_KEYPAD_7,
+    HID_KEYPAD_8,
+    HID_KEYPAD_9,
+};
+
 static int32_t ducky_fnc_delay(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
@@ -18,7 +31,7 @@ static int32_t ducky_fnc_delay(BadUsbScript* bad_usb, const char* line, int32_t
     uint32_t delay_val = 0;
     bool state = ducky_get_number(line, &delay_val);
     if((state) && (delay_val > 0)) {
-        return (int32_t)delay_val;
+        return ducky_emit(bad_usb, DuckyOpDelay, delay_val, NULL, 0);
     }
 
     return ducky_error(bad_usb, "Invalid number %s", line);
@@ -28,52 +41,61 @@ static int32_t ducky_fnc_defdelay(BadUsbScript* bad_usb, const char* line, int32
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->defdelay);
+    uint32_t delay_val = 0;
+    bool state = ducky_get_number(line, &delay_val);
     if(!state) {
         return ducky_error(bad_usb, "Invalid number %s", line);
     }
-    return 0;
+    return ducky_emit(bad_usb, DuckyOpDefaultDelay, delay_val, NULL, 0);
 }
 
 static int32_t ducky_fnc_strdelay(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->stringdelay);
+    uint32_t delay_val = 0;
+    bool state = ducky_get_number(line, &delay_val);
     if(!state) {
         return ducky_error(bad_usb, "Invalid number %s", line);
     }
-    return 0;
+    return ducky_emit(bad_usb, DuckyOpStringDelay, delay_val, NULL, 0);
 }
 
 static int32_t ducky_fnc_string(BadUsbScript* bad_usb, const char* line, int32_t param) {
     line = &line[ducky_get_command_len(line) + 1];
-    furi_string_set_str(bad_usb->string_print, line);
-    if(param == 1) {
-        furi_string_cat(bad_usb->string_print, "\n");
-    }
-
-    if(bad_usb->stringdelay == 0) { // stringdelay not set - run command immediately
-        bool state = ducky_string(bad_usb, furi_string_get_cstr(bad_usb->string_print));
-        if(!state) {
-            return ducky_error(bad_usb, "Invalid string %s", line);
+    size_t len = strlen(line);
+    uint16_t* keys = malloc((len + 1) * sizeof(uint16_t));
+    size_t count = 0;
+
+    for(size_t i = 0; i < len; i++) {
+        if(line[i] != '\n') {
+            uint16_t keycode = BADUSB_ASCII_TO_KEY(bad_usb, line[i]);
+            if(keycode != HID_KEYBOARD_NONE) {
+                keys[count++] = keycode;
+            }
+        } else {
+            keys[count++] = HID_KEYBOARD_RETURN;
         }
-    } else { // stringdelay is set - run command in thread to keep handling external events
-        return SCRIPT_STATE_STRING_START;
+    }
+    if(param == 1) {
+        keys[count++] = HID_KEYBOARD_RETURN;
     }
 
-    return 0;
+    int32_t result = ducky_emit(bad_usb, DuckyOpString, count, keys, count * sizeof(uint16_t));
+    free(keys);
+    return result;
 }
 
 static int32_t ducky_fnc_repeat(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->repeat_cnt);
-    if((!state) || (bad_usb->repeat_cnt == 0)) {
+    uint32_t repeat_cnt = 0;
+    bool state = ducky_get_number(line, &repeat_cnt);
+    if((!state) || (repeat_cnt == 0)) {
         return ducky_error(bad_usb, "Invalid number %s", line);
     }
-    return 0;
+    return ducky_emit(bad_usb, DuckyOpRepeat, repeat_cnt, NULL, 0);
 }
 
 static int32_t ducky_fnc_sysrq(BadUsbScript* bad_usb, const char* line, int32_t param) {
@@ -81,34 +103,74 @@ static int32_t ducky_fnc_sysrq(BadUsbScript* bad_usb, const char* line, int32_t
 
     line = &line[ducky_get_command_len(line) + 1];
     uint16_t key = ducky_get_keycode(bad_usb, line, true);
-    furi_hal_hid_kb_press(KEY_MOD_LEFT_ALT | HID_KEYBOARD_PRINT_SCREEN);
-    furi_hal_hid_kb_press(key);
-    furi_hal_hid_kb_release_all();
-    return 0;
+    return ducky_emit(bad_usb, DuckyOpSysrq, key, NULL, 0);
+}
+
+/* Appends keypad keys of a decimal char code, false if it is not one */
+static bool ducky_altchar(const char* charcode, uint16_t* keys, size_t* count) {
+    uint8_t i = 0;
+    bool state = false;
+
+    while(!ducky_is_line_end(charcode[i])) {
+        state = (charcode[i] >= '0') && (charcode[i] <= '9');
+        if(state == false) break;
+        keys[(*count)++] = numpad_keys[charcode[i] - '0'];
+        i++;
+    }
+
+    return state;
 }
 
 static int32_t ducky_fnc_altchar(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
-    ducky_numlock_on();
-    bool state = ducky_altchar(line);
-    if(!state) {
-        return ducky_error(bad_usb, "Invalid altchar %s", line);
+    uint16_t* keys = malloc((strlen(line) + 1) * sizeof(uint16_t));
+    size_t count = 0;
+
+    int32_t result;
+    if(ducky_altchar(line, keys, &count)) {
+        result = ducky_emit(bad_usb, DuckyOpAltCodes, count, keys, count * sizeof(uint16_t));
+    } else {
+        result = ducky_error(bad_usb, "Invalid altchar %s", line);
     }
-    return 0;
+
+    free(keys);
+    return result;
 }
 
 static int32_t ducky_fnc_altstring(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
-    ducky_numlock_on();
-    bool state = ducky_altstring(line);
-    if(!state) {
-        return ducky_error(bad_usb, "Invalid altstring %s", line);
+    // Up to 3 digits and a separator per char
+    uint16_t* keys = malloc((strlen(line) * 4 + 1) * sizeof(uint16_t));
+    size_t count = 0;
+    bool state = false;
+
+    for(size_t i = 0; line[i] != '\0'; i++) {
+        if((line[i] < ' ') || (line[i] > '~')) {
+            continue; // Skip non-printable chars
+        }
+
+        char temp_str[4];
+        snprintf(temp_str, 4, "%u", line[i]);
+
+        if(count > 0) {
+            keys[count++] = HID_KEYBOARD_NONE;
+        }
+        state = ducky_altchar(temp_str, keys, &count);
     }
-    return 0;
+
+    int32_t result;
+    if(state) {
+        result = ducky_emit(bad_usb, DuckyOpAltCodes, count, keys, count * sizeof(uint16_t));
+    } else {
+        result = ducky_error(bad_usb, "Invalid altstring %s", line);
+    }
+
+    free(keys);
+    return result;
 }
 
 static int32_t ducky_fnc_hold(BadUsbScript* bad_usb, const char* line, int32_t param) {
@@ -119,12 +181,7 @@ static int32_t ducky_fnc_hold(BadUsbScript* bad_usb, const char* line, int32_t p
     if(key == HID_KEYBOARD_NONE) {
         return ducky_error(bad_usb, "No keycode defined for %s", line);
     }
-    bad_usb->key_hold_nb++;
-    if(bad_usb->key_hold_nb > (HID_KB_MAX_KEYS - 1)) {
-        return ducky_error(bad_usb, "Too many keys are hold");
-    }
-    furi_hal_hid_kb_press(key);
-    return 0;
+    return ducky_emit(bad_usb, DuckyOpHold, key, NULL, 0);
 }
 
 static int32_t ducky_fnc_release(BadUsbScript* bad_usb, const char* line, int32_t param) {
@@ -135,20 +192,32 @@ static int32_t ducky_fnc_release(BadUsbScript* bad_usb, const char* line, int32_
     if(key == HID_KEYBOARD_NONE) {
         return ducky_error(bad_usb, "No keycode defined for %s", line);
     }
-    if(bad_usb->key_hold_nb == 0) {
-        return ducky_error(bad_usb, "No keys are hold");
-    }
-    bad_usb->key_hold_nb--;
-    furi_hal_hid_kb_release(key);
-    return 0;
+    return ducky_emit(bad_usb, DuckyOpRelease, key, NULL, 0);
 }
 
 static int32_t ducky_fnc_waitforbutton(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
-    UNUSED(bad_usb);
     UNUSED(line);
 
-    return SCRIPT_STATE_WAIT_FOR_BTN;
+    return ducky_emit(bad_usb, DuckyOpWaitForButton, 0, NULL, 0);
+}
+
+static int32_t ducky_fnc_turbo(BadUsbScript* bad_usb, const char* line, int32_t param) {
+    UNUSED(param);
+
+    line = &line[ducky_get_command_len(line) + 1];
+    if(strcmp(line, "OFF") == 0) {
+        return ducky_emit(bad_usb, DuckyOpTurbo, DUCKY_TURBO_OFF, NULL, 0);
+    } else if(strcmp(line, "COLLAPSE") == 0) {
+        return ducky_emit(bad_usb, DuckyOpTurbo, DUCKY_TURBO_COLLAPSE, NULL, 0);
+    }
+
+    uint32_t interval = 0;
+    bool state = ducky_get_number(line, &interval);
+    if((!state) || (interval >= DUCKY_TURBO_COLLAPSE)) {
+        return ducky_error(bad_usb, "Invalid number %s", line);
+    }
+    return ducky_emit(bad_usb, DuckyOpTurbo, interval, NULL, 0);
 }
 
 static const DuckyCmd ducky_commands[] = {
@@ -169,12 +238,13 @@ static const DuckyCmd ducky_commands[] = {
     {"HOLD", ducky_fnc_hold, -1},
     {"RELEASE", ducky_fnc_release, -1},
     {"WAIT_FOR_BUTTON_PRESS", ducky_fnc_waitforbutton, -1},
+    {"TURBO", ducky_fnc_turbo, -1},
 };
 
 #define TAG "BadUsb"
 #define WORKER_TAG TAG "Worker"
 
-int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line) {
+int32_t ducky_compile_cmd(BadUsbScript* bad_usb, const char* line) {
     size_t cmd_word_len = strcspn(line, " ");
     for(size_t i = 0; i < COUNT_OF(ducky_commands); i++) {
         size_t cmd_compare_len = strlen(ducky_commands[i].name);
@@ -185,7 +255,7 @@ int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line) {
 
         if(strncmp(line, ducky_commands[i].name, cmd_compare_len) == 0) {
             if(ducky_commands[i].callback == NULL) {
-                return 0;
+                return ducky_emit(bad_usb, DuckyOpNone, 0, NULL, 0);
             } else {
                 return ((ducky_commands[i].callback)(bad_usb, line, ducky_commands[i].param));
             }
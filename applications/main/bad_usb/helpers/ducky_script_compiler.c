@@ -0,0 +1,574 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi_hal_usb_hid.h>
+#include <storage/storage.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/stream/string_stream.h>
+#include <toolbox/crc32_calc.h>
+#include "ducky_script.h"
+#include "ducky_script_i.h"
+
+#define TAG "BadUsb"
+#define WORKER_TAG TAG "Worker"
+
+#define DUCKY_BYTECODE_PATH CACHE_PATH("bad_usb")
+#define DUCKY_BYTECODE_MAGIC (0x43425544UL) /* "DUBC" */
+#define DUCKY_BYTECODE_VERSION (5)
+/* Cached scripts kept, the oldest compiled ones are dropped first */
+#define DUCKY_BYTECODE_CACHE_MAX (16)
+/* Bytecode compiled to RAM when cache is not writable, larger scripts run line by line */
+#define DUCKY_BYTECODE_RAM_MAX (8 * 1024)
+
+#define COMPILE_BUFFER_LEN 64
+
+static const char ducky_cmd_id[] = {"ID"};
+
+/* On-disk bytecode header, followed by instructions */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint32_t sequence; /* compile order, for cache eviction */
+    uint32_t script_size;
+    uint32_t script_crc;
+    uint16_t layout[128];
+    uint32_t line_nb;
+    uint8_t id_set;
+    uint32_t vid;
+    uint32_t pid;
+    char manuf[HID_MANUF_PRODUCT_NAME_LEN];
+    char product[HID_MANUF_PRODUCT_NAME_LEN];
+} __attribute__((packed)) DuckyBytecodeHeader;
+
+int32_t ducky_emit(
+    BadUsbScript* bad_usb,
+    DuckyOp op,
+    uint32_t arg,
+    const void* payload,
+    size_t payload_size) {
+    furi_assert(bad_usb->bytecode_out);
+
+    DuckyInstruction instruction = {.op = op, .arg = arg};
+    if(stream_write(bad_usb->bytecode_out, (const uint8_t*)&instruction, sizeof(instruction)) !=
+       sizeof(instruction)) {
+        return SCRIPT_STATE_FILE_ERROR;
+    }
+    if(payload_size &&
+       stream_write(bad_usb->bytecode_out, payload, payload_size) != payload_size) {
+        return SCRIPT_STATE_FILE_ERROR;
+    }
+    return 0;
+}
+
+static int32_t ducky_compile_line(BadUsbScript* bad_usb, FuriString* line) {
+    uint32_t line_len = furi_string_size(line);
+    const char* line_tmp = furi_string_get_cstr(line);
+
+    if(line_len == 0) {
+        return ducky_emit(bad_usb, DuckyOpSkip, 0, NULL, 0); // Skip empty lines
+    }
+
+    // Ducky Lang Functions
+    int32_t cmd_result = ducky_compile_cmd(bad_usb, line_tmp);
+    if(cmd_result != SCRIPT_STATE_CMD_UNKNOWN) {
+        return cmd_result;
+    }
+
+    // Special keys + modifiers
+    uint16_t key = ducky_get_keycode(bad_usb, line_tmp, false);
+    if(key == HID_KEYBOARD_NONE) {
+        return ducky_error(bad_usb, "No keycode defined for %s", line_tmp);
+    }
+    if((key & 0xFF00) != 0) {
+        // It's a modifier key
+        uint32_t offset = ducky_get_command_len(line_tmp) + 1;
+        // ducky_get_command_len() returns 0 without space, so check for != 1
+        if(offset != 1 && line_len > offset) {
+            // It's also a key combination
+            key |= ducky_get_keycode(bad_usb, line_tmp + offset, true);
+        }
+    }
+    return ducky_emit(bad_usb, DuckyOpKey, key, NULL, 0);
+}
+
+static bool ducky_set_usb_id(BadUsbScript* bad_usb, const char* line) {
+    if(sscanf(line, "%lX:%lX", &bad_usb->hid_cfg.vid, &bad_usb->hid_cfg.pid) == 2) {
+        bad_usb->hid_cfg.manuf[0] = '\0';
+        bad_usb->hid_cfg.product[0] = '\0';
+
+        uint8_t id_len = ducky_get_command_len(line);
+        if(!ducky_is_line_end(line[id_len + 1])) {
+            sscanf(
+                &line[id_len + 1],
+                "%31[^\r\n:]:%31[^\r\n]",
+                bad_usb->hid_cfg.manuf,
+                bad_usb->hid_cfg.product);
+        }
+        FURI_LOG_D(
+            WORKER_TAG,
+            "set id: %04lX:%04lX mfr:%s product:%s",
+            bad_usb->hid_cfg.vid,
+            bad_usb->hid_cfg.pid,
+            bad_usb->hid_cfg.manuf,
+            bad_usb->hid_cfg.product);
+        return true;
+    }
+    return false;
+}
+
+static void ducky_count_line(BadUsbScript* bad_usb, FuriString* line) {
+    const char* line_tmp = furi_string_get_cstr(line);
+
+    bad_usb->st.line_nb++;
+    if((bad_usb->st.line_nb == 1) &&
+       (strncmp(line_tmp, ducky_cmd_id, strlen(ducky_cmd_id)) == 0)) {
+        // Looking for ID command at first line
+        bad_usb->id_set = ducky_set_usb_id(bad_usb, &line_tmp[strlen(ducky_cmd_id) + 1]);
+    }
+}
+
+/* Script errors become error instructions, so they still show up on the line they are at */
+static bool ducky_compile_script_line(BadUsbScript* bad_usb, FuriString* line) {
+    furi_string_trim(line);
+    int32_t result = ducky_compile_line(bad_usb, line);
+    if(result == SCRIPT_STATE_ERROR) {
+        size_t error_len = strlen(bad_usb->st.error);
+        result = ducky_emit(bad_usb, DuckyOpError, error_len, bad_usb->st.error, error_len);
+        bad_usb->st.error[0] = '\0';
+    }
+
+    return result != SCRIPT_STATE_FILE_ERROR;
+}
+
+static bool ducky_compile_next(BadUsbScript* bad_usb, FuriString* line) {
+    ducky_count_line(bad_usb, line);
+    return ducky_compile_script_line(bad_usb, line);
+}
+
+/* Compiles the whole script, size_max of 0 means no limit */
+static bool ducky_script_compile(
+    BadUsbScript* bad_usb,
+    Storage* storage,
+    Stream* bytecode,
+    DuckyBytecodeHeader* header,
+    size_t size_max) {
+    File* script_file = storage_file_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    uint8_t file_buf[COMPILE_BUFFER_LEN + 1];
+    uint32_t script_crc = 0;
+    bool success = false;
+
+    bad_usb->bytecode_out = bytecode;
+    bad_usb->st.line_nb = 0;
+    bad_usb->id_set = false;
+
+    do {
+        if(!storage_file_open(
+               script_file,
+               furi_string_get_cstr(bad_usb->file_path),
+               FSAM_READ,
+               FSOM_OPEN_EXISTING))
+            break;
+
+        // Written with a valid magic only after the whole script is compiled
+        DuckyBytecodeHeader placeholder = {0};
+        if(stream_write(bytecode, (const uint8_t*)&placeholder, sizeof(placeholder)) !=
+           sizeof(placeholder))
+            break;
+
+        bool file_end = false;
+        bool is_error = false;
+        while(!file_end && !is_error) {
+            size_t buf_len = storage_file_read(script_file, file_buf, COMPILE_BUFFER_LEN);
+            script_crc = crc32_calc_buffer(script_crc, file_buf, buf_len);
+            if(buf_len < COMPILE_BUFFER_LEN) {
+                file_buf[buf_len++] = '\n';
+                file_end = true;
+            }
+
+            for(size_t i = 0; i < buf_len; i++) {
+                if(file_buf[i] == '\n') {
+                    if(furi_string_size(line) > 0) {
+                        if(!ducky_compile_next(bad_usb, line) ||
+                           (size_max && stream_size(bytecode) > size_max)) {
+                            is_error = true;
+                            break;
+                        }
+                        furi_string_reset(line);
+                    }
+                } else {
+                    furi_string_push_back(line, file_buf[i]);
+                }
+            }
+        }
+        if(is_error) break;
+
+        // Hash of what was actually compiled, script could change since it was checked
+        header->script_crc = script_crc;
+        header->line_nb = bad_usb->st.line_nb;
+        header->id_set = bad_usb->id_set;
+        if(bad_usb->id_set) {
+            header->vid = bad_usb->hid_cfg.vid;
+            header->pid = bad_usb->hid_cfg.pid;
+            memcpy(header->manuf, bad_usb->hid_cfg.manuf, sizeof(header->manuf));
+            memcpy(header->product, bad_usb->hid_cfg.product, sizeof(header->product));
+        }
+
+        if(!stream_rewind(bytecode)) break;
+        if(stream_write(bytecode, (const uint8_t*)header, sizeof(DuckyBytecodeHeader)) !=
+           sizeof(DuckyBytecodeHeader))
+            break;
+
+        success = true;
+    } while(false);
+
+    bad_usb->bytecode_out = NULL;
+    storage_file_free(script_file);
+    furi_string_free(line);
+
+    return success;
+}
+
+/* Size and content hash, mtime alone misses edits within FAT 2 second resolution */
+static bool ducky_script_get_script_info(
+    BadUsbScript* bad_usb,
+    Storage* storage,
+    DuckyBytecodeHeader* header) {
+    File* script_file = storage_file_alloc(storage);
+    bool success = false;
+
+    memset(header, 0, sizeof(DuckyBytecodeHeader));
+    header->magic = DUCKY_BYTECODE_MAGIC;
+    header->version = DUCKY_BYTECODE_VERSION;
+    memcpy(header->layout, bad_usb->layout, sizeof(header->layout));
+
+    if(storage_file_open(
+           script_file, furi_string_get_cstr(bad_usb->file_path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        header->script_size = storage_file_size(script_file);
+        header->script_crc = crc32_calc_file(script_file, NULL, NULL);
+        success = true;
+    }
+
+    storage_file_free(script_file);
+    return success;
+}
+
+/* Bytecode is valid only for the script contents and keyboard layout it was built from */
+static bool ducky_script_load_header(
+    Stream* bytecode,
+    const DuckyBytecodeHeader* expected,
+    DuckyBytecodeHeader* header) {
+    if(!stream_rewind(bytecode)) return false;
+    if(stream_read(bytecode, (uint8_t*)header, sizeof(DuckyBytecodeHeader)) !=
+       sizeof(DuckyBytecodeHeader))
+        return false;
+    if(header->magic != expected->magic || header->version != expected->version ||
+       header->script_size != expected->script_size ||
+       header->script_crc != expected->script_crc)
+        return false;
+    return memcmp(header->layout, expected->layout, sizeof(header->layout)) == 0;
+}
+
+/* Makes room for one more script in the cache, returns compile order number for it */
+static uint32_t ducky_script_cache_prune(Storage* storage) {
+    File* dir = storage_file_alloc(storage);
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    FuriString* oldest_path = furi_string_alloc();
+    char name[16];
+    uint32_t sequence_max = 0;
+
+    while(true) {
+        size_t count = 0;
+        uint32_t sequence_min = UINT32_MAX;
+
+        if(storage_dir_open(dir, DUCKY_BYTECODE_PATH)) {
+            FileInfo fileinfo;
+            while(storage_dir_read(dir, &fileinfo, name, sizeof(name))) {
+                size_t name_len = strlen(name);
+                if(file_info_is_dir(&fileinfo) || name_len != strlen("00000000.dbc") ||
+                   strcmp(&name[name_len - strlen(".dbc")], ".dbc") != 0)
+                    continue;
+                furi_string_printf(path, DUCKY_BYTECODE_PATH "/%s", name);
+
+                uint32_t magic = 0, sequence = 0;
+                uint8_t version = 0;
+                bool is_valid =
+                    storage_file_open(
+                        file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING) &&
+                    storage_file_read(file, &magic, sizeof(magic)) == sizeof(magic) &&
+                    storage_file_read(file, &version, sizeof(version)) == sizeof(version) &&
+                    magic == DUCKY_BYTECODE_MAGIC && version == DUCKY_BYTECODE_VERSION &&
+                    storage_file_read(file, &sequence, sizeof(sequence)) == sizeof(sequence);
+                storage_file_close(file);
+                // Unreadable and outdated files go first
+                if(!is_valid) sequence = 0;
+
+                count++;
+                sequence_max = MAX(sequence_max, sequence);
+                if(sequence < sequence_min) {
+                    sequence_min = sequence;
+                    furi_string_set(oldest_path, path);
+                }
+            }
+        }
+        storage_dir_close(dir);
+
+        if(count < DUCKY_BYTECODE_CACHE_MAX) break;
+        if(!storage_simply_remove(storage, furi_string_get_cstr(oldest_path))) break;
+        FURI_LOG_D(WORKER_TAG, "Evicted %s", furi_string_get_cstr(oldest_path));
+    }
+
+    furi_string_free(oldest_path);
+    furi_string_free(path);
+    storage_file_free(file);
+    storage_file_free(dir);
+
+    return sequence_max + 1;
+}
+
+/* Bytecode of every script is kept in the cache directory, named by script path hash */
+static Stream* ducky_script_cache_open(
+    BadUsbScript* bad_usb,
+    Storage* storage,
+    const DuckyBytecodeHeader* expected,
+    DuckyBytecodeHeader* header) {
+    const char* script_path = furi_string_get_cstr(bad_usb->file_path);
+    FuriString* cache_path = furi_string_alloc_printf(
+        DUCKY_BYTECODE_PATH "/%08lX.dbc", crc32_calc_buffer(0, script_path, strlen(script_path)));
+    Stream* bytecode = file_stream_alloc(storage);
+    bool success = false;
+
+    do {
+        if(file_stream_open(
+               bytecode, furi_string_get_cstr(cache_path), FSAM_READ, FSOM_OPEN_EXISTING) &&
+           ducky_script_load_header(bytecode, expected, header)) {
+            success = true;
+            break;
+        }
+        file_stream_close(bytecode);
+
+        if(!storage_simply_mkdir(storage, STORAGE_CACHE_PATH_PREFIX)) break;
+        if(!storage_simply_mkdir(storage, DUCKY_BYTECODE_PATH)) break;
+        // Outdated bytecode of this script must not take a place of another one
+        storage_simply_remove(storage, furi_string_get_cstr(cache_path));
+        DuckyBytecodeHeader compiled = *expected;
+        compiled.sequence = ducky_script_cache_prune(storage);
+
+        if(!file_stream_open(
+               bytecode,
+               furi_string_get_cstr(cache_path),
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS))
+            break;
+
+        uint32_t start = furi_get_tick();
+        if(!ducky_script_compile(bad_usb, storage, bytecode, &compiled, 0)) {
+            // Don't leave a partial file behind, e.g. when card is full
+            file_stream_close(bytecode);
+            storage_simply_remove(storage, furi_string_get_cstr(cache_path));
+            break;
+        }
+        FURI_LOG_I(
+            WORKER_TAG,
+            "Compiled %zu lines in %lums",
+            bad_usb->st.line_nb,
+            furi_get_tick() - start);
+
+        success = ducky_script_load_header(bytecode, expected, header);
+    } while(false);
+
+    if(!success) {
+        stream_free(bytecode);
+        bytecode = NULL;
+    }
+    furi_string_free(cache_path);
+
+    return bytecode;
+}
+
+/* Fallback when cache is not writable, e.g. card is full or read-only */
+static Stream* ducky_script_memory_open(
+    BadUsbScript* bad_usb,
+    Storage* storage,
+    const DuckyBytecodeHeader* expected,
+    DuckyBytecodeHeader* header) {
+    Stream* bytecode = string_stream_alloc();
+    DuckyBytecodeHeader compiled = *expected;
+
+    if(!ducky_script_compile(bad_usb, storage, bytecode, &compiled, DUCKY_BYTECODE_RAM_MAX) ||
+       !ducky_script_load_header(bytecode, expected, header)) {
+        stream_free(bytecode);
+        return NULL;
+    }
+
+    FURI_LOG_W(WORKER_TAG, "Cache is not writable, compiled to RAM");
+    return bytecode;
+}
+
+/* Same line split as in ducky_script_compile, returns false at the end of script */
+static bool ducky_script_read_line(Stream* script, FuriString* line) {
+    uint8_t buf[COMPILE_BUFFER_LEN];
+    furi_string_reset(line);
+
+    while(true) {
+        size_t len = stream_read(script, buf, sizeof(buf));
+        if(len == 0) break;
+
+        for(size_t i = 0; i < len; i++) {
+            if(buf[i] == '\n') {
+                int32_t unread = len - (i + 1);
+                return stream_seek(script, -unread, StreamOffsetFromCurrent);
+            }
+            furi_string_push_back(line, buf[i]);
+        }
+    }
+
+    return furi_string_size(line) > 0;
+}
+
+/* Last resort for scripts that don't fit in RAM: lines are compiled one by one while running */
+static bool ducky_script_line_open(BadUsbScript* bad_usb, Storage* storage) {
+    Stream* script = file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    bool success = false;
+
+    bad_usb->st.line_nb = 0;
+    bad_usb->id_set = false;
+
+    if(file_stream_open(
+           script, furi_string_get_cstr(bad_usb->file_path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        while(ducky_script_read_line(script, line)) {
+            if(furi_string_size(line) > 0) {
+                ducky_count_line(bad_usb, line);
+            }
+        }
+        success = stream_rewind(script);
+    }
+    furi_string_free(line);
+
+    if(success) {
+        FURI_LOG_W(WORKER_TAG, "Script does not fit in RAM, running it line by line");
+        bad_usb->script = script;
+        bad_usb->bytecode = string_stream_alloc();
+        bad_usb->bytecode_start = sizeof(DuckyInstruction);
+    } else {
+        stream_free(script);
+    }
+
+    return success;
+}
+
+static size_t ducky_instruction_payload_size(const DuckyInstruction* instruction) {
+    switch(instruction->op) {
+    case DuckyOpString:
+    case DuckyOpAltCodes:
+        return instruction->arg * sizeof(uint16_t);
+    case DuckyOpError:
+        return instruction->arg;
+    default:
+        return 0;
+    }
+}
+
+bool ducky_script_line_next(BadUsbScript* bad_usb) {
+    furi_assert(bad_usb->script);
+
+    Stream* bytecode = bad_usb->bytecode;
+    uint8_t* repeat = NULL;
+    size_t repeat_size = 0;
+    bool success = false;
+
+    do {
+        // Only the instruction REPEAT runs again is kept from previous lines
+        if(bad_usb->repeat_pos) {
+            DuckyInstruction instruction;
+            if(!stream_seek(bytecode, bad_usb->repeat_pos, StreamOffsetFromStart)) break;
+            if(stream_read(bytecode, (uint8_t*)&instruction, sizeof(instruction)) !=
+               sizeof(instruction))
+                break;
+            repeat_size = sizeof(instruction) + ducky_instruction_payload_size(&instruction);
+            repeat = malloc(repeat_size);
+            if(!stream_seek(bytecode, bad_usb->repeat_pos, StreamOffsetFromStart)) break;
+            if(stream_read(bytecode, repeat, repeat_size) != repeat_size) break;
+        }
+
+        // Placeholder at offset 0, where repeat_pos means nothing to repeat
+        stream_clean(bytecode);
+        bad_usb->bytecode_out = bytecode;
+        if(ducky_emit(bad_usb, DuckyOpNone, 0, NULL, 0) != 0) break;
+        if(repeat_size) {
+            if(stream_write(bytecode, repeat, repeat_size) != repeat_size) break;
+            bad_usb->repeat_pos = bad_usb->bytecode_start;
+        }
+
+        FuriString* line = furi_string_alloc();
+        bool is_compiled = true;
+        while(ducky_script_read_line(bad_usb->script, line)) {
+            if(furi_string_size(line) > 0) {
+                is_compiled = ducky_compile_script_line(bad_usb, line);
+                break;
+            }
+        }
+        furi_string_free(line);
+
+        // Nothing is compiled at the end of script, so nothing is read either
+        success = is_compiled && stream_seek(
+                                     bytecode,
+                                     bad_usb->bytecode_start + repeat_size,
+                                     StreamOffsetFromStart);
+    } while(false);
+
+    bad_usb->bytecode_out = NULL;
+    free(repeat);
+
+    return success;
+}
+
+void ducky_script_bytecode_close(BadUsbScript* bad_usb) {
+    if(bad_usb->bytecode) {
+        stream_free(bad_usb->bytecode);
+        bad_usb->bytecode = NULL;
+    }
+    if(bad_usb->script) {
+        stream_free(bad_usb->script);
+        bad_usb->script = NULL;
+    }
+}
+
+bool ducky_script_bytecode_open(BadUsbScript* bad_usb) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    DuckyBytecodeHeader expected;
+    DuckyBytecodeHeader header;
+    bool success = false;
+
+    ducky_script_bytecode_close(bad_usb);
+
+    do {
+        bad_usb->layout_changed = false;
+        if(!ducky_script_get_script_info(bad_usb, storage, &expected)) break;
+
+        bad_usb->bytecode = ducky_script_cache_open(bad_usb, storage, &expected, &header);
+        if(!bad_usb->bytecode) {
+            bad_usb->bytecode = ducky_script_memory_open(bad_usb, storage, &expected, &header);
+        }
+        if(!bad_usb->bytecode) {
+            success = ducky_script_line_open(bad_usb, storage);
+            break;
+        }
+
+        bad_usb->st.line_nb = header.line_nb;
+        bad_usb->id_set = header.id_set;
+        if(bad_usb->id_set) {
+            bad_usb->hid_cfg.vid = header.vid;
+            bad_usb->hid_cfg.pid = header.pid;
+            memcpy(bad_usb->hid_cfg.manuf, header.manuf, sizeof(header.manuf));
+            memcpy(bad_usb->hid_cfg.product, header.product, sizeof(header.product));
+        }
+        bad_usb->bytecode_start = stream_tell(bad_usb->bytecode);
+        success = true;
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+
+    return success;
+}
@@ -6,6 +6,8 @@ extern "C" {
 
 #include <furi.h>
 #include <furi_hal.h>
+#include <storage/storage.h>
+#include <toolbox/stream/stream.h>
 #include "ducky_script.h"
 
 #define SCRIPT_STATE_ERROR (-1)
@@ -14,30 +16,64 @@ extern "C" {
 #define SCRIPT_STATE_CMD_UNKNOWN (-4)
 #define SCRIPT_STATE_STRING_START (-5)
 #define SCRIPT_STATE_WAIT_FOR_BTN (-6)
-
-#define FILE_BUFFER_LEN 16
+#define SCRIPT_STATE_FILE_ERROR (-7)
+
+#define DUCKY_TURBO_OFF UINT32_MAX
+#define DUCKY_TURBO_COLLAPSE (UINT32_MAX - 1)
+
+#define BADUSB_ASCII_TO_KEY(script, x) \
+    (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
+
+/* Every script line compiles to exactly one instruction */
+typedef enum {
+    DuckyOpSkip, /* blank line */
+    DuckyOpNone, /* REM, ID */
+    DuckyOpKey, /* arg: keycode with modifiers */
+    DuckyOpHold, /* arg: keycode */
+    DuckyOpRelease, /* arg: keycode */
+    DuckyOpSysrq, /* arg: keycode */
+    DuckyOpDelay, /* arg: delay in ms */
+    DuckyOpDefaultDelay, /* arg: delay in ms */
+    DuckyOpStringDelay, /* arg: delay in ms */
+    DuckyOpString, /* arg: count, followed by uint16_t keycodes */
+    DuckyOpAltCodes, /* arg: count, followed by uint16_t keypad keycodes, 0 between chars */
+    DuckyOpRepeat, /* arg: repeat count of the previous line */
+    DuckyOpWaitForButton,
+    DuckyOpTurbo, /* arg: min interval between reports in ms, DUCKY_TURBO_OFF or _COLLAPSE */
+    DuckyOpError, /* arg: length, followed by error message */
+} DuckyOp;
+
+typedef struct {
+    uint8_t op;
+    uint32_t arg;
+} __attribute__((packed)) DuckyInstruction;
 
 struct BadUsbScript {
     FuriHalUsbHidConfig hid_cfg;
+    bool id_set;
     FuriThread* thread;
     BadUsbState st;
 
     FuriString* file_path;
-    uint8_t file_buf[FILE_BUFFER_LEN + 1];
-    uint8_t buf_start;
-    uint8_t buf_len;
-    bool file_end;
+    Stream* bytecode; /* file in cache, or memory if cache is not writable */
+    Stream* bytecode_out; /* only during compilation */
+    Stream* script; /* only when running line by line, bytecode holds the current line */
+    uint32_t bytecode_start;
+    uint32_t repeat_pos;
 
     uint32_t defdelay;
     uint32_t stringdelay;
     uint16_t layout[128];
+    bool layout_changed;
 
-    FuriString* line;
-    FuriString* line_prev;
     uint32_t repeat_cnt;
     uint8_t key_hold_nb;
 
-    FuriString* string_print;
+    HidKbTypeMode string_mode;
+    uint32_t string_interval;
+    uint16_t* string_keys;
+    size_t string_keys_max;
+    size_t string_len;
     size_t string_print_pos;
 };
 
@@ -53,15 +89,20 @@ bool ducky_get_number(const char* param, uint32_t* val);
 
 void ducky_numlock_on(void);
 
-bool ducky_numpad_press(const char num);
+int32_t ducky_compile_cmd(BadUsbScript* bad_usb, const char* line);
 
-bool ducky_altchar(const char* charcode);
+int32_t ducky_emit(
+    BadUsbScript* bad_usb,
+    DuckyOp op,
+    uint32_t arg,
+    const void* payload,
+    size_t payload_size);
 
-bool ducky_altstring(const char* param);
+bool ducky_script_bytecode_open(BadUsbScript* bad_usb);
 
-bool ducky_string(BadUsbScript* bad_usb, const char* param);
+void ducky_script_bytecode_close(BadUsbScript* bad_usb);
 
-int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line);
+bool ducky_script_line_next(BadUsbScript* bad_usb);
 
 int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...);
 
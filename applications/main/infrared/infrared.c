@@ -329,8 +329,8 @@ void infrared_tx_start_signal(Infrared* infrared, InfraredSignal* signal) {
 
     if(infrared_signal_is_raw(signal)) {
         InfraredRawSignal* raw = infrared_signal_get_raw_signal(signal);
-        infrared_worker_set_raw_signal(
-            infrared->worker, raw->timings, raw->timings_size, raw->frequency, raw->duty_cycle);
+        infrared_worker_set_raw_signal_packed(
+            infrared->worker, raw->packed, raw->packed_size, raw->frequency, raw->duty_cycle);
     } else {
         InfraredMessage* message = infrared_signal_get_message(signal);
         infrared_worker_set_decoded_signal(infrared->worker, message);
@@ -2,13 +2,26 @@
 
 #include <stdlib.h>
 #include <m-dict.h>
+#include <storage/storage.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/crc32_calc.h>
 
 #include "infrared_signal.h"
 
+#define TAG "InfraredBruteForce"
+
+#define INFRARED_BRUTE_FORCE_INDEX_PATH CACHE_PATH("infrared")
+#define INFRARED_BRUTE_FORCE_INDEX_MAGIC (0x58444952UL) /* "RIDX" */
+#define INFRARED_BRUTE_FORCE_INDEX_VERSION (2)
+
+/* Every signal in database starts with "name: " line, so it can't be shorter */
+#define INFRARED_BRUTE_FORCE_SIGNAL_SIZE_MIN (sizeof("name: \n") - 1)
+
 typedef struct {
     uint32_t index;
     uint32_t count;
+    uint32_t* offsets; /**< positions of signal bodies in database */
 } InfraredBruteForceRecord;
 
 DICT_DEF2(
@@ -18,30 +31,265 @@ DICT_DEF2(
     InfraredBruteForceRecord,
     M_POD_OPLIST);
 
+/* On-disk index header, followed by records */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint32_t db_size;
+    uint32_t db_crc;
+    uint32_t record_count;
+} __attribute__((packed)) InfraredBruteForceIndexHeader;
+
+/* On-disk index record, followed by name and count offsets */
+typedef struct {
+    uint8_t name_length;
+    uint32_t count;
+} __attribute__((packed)) InfraredBruteForceIndexRecord;
+
 struct InfraredBruteForce {
     FlipperFormat* ff;
     const char* db_filename;
-    FuriString* current_record_name;
+    const uint32_t* current_offsets;
+    uint32_t current_count;
+    uint32_t current_position;
     InfraredSignal* current_signal;
     InfraredBruteForceRecordDict_t records;
     bool is_started;
 };
 
+static void infrared_brute_force_clear_offsets(InfraredBruteForce* brute_force) {
+    InfraredBruteForceRecordDict_it_t it;
+    for(InfraredBruteForceRecordDict_it(it, brute_force->records);
+        !InfraredBruteForceRecordDict_end_p(it);
+        InfraredBruteForceRecordDict_next(it)) {
+        InfraredBruteForceRecord* record = &InfraredBruteForceRecordDict_ref(it)->value;
+        free(record->offsets);
+        record->offsets = NULL;
+        record->count = 0;
+    }
+}
+
+/* Indexes are kept in cache directory, named by database path hash */
+static void
+    infrared_brute_force_get_index_path(InfraredBruteForce* brute_force, FuriString* path) {
+    furi_string_printf(
+        path,
+        INFRARED_BRUTE_FORCE_INDEX_PATH "/%08lX.idx",
+        crc32_calc_buffer(0, brute_force->db_filename, strlen(brute_force->db_filename)));
+}
+
+/* Database size and content hash: storage has no per-file modification time to rely on */
+static bool infrared_brute_force_get_db_info(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceIndexHeader* header) {
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    if(storage_file_open(file, brute_force->db_filename, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        header->magic = INFRARED_BRUTE_FORCE_INDEX_MAGIC;
+        header->version = INFRARED_BRUTE_FORCE_INDEX_VERSION;
+        header->db_size = storage_file_size(file);
+        header->db_crc = crc32_calc_file(file, NULL, NULL);
+        header->record_count = InfraredBruteForceRecordDict_size(brute_force->records);
+        success = true;
+    }
+
+    storage_file_free(file);
+    return success;
+}
+
+/* Index is valid only for the database it was built from and must cover all added records */
+static bool infrared_brute_force_load_index(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    const InfraredBruteForceIndexHeader* expected) {
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+    char name_buffer[UINT8_MAX + 1];
+    uint32_t loaded = 0;
+    bool success = false;
+
+    infrared_brute_force_get_index_path(brute_force, path);
+
+    do {
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        InfraredBruteForceIndexHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != expected->magic || header.version != expected->version ||
+           header.db_size != expected->db_size || header.db_crc != expected->db_crc)
+            break;
+
+        const uint64_t index_size = storage_file_size(file);
+        const uint32_t count_max = expected->db_size / INFRARED_BRUTE_FORCE_SIGNAL_SIZE_MIN;
+        bool is_corrupted = false;
+        for(uint32_t i = 0; i < header.record_count; i++) {
+            InfraredBruteForceIndexRecord index_record;
+            if(storage_file_read(file, &index_record, sizeof(index_record)) !=
+                   sizeof(index_record) ||
+               storage_file_read(file, name_buffer, index_record.name_length) !=
+                   index_record.name_length) {
+                is_corrupted = true;
+                break;
+            }
+            name_buffer[index_record.name_length] = '\0';
+            furi_string_set(name, name_buffer);
+
+            // Count comes from file: it must fit both the index and the database
+            const uint64_t index_left = index_size - storage_file_tell(file);
+            if(index_record.count > count_max ||
+               index_record.count > index_left / sizeof(uint32_t)) {
+                is_corrupted = true;
+                break;
+            }
+
+            const size_t offsets_size = index_record.count * sizeof(uint32_t);
+            InfraredBruteForceRecord* record =
+                InfraredBruteForceRecordDict_get(brute_force->records, name);
+            if(!record) {
+                if(!storage_file_seek(file, storage_file_tell(file) + offsets_size, true)) {
+                    is_corrupted = true;
+                    break;
+                }
+                continue;
+            }
+
+            // Duplicate name
+            if(record->offsets) {
+                is_corrupted = true;
+                break;
+            }
+
+            if(index_record.count) {
+                record->offsets = malloc(offsets_size);
+                if(storage_file_read(file, record->offsets, offsets_size) != offsets_size) {
+                    is_corrupted = true;
+                    break;
+                }
+                for(uint32_t j = 0; j < index_record.count; j++) {
+                    if(record->offsets[j] >= expected->db_size) {
+                        is_corrupted = true;
+                        break;
+                    }
+                }
+                if(is_corrupted) break;
+            }
+            record->count = index_record.count;
+            loaded++;
+        }
+
+        success = !is_corrupted && (loaded == expected->record_count);
+    } while(false);
+
+    if(!success) {
+        infrared_brute_force_clear_offsets(brute_force);
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_string_free(name);
+    furi_string_free(path);
+    return success;
+}
+
+static void infrared_brute_force_save_index(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    const InfraredBruteForceIndexHeader* header) {
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    bool success = false;
+
+    infrared_brute_force_get_index_path(brute_force, path);
+
+    do {
+        if(!storage_simply_mkdir(storage, STORAGE_CACHE_PATH_PREFIX)) break;
+        if(!storage_simply_mkdir(storage, INFRARED_BRUTE_FORCE_INDEX_PATH)) break;
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(storage_file_write(file, header, sizeof(InfraredBruteForceIndexHeader)) !=
+           sizeof(InfraredBruteForceIndexHeader))
+            break;
+
+        success = true;
+        InfraredBruteForceRecordDict_it_t it;
+        for(InfraredBruteForceRecordDict_it(it, brute_force->records);
+            !InfraredBruteForceRecordDict_end_p(it) && success;
+            InfraredBruteForceRecordDict_next(it)) {
+            const InfraredBruteForceRecordDict_itref_t* itref =
+                InfraredBruteForceRecordDict_cref(it);
+            const size_t name_length = furi_string_size(itref->key);
+            const size_t offsets_size = itref->value.count * sizeof(uint32_t);
+            InfraredBruteForceIndexRecord index_record = {
+                .name_length = name_length,
+                .count = itref->value.count,
+            };
+
+            success =
+                (name_length <= UINT8_MAX) &&
+                (storage_file_write(file, &index_record, sizeof(index_record)) ==
+                 sizeof(index_record)) &&
+                (storage_file_write(file, furi_string_get_cstr(itref->key), name_length) ==
+                 name_length) &&
+                (storage_file_write(file, itref->value.offsets, offsets_size) == offsets_size);
+        }
+    } while(false);
+
+    storage_file_close(file);
+    if(!success) {
+        FURI_LOG_W(TAG, "Failed to save index %s", furi_string_get_cstr(path));
+        storage_common_remove(storage, furi_string_get_cstr(path));
+    }
+
+    storage_file_free(file);
+    furi_string_free(path);
+}
+
+static bool infrared_brute_force_build_index(InfraredBruteForce* brute_force, Storage* storage) {
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    Stream* stream = flipper_format_get_raw_stream(ff);
+
+    bool success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
+    if(success) {
+        FuriString* signal_name;
+        signal_name = furi_string_alloc();
+        while(flipper_format_read_string(ff, "name", signal_name)) {
+            InfraredBruteForceRecord* record =
+                InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
+            if(record) { //-V547
+                // Grow by powers of two
+                if((record->count & (record->count - 1)) == 0) {
+                    const size_t capacity = record->count ? record->count * 2 : 1;
+                    record->offsets = realloc(record->offsets, capacity * sizeof(uint32_t));
+                }
+                record->offsets[record->count++] = stream_tell(stream);
+            }
+        }
+        furi_string_free(signal_name);
+    }
+
+    flipper_format_free(ff);
+    return success;
+}
+
 InfraredBruteForce* infrared_brute_force_alloc() {
     InfraredBruteForce* brute_force = malloc(sizeof(InfraredBruteForce));
     brute_force->ff = NULL;
     brute_force->db_filename = NULL;
     brute_force->current_signal = NULL;
+    brute_force->current_offsets = NULL;
     brute_force->is_started = false;
-    brute_force->current_record_name = furi_string_alloc();
     InfraredBruteForceRecordDict_init(brute_force->records);
     return brute_force;
 }
 
 void infrared_brute_force_free(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
+    infrared_brute_force_clear_offsets(brute_force);
     InfraredBruteForceRecordDict_clear(brute_force->records);
-    furi_string_free(brute_force->current_record_name);
     free(brute_force);
 }
 
@@ -56,23 +304,20 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
     bool success = false;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    infrared_brute_force_clear_offsets(brute_force);
 
-    success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
-    if(success) {
-        FuriString* signal_name;
-        signal_name = furi_string_alloc();
-        while(flipper_format_read_string(ff, "name", signal_name)) {
-            InfraredBruteForceRecord* record =
-                InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
-            if(record) { //-V547
-                ++(record->count);
+    InfraredBruteForceIndexHeader header;
+    if(infrared_brute_force_get_db_info(brute_force, storage, &header)) {
+        success = infrared_brute_force_load_index(brute_force, storage, &header);
+        if(!success) {
+            FURI_LOG_I(TAG, "Indexing %s", brute_force->db_filename);
+            success = infrared_brute_force_build_index(brute_force, storage);
+            if(success) {
+                infrared_brute_force_save_index(brute_force, storage, &header);
             }
         }
-        furi_string_free(signal_name);
     }
 
-    flipper_format_free(ff);
     furi_record_close(RECORD_STORAGE);
     return success;
 }
@@ -92,9 +337,9 @@ bool infrared_brute_force_start(
         const InfraredBruteForceRecordDict_itref_t* record = InfraredBruteForceRecordDict_cref(it);
         if(record->value.index == index) {
             *record_count = record->value.count;
-            if(*record_count) {
-                furi_string_set(brute_force->current_record_name, record->key);
-            }
+            brute_force->current_offsets = record->value.offsets;
+            brute_force->current_count = record->value.count;
+            brute_force->current_position = 0;
             break;
         }
     }
@@ -117,10 +362,10 @@ bool infrared_brute_force_is_started(InfraredBruteForce* brute_force) {
 
 void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
-    furi_string_reset(brute_force->current_record_name);
     infrared_signal_free(brute_force->current_signal);
     flipper_format_free(brute_force->ff);
     brute_force->current_signal = NULL;
+    brute_force->current_offsets = NULL;
     brute_force->ff = NULL;
     brute_force->is_started = false;
     furi_record_close(RECORD_STORAGE);
@@ -128,8 +373,13 @@ void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
 
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
-    const bool success = infrared_signal_search_and_read(
-        brute_force->current_signal, brute_force->ff, brute_force->current_record_name);
+    if(brute_force->current_position >= brute_force->current_count) return false;
+
+    // Jump straight to the signal body instead of searching for its name
+    const uint32_t offset = brute_force->current_offsets[brute_force->current_position++];
+    Stream* stream = flipper_format_get_raw_stream(brute_force->ff);
+    const bool success = stream_seek(stream, offset, StreamOffsetFromStart) &&
+                         infrared_signal_read_body(brute_force->current_signal, brute_force->ff);
     if(success) {
         infrared_signal_transmit(brute_force->current_signal);
     }
@@ -140,14 +390,17 @@ void infrared_brute_force_add_record(
     InfraredBruteForce* brute_force,
     uint32_t index,
     const char* name) {
-    InfraredBruteForceRecord value = {.index = index, .count = 0};
+    InfraredBruteForceRecord value = {.index = index, .count = 0, .offsets = NULL};
     FuriString* key;
     key = furi_string_alloc_set(name);
+    InfraredBruteForceRecord* record = InfraredBruteForceRecordDict_get(brute_force->records, key);
+    if(record) free(record->offsets);
     InfraredBruteForceRecordDict_set_at(brute_force->records, key, value);
     furi_string_free(key);
 }
 
 void infrared_brute_force_reset(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
+    infrared_brute_force_clear_offsets(brute_force);
     InfraredBruteForceRecordDict_reset(brute_force->records);
 }
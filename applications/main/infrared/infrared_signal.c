@@ -18,9 +18,10 @@ struct InfraredSignal {
 
 static void infrared_signal_clear_timings(InfraredSignal* signal) {
     if(signal->is_raw) {
-        free(signal->payload.raw.timings);
+        free(signal->payload.raw.packed);
         signal->payload.raw.timings_size = 0;
-        signal->payload.raw.timings = NULL;
+        signal->payload.raw.packed = NULL;
+        signal->payload.raw.packed_size = 0;
     }
 }
 
@@ -71,11 +72,12 @@ static bool infrared_signal_is_raw_valid(InfraredRawSignal* raw) {
         FURI_LOG_E(TAG, "Duty cycle is out of range (0 - 1): %f", (double)raw->duty_cycle);
         return false;
 
-    } else if((raw->timings_size <= 0) || (raw->timings_size > MAX_TIMINGS_AMOUNT)) {
+    } else if(
+        (raw->timings_size <= 0) || (raw->timings_size > INFRARED_SIGNAL_RAW_MAX_TIMINGS)) {
         FURI_LOG_E(
             TAG,
             "Timings amount is out of range (0 - %X): %zX",
-            MAX_TIMINGS_AMOUNT,
+            INFRARED_SIGNAL_RAW_MAX_TIMINGS,
             raw->timings_size);
         return false;
     }
@@ -91,12 +93,22 @@ static inline bool infrared_signal_save_message(InfraredMessage* message, Flippe
            flipper_format_write_hex(ff, "command", (uint8_t*)&message->command, 4);
 }
 
+/* Packing is in-memory only, files keep plain timings readable by other tools */
 static inline bool infrared_signal_save_raw(InfraredRawSignal* raw, FlipperFormat* ff) {
-    furi_assert(raw->timings_size <= MAX_TIMINGS_AMOUNT);
-    return flipper_format_write_string_cstr(ff, "type", "raw") &&
-           flipper_format_write_uint32(ff, "frequency", &raw->frequency, 1) &&
-           flipper_format_write_float(ff, "duty_cycle", &raw->duty_cycle, 1) &&
-           flipper_format_write_uint32(ff, "data", raw->timings, raw->timings_size);
+    uint32_t* timings = malloc(sizeof(uint32_t) * raw->timings_size);
+    InfraredRawUnpacker unpacker;
+    infrared_raw_unpacker_init(&unpacker, raw->packed, raw->packed_size);
+    for(size_t i = 0; i < raw->timings_size; ++i) {
+        furi_check(infrared_raw_unpacker_next(&unpacker, &timings[i]));
+    }
+
+    bool success = flipper_format_write_string_cstr(ff, "type", "raw") &&
+                   flipper_format_write_uint32(ff, "frequency", &raw->frequency, 1) &&
+                   flipper_format_write_float(ff, "duty_cycle", &raw->duty_cycle, 1) &&
+                   flipper_format_write_uint32(ff, "data", timings, raw->timings_size);
+
+    free(timings);
+    return success;
 }
 
 static inline bool infrared_signal_read_message(InfraredSignal* signal, FlipperFormat* ff) {
@@ -131,7 +143,7 @@ static inline bool infrared_signal_read_raw(InfraredSignal* signal, FlipperForma
                    flipper_format_read_float(ff, "duty_cycle", &duty_cycle, 1) &&
                    flipper_format_get_value_count(ff, "data", &timings_size);
 
-    if(!success || timings_size > MAX_TIMINGS_AMOUNT) {
+    if(!success || timings_size > INFRARED_SIGNAL_RAW_MAX_TIMINGS) {
         return false;
     }
 
@@ -146,7 +158,27 @@ static inline bool infrared_signal_read_raw(InfraredSignal* signal, FlipperForma
     return success;
 }
 
-static bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff) {
+static void infrared_signal_set_raw_packed(
+    InfraredSignal* signal,
+    const uint8_t* packed,
+    size_t packed_size,
+    size_t timings_size,
+    uint32_t frequency,
+    float duty_cycle) {
+    infrared_signal_clear_timings(signal);
+
+    signal->is_raw = true;
+
+    signal->payload.raw.timings_size = timings_size;
+    signal->payload.raw.frequency = frequency;
+    signal->payload.raw.duty_cycle = duty_cycle;
+
+    signal->payload.raw.packed_size = packed_size;
+    signal->payload.raw.packed = malloc(packed_size);
+    memcpy(signal->payload.raw.packed, packed, packed_size);
+}
+
+bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff) {
     FuriString* tmp = furi_string_alloc();
 
     bool success = false;
@@ -192,8 +224,13 @@ bool infrared_signal_is_valid(InfraredSignal* signal) {
 void infrared_signal_set_signal(InfraredSignal* signal, const InfraredSignal* other) {
     if(other->is_raw) {
         const InfraredRawSignal* raw = &other->payload.raw;
-        infrared_signal_set_raw_signal(
-            signal, raw->timings, raw->timings_size, raw->frequency, raw->duty_cycle);
+        infrared_signal_set_raw_packed(
+            signal,
+            raw->packed,
+            raw->packed_size,
+            raw->timings_size,
+            raw->frequency,
+            raw->duty_cycle);
     } else {
         const InfraredMessage* message = &other->payload.message;
         infrared_signal_set_message(signal, message);
@@ -219,7 +256,7 @@ void infrared_signal_set_raw_signal(
         duty_cycle = (float)0.33;
     }
     // In case of timings out of bounds we just call return
-    if((timings_size <= 0) || (timings_size > MAX_TIMINGS_AMOUNT)) {
+    if((timings_size <= 0) || (timings_size > INFRARED_SIGNAL_RAW_MAX_TIMINGS)) {
         return;
     }
 
@@ -229,8 +266,10 @@ void infrared_signal_set_raw_signal(
     signal->payload.raw.frequency = frequency;
     signal->payload.raw.duty_cycle = duty_cycle;
 
-    signal->payload.raw.timings = malloc(timings_size * sizeof(uint32_t));
-    memcpy(signal->payload.raw.timings, timings, timings_size * sizeof(uint32_t));
+    // Keep timings packed, repeated frames of long captures take no extra memory
+    signal->payload.raw.packed_size = infrared_raw_pack(timings, timings_size, NULL);
+    signal->payload.raw.packed = malloc(signal->payload.raw.packed_size);
+    infrared_raw_pack(timings, timings_size, signal->payload.raw.packed);
 }
 
 InfraredRawSignal* infrared_signal_get_raw_signal(InfraredSignal* signal) {
@@ -302,10 +341,9 @@ bool infrared_signal_search_and_read(
 void infrared_signal_transmit(InfraredSignal* signal) {
     if(signal->is_raw) {
         InfraredRawSignal* raw_signal = &signal->payload.raw;
-        infrared_send_raw_ext(
-            raw_signal->timings,
-            raw_signal->timings_size,
-            true,
+        infrared_send_raw_packed_ext(
+            raw_signal->packed,
+            raw_signal->packed_size,
             raw_signal->frequency,
             raw_signal->duty_cycle);
     } else {
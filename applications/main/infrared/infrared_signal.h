@@ -5,13 +5,18 @@
 #include <stdbool.h>
 
 #include <infrared.h>
+#include <infrared_raw_pack.h>
 #include <flipper_format/flipper_format.h>
 
 typedef struct InfraredSignal InfraredSignal;
 
+/** Longest raw signal, files keep plain timings and need a temporary array of this size */
+#define INFRARED_SIGNAL_RAW_MAX_TIMINGS (4 * 1024U)
+
 typedef struct {
     size_t timings_size;
-    uint32_t* timings;
+    uint8_t* packed; /**< timings in infrared_raw_pack.h format */
+    size_t packed_size;
     uint32_t frequency;
     float duty_cycle;
 } InfraredRawSignal;
@@ -37,6 +42,7 @@ InfraredMessage* infrared_signal_get_message(InfraredSignal* signal);
 
 bool infrared_signal_save(InfraredSignal* signal, FlipperFormat* ff, const char* name);
 bool infrared_signal_read(InfraredSignal* signal, FlipperFormat* ff, FuriString* name);
+bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff);
 bool infrared_signal_search_and_read(
     InfraredSignal* signal,
     FlipperFormat* ff,
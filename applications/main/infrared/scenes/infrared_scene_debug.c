@@ -27,8 +27,11 @@ bool infrared_scene_debug_on_event(void* context, SceneManagerEvent event) {
                 infrared_debug_view_set_text(debug_view, "RAW\n%d samples\n", raw->timings_size);
 
                 printf("RAW, %zu samples:\r\n", raw->timings_size);
-                for(size_t i = 0; i < raw->timings_size; ++i) {
-                    printf("%lu ", raw->timings[i]);
+                InfraredRawUnpacker unpacker;
+                infrared_raw_unpacker_init(&unpacker, raw->packed, raw->packed_size);
+                uint32_t timing;
+                while(infrared_raw_unpacker_next(&unpacker, &timing)) {
+                    printf("%lu ", timing);
                 }
                 printf("\r\n");
 
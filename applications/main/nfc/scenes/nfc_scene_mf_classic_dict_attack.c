@@ -41,6 +41,7 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(Nfc* nfc, DictAttackSt
 
     // Identify scene state
     if(state == DictAttackStateIdle) {
+        dict_attack_data->ranked_keys_tried = false;
         if(mf_classic_dict_check_presence(MfClassicDictTypeUser)) {
             state = DictAttackStateUserDictInProgress;
         } else {
@@ -140,11 +141,13 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
             consumed = true;
         } else if(event.event == NfcWorkerEventNewSector) {
             nfc_scene_mf_classic_dict_attack_update_view(nfc);
-            dict_attack_inc_current_sector(nfc->dict_attack);
             consumed = true;
         } else if(event.event == NfcWorkerEventNewDictKeyBatch) {
             nfc_scene_mf_classic_dict_attack_update_view(nfc);
             dict_attack_inc_current_dict_key(nfc->dict_attack, NFC_DICT_KEY_BATCH_SIZE);
+            dict_attack_set_keys_per_second(
+                nfc->dict_attack,
+                nfc->dev->dev_data.mf_classic_dict_attack_data.keys_per_second);
             consumed = true;
         } else if(event.event == NfcCustomEventDictAttackSkip) {
             if(state == DictAttackStateUserDictInProgress) {
@@ -25,6 +25,7 @@ typedef struct {
     uint8_t keys_found;
     uint16_t dict_keys_total;
     uint16_t dict_keys_current;
+    uint16_t keys_per_second;
     bool is_key_attack;
     uint8_t key_attack_current_sector;
 } DictAttackViewModel;
@@ -49,7 +50,7 @@ static void dict_attack_draw_callback(Canvas* canvas, void* model) {
                 "Reuse key check for sector: %d",
                 m->key_attack_current_sector);
         } else {
-            snprintf(draw_str, sizeof(draw_str), "Unlocking sector: %d", m->sector_current);
+            snprintf(draw_str, sizeof(draw_str), "Checking keys: %d/s", m->keys_per_second);
         }
         canvas_draw_str_aligned(canvas, 0, 10, AlignLeft, AlignTop, draw_str);
         float dict_progress = m->dict_keys_total == 0 ?
@@ -132,6 +133,7 @@ void dict_attack_reset(DictAttack* dict_attack) {
             model->keys_found = 0;
             model->dict_keys_total = 0;
             model->dict_keys_current = 0;
+            model->keys_per_second = 0;
             model->is_key_attack = false;
             furi_string_reset(model->header);
         },
@@ -263,6 +265,15 @@ void dict_attack_inc_current_dict_key(DictAttack* dict_attack, uint16_t keys_tri
         true);
 }
 
+void dict_attack_set_keys_per_second(DictAttack* dict_attack, uint16_t keys_per_second) {
+    furi_assert(dict_attack);
+    with_view_model(
+        dict_attack->view,
+        DictAttackViewModel * model,
+        { model->keys_per_second = keys_per_second; },
+        true);
+}
+
 void dict_attack_set_key_attack(DictAttack* dict_attack, bool is_key_attack, uint8_t sector) {
     furi_assert(dict_attack);
     with_view_model(
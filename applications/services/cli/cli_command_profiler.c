@@ -0,0 +1,325 @@
+#include "cli_command_profiler.h"
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <lib/toolbox/args.h>
+#include <lib/toolbox/profiler_probe.h>
+
+#define PROFILER_RING_SIZE 512
+#define PROFILER_CHUNK_SIZE 64
+#define PROFILER_THREADS_MAX 48
+#define PROFILER_HOTSPOTS_MAX 64
+#define PROFILER_DRAIN_PERIOD_MS 100
+
+#define TOP_INTERVAL_DEFAULT_MS 1000
+#define TOP_HOTSPOTS_SHOWN 10
+
+typedef struct {
+    uint32_t thread;
+    uint32_t count;
+    char name[configMAX_TASK_NAME_LEN];
+} CliProfilerThread;
+
+typedef struct {
+    uint32_t pc;
+    uint32_t count;
+} CliProfilerHotspot;
+
+typedef struct {
+    FuriHalProfilerSample ring[PROFILER_RING_SIZE];
+    FuriHalProfilerSample chunk[PROFILER_CHUNK_SIZE];
+    CliProfilerThread threads[PROFILER_THREADS_MAX];
+    size_t threads_count;
+    CliProfilerHotspot hotspots[PROFILER_HOTSPOTS_MAX];
+    size_t hotspots_count;
+    uint32_t hotspots_other;
+} CliProfiler;
+
+static bool cli_profiler_start(CliProfiler* profiler) {
+    if(furi_hal_profiler_is_running()) {
+        printf("Profiler is already running\r\n");
+        return false;
+    }
+
+    furi_hal_profiler_start(profiler->ring, COUNT_OF(profiler->ring));
+    return true;
+}
+
+static void cli_profiler_reset(CliProfiler* profiler) {
+    profiler->threads_count = 0;
+    profiler->hotspots_count = 0;
+    profiler->hotspots_other = 0;
+}
+
+static void cli_profiler_get_thread_name(uint32_t thread, char* name, size_t size) {
+    if(!thread) {
+        strlcpy(name, "Interrupts", size);
+        return;
+    }
+
+    // Samples may outlive their thread, never touch a deleted one
+    const uint8_t threads_num_max = 32;
+    FuriThreadId threads_ids[threads_num_max];
+    uint8_t thread_num = furi_thread_enumerate(threads_ids, threads_num_max);
+    for(uint8_t i = 0; i < thread_num; i++) {
+        if((uint32_t)threads_ids[i] == thread) {
+            strlcpy(name, furi_thread_get_name(threads_ids[i]), size);
+            return;
+        }
+    }
+    strlcpy(name, "?", size);
+}
+
+static void cli_profiler_add_thread(CliProfiler* profiler, uint32_t thread) {
+    for(size_t i = 0; i < profiler->threads_count; i++) {
+        if(profiler->threads[i].thread == thread) {
+            profiler->threads[i].count++;
+            return;
+        }
+    }
+
+    if(profiler->threads_count < PROFILER_THREADS_MAX) {
+        CliProfilerThread* entry = &profiler->threads[profiler->threads_count++];
+        entry->thread = thread;
+        entry->count = 1;
+        cli_profiler_get_thread_name(thread, entry->name, sizeof(entry->name));
+    }
+}
+
+static void cli_profiler_add_hotspot(CliProfiler* profiler, uint32_t pc) {
+    for(size_t i = 0; i < profiler->hotspots_count; i++) {
+        if(profiler->hotspots[i].pc == pc) {
+            profiler->hotspots[i].count++;
+            return;
+        }
+    }
+
+    if(profiler->hotspots_count < PROFILER_HOTSPOTS_MAX) {
+        CliProfilerHotspot* entry = &profiler->hotspots[profiler->hotspots_count++];
+        entry->pc = pc;
+        entry->count = 1;
+    } else {
+        profiler->hotspots_other++;
+    }
+}
+
+/* Aggregate everything sampled so far, optionally forwarding raw samples */
+static size_t cli_profiler_drain(CliProfiler* profiler, Cli* cli) {
+    size_t total = 0;
+    size_t count;
+
+    while((count = furi_hal_profiler_read(profiler->chunk, COUNT_OF(profiler->chunk))) > 0) {
+        for(size_t i = 0; i < count; i++) {
+            cli_profiler_add_thread(profiler, profiler->chunk[i].thread);
+            cli_profiler_add_hotspot(profiler, profiler->chunk[i].pc);
+        }
+
+        if(cli) {
+            uint16_t chunk_size = count;
+            cli_write(cli, (uint8_t*)&chunk_size, sizeof(chunk_size));
+            cli_write(cli, (uint8_t*)profiler->chunk, count * sizeof(FuriHalProfilerSample));
+        }
+
+        total += count;
+    }
+
+    return total;
+}
+
+static uint32_t cli_profiler_permille(uint32_t count, uint32_t total) {
+    return total ? (uint64_t)count * 1000 / total : 0;
+}
+
+static int cli_profiler_thread_cmp(const void* a, const void* b) {
+    const CliProfilerThread* thread_a = a;
+    const CliProfilerThread* thread_b = b;
+    return (thread_a->count < thread_b->count) - (thread_a->count > thread_b->count);
+}
+
+static int cli_profiler_hotspot_cmp(const void* a, const void* b) {
+    const CliProfilerHotspot* hotspot_a = a;
+    const CliProfilerHotspot* hotspot_b = b;
+    return (hotspot_a->count < hotspot_b->count) - (hotspot_a->count > hotspot_b->count);
+}
+
+static void cli_command_top_print(
+    CliProfiler* profiler,
+    uint32_t samples,
+    uint32_t sleep_ticks,
+    uint32_t dropped) {
+    // Dropped samples are ticks too, they are just not attributed
+    uint32_t total = samples + sleep_ticks + dropped;
+    uint32_t sleep = cli_profiler_permille(sleep_ticks, total);
+
+    printf("\e[2J\e[H");
+    printf(
+        "Ticks: %lu, sleep: %lu.%lu%%, dropped: %lu\r\n",
+        total,
+        sleep / 10,
+        sleep % 10,
+        dropped);
+    printf("Sampled on OS tick, work in phase with it is biased\r\n\r\n");
+
+    qsort(
+        profiler->threads,
+        profiler->threads_count,
+        sizeof(CliProfilerThread),
+        cli_profiler_thread_cmp);
+    printf("%-12s %-32s %s\r\n", "Thread", "Name", "CPU");
+    for(size_t i = 0; i < profiler->threads_count; i++) {
+        CliProfilerThread* thread = &profiler->threads[i];
+        uint32_t cpu = cli_profiler_permille(thread->count, total);
+        printf(
+            "0x%08lx   %-32s %3lu.%lu%%\r\n", thread->thread, thread->name, cpu / 10, cpu % 10);
+    }
+
+    qsort(
+        profiler->hotspots,
+        profiler->hotspots_count,
+        sizeof(CliProfilerHotspot),
+        cli_profiler_hotspot_cmp);
+    printf("\r\n%-12s %s\r\n", "Address", "CPU");
+    for(size_t i = 0; i < MIN(profiler->hotspots_count, (size_t)TOP_HOTSPOTS_SHOWN); i++) {
+        CliProfilerHotspot* hotspot = &profiler->hotspots[i];
+        uint32_t cpu = cli_profiler_permille(hotspot->count, total);
+        printf("0x%08lx   %3lu.%lu%%\r\n", hotspot->pc, cpu / 10, cpu % 10);
+    }
+    if(profiler->hotspots_other) {
+        uint32_t cpu = cli_profiler_permille(profiler->hotspots_other, total);
+        printf("%-12s %3lu.%lu%%\r\n", "Other", cpu / 10, cpu % 10);
+    }
+}
+
+void cli_command_top(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+
+    int interval = TOP_INTERVAL_DEFAULT_MS;
+    if(furi_string_size(args) &&
+       (!args_read_int_and_trim(args, &interval) || interval < PROFILER_DRAIN_PERIOD_MS)) {
+        cli_print_usage("top", "[interval_ms]", furi_string_get_cstr(args));
+        return;
+    }
+
+    CliProfiler* profiler = malloc(sizeof(CliProfiler));
+
+    if(cli_profiler_start(profiler)) {
+        FuriHalProfilerStats last_stats = {0};
+        uint32_t samples = 0;
+        uint32_t last_print = furi_get_tick();
+
+        while(!cli_cmd_interrupt_received(cli)) {
+            furi_delay_ms(PROFILER_DRAIN_PERIOD_MS);
+            samples += cli_profiler_drain(profiler, NULL);
+
+            if(furi_get_tick() - last_print < furi_ms_to_ticks(interval)) continue;
+            last_print = furi_get_tick();
+
+            FuriHalProfilerStats stats;
+            furi_hal_profiler_get_stats(&stats);
+            cli_command_top_print(
+                profiler,
+                samples,
+                stats.sleep_ticks - last_stats.sleep_ticks,
+                stats.dropped - last_stats.dropped);
+
+            last_stats = stats;
+            samples = 0;
+            cli_profiler_reset(profiler);
+        }
+
+        furi_hal_profiler_stop();
+    }
+
+    free(profiler);
+}
+
+/* Raw samples go as chunks of uint16_t count and FuriHalProfilerSample array,
+ * a zero count ends them. Summary and thread names follow as text. */
+static void cli_command_profiler_record(Cli* cli, FuriString* args) {
+    int duration = 0;
+    if(!args_read_int_and_trim(args, &duration) || duration <= 0) {
+        cli_print_usage("profiler record", "<duration_ms>", furi_string_get_cstr(args));
+        return;
+    }
+
+    CliProfiler* profiler = malloc(sizeof(CliProfiler));
+
+    if(cli_profiler_start(profiler)) {
+        printf("Ready\r\n");
+        fflush(stdout);
+
+        uint32_t start = furi_get_tick();
+        while(furi_get_tick() - start < furi_ms_to_ticks(duration) &&
+              !cli_cmd_interrupt_received(cli)) {
+            furi_delay_ms(PROFILER_DRAIN_PERIOD_MS);
+            cli_profiler_drain(profiler, cli);
+        }
+
+        cli_profiler_drain(profiler, cli);
+        FuriHalProfilerStats stats;
+        furi_hal_profiler_get_stats(&stats);
+        furi_hal_profiler_stop();
+
+        uint16_t end = 0;
+        cli_write(cli, (uint8_t*)&end, sizeof(end));
+
+        printf("Samples: %lu\r\n", stats.samples);
+        printf("Dropped: %lu\r\n", stats.dropped);
+        printf("Sleep ticks: %lu\r\n", stats.sleep_ticks);
+        printf("Tick frequency: %lu\r\n", furi_kernel_get_tick_frequency());
+        for(size_t i = 0; i < profiler->threads_count; i++) {
+            printf(
+                "Thread 0x%08lx %s\r\n", profiler->threads[i].thread, profiler->threads[i].name);
+        }
+    }
+
+    free(profiler);
+}
+
+static void cli_command_profiler_probes(FuriString* args) {
+    if(!furi_string_size(args)) {
+        profiler_probe_dump();
+    } else if(!furi_string_cmp(args, "reset")) {
+        profiler_probe_reset_all();
+        printf("Probes reset\r\n");
+    } else {
+        cli_print_usage("profiler probes", "[reset]", furi_string_get_cstr(args));
+    }
+}
+
+void cli_command_profiler_print_usage() {
+    printf("Usage:\r\n");
+    printf("profiler <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+
+    printf("\trecord <duration_ms>\t - Stream binary samples, use scripts/profiler.py\r\n");
+    printf("\tprobes [reset]\t - Show or reset probe statistics\r\n");
+    printf("Samples are taken on OS tick, work in phase with it is biased\r\n");
+}
+
+void cli_command_profiler(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+    FuriString* cmd;
+    cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_command_profiler_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "record") == 0) {
+            cli_command_profiler_record(cli, args);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "probes") == 0) {
+            cli_command_profiler_probes(args);
+            break;
+        }
+
+        cli_command_profiler_print_usage();
+    } while(false);
+
+    furi_string_free(cmd);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "cli_i.h"
+
+void cli_command_top(Cli* cli, FuriString* args, void* context);
+
+void cli_command_profiler(Cli* cli, FuriString* args, void* context);
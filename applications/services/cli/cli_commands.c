@@ -1,5 +1,7 @@
 #include "cli_commands.h"
 #include "cli_command_gpio.h"
+#include "cli_command_profiler.h"
+#include "cli_vcp.h"
 
 #include <furi_hal.h>
 #include <furi_hal_info.h>
@@ -315,6 +317,101 @@ void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
     furi_string_free(cmd);
 }
 
+#define CLI_COMMAND_VCP_LOOPBACK_CHUNK 512
+#define CLI_COMMAND_VCP_LOOPBACK_TIMEOUT 1000
+
+static uint32_t cli_command_vcp_rate(uint32_t bytes, uint32_t ms) {
+    return ms ? (uint64_t)bytes * 1000 / ms : 0;
+}
+
+void cli_command_vcp_stats(void) {
+    CliVcpStats stats;
+    cli_vcp_get_stats(&stats);
+    uint32_t ms = (uint64_t)stats.time * 1000 / furi_kernel_get_tick_frequency();
+
+    printf("Time: %lu ms\r\n", ms);
+    printf(
+        "Rx: %lu bytes, %lu packets, %lu stalls, %lu B/s\r\n",
+        stats.rx_bytes,
+        stats.rx_packets,
+        stats.rx_stalls,
+        cli_command_vcp_rate(stats.rx_bytes, ms));
+    printf(
+        "Tx: %lu bytes, %lu packets, %lu ZLPs, %lu stalls, %lu B/s\r\n",
+        stats.tx_bytes,
+        stats.tx_packets,
+        stats.tx_zlps,
+        stats.tx_stalls,
+        cli_command_vcp_rate(stats.tx_bytes, ms));
+}
+
+void cli_command_vcp_loopback(Cli* cli, FuriString* args) {
+    uint32_t size = 0;
+    if(sscanf(furi_string_get_cstr(args), "%lu", &size) != 1 || size == 0) {
+        cli_print_usage("vcp loopback", "<bytes>", furi_string_get_cstr(args));
+        return;
+    }
+
+    // Host starts sending after this line
+    printf("Ready\r\n");
+    fflush(stdout);
+
+    uint8_t* buffer = malloc(CLI_COMMAND_VCP_LOOPBACK_CHUNK);
+    while(size > 0) {
+        size_t len = cli_read_timeout(
+            cli,
+            buffer,
+            MIN(size, (uint32_t)CLI_COMMAND_VCP_LOOPBACK_CHUNK),
+            CLI_COMMAND_VCP_LOOPBACK_TIMEOUT);
+        if(len == 0) break;
+        cli_write(cli, buffer, len);
+        size -= len;
+    }
+    free(buffer);
+}
+
+void cli_command_vcp_print_usage() {
+    printf("Usage:\r\n");
+    printf("vcp <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+
+    printf("\tstats\t - Show USB CDC throughput counters\r\n");
+    printf("\treset\t - Reset USB CDC throughput counters\r\n");
+    printf("\tloopback <bytes>\t - Send received data back\r\n");
+}
+
+void cli_command_vcp(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+    FuriString* cmd;
+    cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_command_vcp_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "stats") == 0) {
+            cli_command_vcp_stats();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "reset") == 0) {
+            cli_vcp_reset_stats();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "loopback") == 0) {
+            cli_command_vcp_loopback(cli, args);
+            break;
+        }
+
+        cli_command_vcp_print_usage();
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
 void cli_command_vibro(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(context);
@@ -394,26 +491,48 @@ void cli_command_ps(Cli* cli, FuriString* args, void* context) {
     const uint8_t threads_num_max = 32;
     FuriThreadId threads_ids[threads_num_max];
     uint8_t thread_num = furi_thread_enumerate(threads_ids, threads_num_max);
+    // CPU usage is since boot, sleep doesn't count
+    uint64_t total_time = furi_hal_cortex_get_cycles();
+    uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
     printf(
-        "%-20s %-20s %-14s %-8s %-8s %s\r\n",
+        "%-20s %-20s %-14s %-8s %-8s %-14s %-6s %-8s %-8s %s\r\n",
         "AppID",
         "Name",
         "Stack start",
         "Heap",
         "Stack",
-        "Stack min free");
+        "Stack min free",
+        "CPU",
+        "Switches",
+        "Lat avg",
+        "Lat max");
     for(uint8_t i = 0; i < thread_num; i++) {
         TaskControlBlock* tcb = (TaskControlBlock*)threads_ids[i];
         printf(
-            "%-20s %-20s 0x%-12lx %-8zu %-8lu %-8lu\r\n",
+            "%-20s %-20s 0x%-12lx %-8zu %-8lu %-14lu ",
             furi_thread_get_appid(threads_ids[i]),
             furi_thread_get_name(threads_ids[i]),
             (uint32_t)tcb->pxStack,
             memmgr_heap_get_thread_memory(threads_ids[i]),
             (uint32_t)(tcb->pxEndOfStack - tcb->pxStack + 1) * sizeof(StackType_t),
             furi_thread_get_stack_space(threads_ids[i]));
+
+        FuriThreadStats stats;
+        bool has_stats = furi_thread_get_stats(threads_ids[i], &stats);
+        uint32_t cpu = total_time ? stats.run_time * 1000 / total_time : 0;
+        printf("%3lu.%lu%% ", cpu / 10, cpu % 10);
+        if(has_stats) {
+            uint32_t latency_avg = stats.wakeups ? stats.latency_total / stats.wakeups : 0;
+            printf(
+                "%-8lu %-8lu %lu\r\n",
+                stats.switches,
+                latency_avg / cycles_per_us,
+                stats.latency_max / cycles_per_us);
+        } else {
+            printf("%-8s %-8s %s\r\n", "-", "-", "-");
+        }
     }
-    printf("\r\nTotal: %d", thread_num);
+    printf("\r\nTotal: %d, latency in us", thread_num);
 }
 
 void cli_command_free(Cli* cli, FuriString* args, void* context) {
@@ -476,7 +595,10 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "log", CliCommandFlagParallelSafe, cli_command_log, NULL);
     cli_add_command(cli, "l", CliCommandFlagParallelSafe, cli_command_log, NULL);
     cli_add_command(cli, "sysctl", CliCommandFlagDefault, cli_command_sysctl, NULL);
+    cli_add_command(cli, "vcp", CliCommandFlagDefault, cli_command_vcp, NULL);
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
+    cli_add_command(cli, "top", CliCommandFlagDefault, cli_command_top, NULL);
+    cli_add_command(cli, "profiler", CliCommandFlagDefault, cli_command_profiler, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
 
@@ -2,12 +2,22 @@
 #include <furi_hal.h>
 #include <furi.h>
 #include "cli_i.h"
+#include "cli_vcp.h"
 
 #define TAG "CliVcp"
 
 #define USB_CDC_PKT_LEN CDC_DATA_SZ
-#define VCP_RX_BUF_SIZE (USB_CDC_PKT_LEN * 3)
-#define VCP_TX_BUF_SIZE (USB_CDC_PKT_LEN * 3)
+
+/* Ring sizes can be overridden at build time, writers block once they are full */
+#ifndef VCP_RX_BUF_SIZE
+#define VCP_RX_BUF_SIZE (USB_CDC_PKT_LEN * 32)
+#endif
+#ifndef VCP_TX_BUF_SIZE
+#define VCP_TX_BUF_SIZE (USB_CDC_PKT_LEN * 32)
+#endif
+
+/* Writer batch, leaves room for the worker to drain while the next batch is waiting */
+#define VCP_TX_BATCH_SIZE (VCP_TX_BUF_SIZE / 4)
 
 #define VCP_IF_NUM 0
 
@@ -42,6 +52,9 @@ typedef struct {
 
     FuriHalUsbInterface* usb_if_prev;
 
+    volatile uint32_t rx_events; /* packets received by the endpoint, not read yet */
+    CliVcpStats stats;
+
     uint8_t data_buffer[USB_CDC_PKT_LEN];
 } CliVcp;
 
@@ -69,6 +82,7 @@ static void cli_vcp_init() {
         vcp = malloc(sizeof(CliVcp));
         vcp->tx_stream = furi_stream_buffer_alloc(VCP_TX_BUF_SIZE, 1);
         vcp->rx_stream = furi_stream_buffer_alloc(VCP_RX_BUF_SIZE, 1);
+        vcp->stats.time = furi_get_tick();
     }
     furi_assert(vcp->thread == NULL);
 
@@ -80,6 +94,14 @@ static void cli_vcp_init() {
     FURI_LOG_I(TAG, "Init OK");
 }
 
+static void vcp_tx_stream_drop() {
+    // Frees the whole ring, so a writer blocked on it can notice the disconnect
+    size_t len;
+    do {
+        len = furi_stream_buffer_receive(vcp->tx_stream, vcp->data_buffer, USB_CDC_PKT_LEN, 0);
+    } while(len > 0);
+}
+
 static void cli_vcp_deinit() {
     furi_thread_flags_set(furi_thread_get_id(vcp->thread), VcpEvtStop);
     furi_thread_join(vcp->thread);
@@ -90,7 +112,7 @@ static void cli_vcp_deinit() {
 static int32_t vcp_worker(void* context) {
     UNUSED(context);
     bool tx_idle = true;
-    size_t missed_rx = 0;
+    uint32_t rx_pending = 0;
     uint8_t last_tx_pkt_len = 0;
 
     // Switch USB to VCP mode (if it is not set yet)
@@ -101,6 +123,7 @@ static int32_t vcp_worker(void* context) {
     furi_hal_cdc_set_callbacks(VCP_IF_NUM, &cdc_cb, NULL);
 
     FURI_LOG_D(TAG, "Start");
+    vcp->rx_events = 0;
     vcp->running = true;
 
     while(1) {
@@ -124,36 +147,44 @@ static int32_t vcp_worker(void* context) {
 
             if(vcp->connected == true) {
                 vcp->connected = false;
-                furi_stream_buffer_receive(vcp->tx_stream, vcp->data_buffer, USB_CDC_PKT_LEN, 0);
+                vcp_tx_stream_drop();
                 furi_stream_buffer_send(vcp->rx_stream, &ascii_eot, 1, FuriWaitForever);
             }
         }
 
         // Rx buffer was read, maybe there is enough space for new data?
-        if((flags & VcpEvtStreamRx) && (missed_rx > 0)) {
+        if((flags & VcpEvtStreamRx) && (rx_pending > 0)) {
             VCP_DEBUG("StreamRx");
-
-            if(furi_stream_buffer_spaces_available(vcp->rx_stream) >= USB_CDC_PKT_LEN) {
-                flags |= VcpEvtRx;
-                missed_rx--;
-            }
+            flags |= VcpEvtRx;
         }
 
-        // New data received
+        // New data received, flags don't count events, so packets are counted in ISR
         if(flags & VcpEvtRx) {
-            if(furi_stream_buffer_spaces_available(vcp->rx_stream) >= USB_CDC_PKT_LEN) {
+            FURI_CRITICAL_ENTER();
+            rx_pending += vcp->rx_events;
+            vcp->rx_events = 0;
+            FURI_CRITICAL_EXIT();
+
+            while(rx_pending > 0) {
+                if(furi_stream_buffer_spaces_available(vcp->rx_stream) < USB_CDC_PKT_LEN) {
+                    // Packet stays in endpoint, host gets NAKed until ring is read
+                    VCP_DEBUG("Rx missed");
+                    vcp->stats.rx_stalls++;
+                    break;
+                }
+
                 int32_t len = furi_hal_cdc_receive(VCP_IF_NUM, vcp->data_buffer, USB_CDC_PKT_LEN);
                 VCP_DEBUG("Rx %ld", len);
+                rx_pending--;
 
                 if(len > 0) {
                     furi_check(
                         furi_stream_buffer_send(
                             vcp->rx_stream, vcp->data_buffer, len, FuriWaitForever) ==
                         (size_t)len);
+                    vcp->stats.rx_bytes += len;
+                    vcp->stats.rx_packets++;
                 }
-            } else {
-                VCP_DEBUG("Rx missed");
-                missed_rx++;
             }
         }
 
@@ -177,10 +208,13 @@ static int32_t vcp_worker(void* context) {
                 tx_idle = false;
                 furi_hal_cdc_send(VCP_IF_NUM, vcp->data_buffer, len);
                 last_tx_pkt_len = len;
+                vcp->stats.tx_bytes += len;
+                vcp->stats.tx_packets++;
             } else { // There is nothing to send.
-                if(last_tx_pkt_len == 64) {
-                    // Send extra zero-length packet if last packet len is 64 to indicate transfer end
+                if(last_tx_pkt_len == USB_CDC_PKT_LEN) {
+                    // Full last packet doesn't end host transfer, send zero-length packet
                     furi_hal_cdc_send(VCP_IF_NUM, NULL, 0);
+                    vcp->stats.tx_zlps++;
                 } else {
                     // Set flag to start next transfer instantly
                     tx_idle = true;
@@ -198,7 +232,7 @@ static int32_t vcp_worker(void* context) {
                 furi_hal_usb_unlock();
                 furi_hal_usb_set_config(vcp->usb_if_prev, NULL);
             }
-            furi_stream_buffer_receive(vcp->tx_stream, vcp->data_buffer, USB_CDC_PKT_LEN, 0);
+            vcp_tx_stream_drop();
             furi_stream_buffer_send(vcp->rx_stream, &ascii_eot, 1, FuriWaitForever);
             break;
         }
@@ -254,8 +288,11 @@ static void cli_vcp_tx(const uint8_t* buffer, size_t size) {
 
     while(size > 0 && vcp->connected) {
         size_t batch_size = size;
-        if(batch_size > USB_CDC_PKT_LEN) batch_size = USB_CDC_PKT_LEN;
+        if(batch_size > VCP_TX_BATCH_SIZE) batch_size = VCP_TX_BATCH_SIZE;
 
+        if(furi_stream_buffer_spaces_available(vcp->tx_stream) < batch_size) {
+            vcp->stats.tx_stalls++;
+        }
         furi_stream_buffer_send(vcp->tx_stream, buffer, batch_size, FuriWaitForever);
         furi_thread_flags_set(furi_thread_get_id(vcp->thread), VcpEvtStreamTx);
         VCP_DEBUG("tx %u", batch_size);
@@ -292,6 +329,7 @@ static void vcp_on_cdc_control_line(void* context, uint8_t state) {
 
 static void vcp_on_cdc_rx(void* context) {
     UNUSED(context);
+    vcp->rx_events++;
     uint32_t ret = furi_thread_flags_set(furi_thread_get_id(vcp->thread), VcpEvtRx);
     furi_check(!(ret & FuriFlagError));
 }
@@ -306,6 +344,24 @@ static bool cli_vcp_is_connected(void) {
     return vcp->connected;
 }
 
+void cli_vcp_get_stats(CliVcpStats* stats) {
+    furi_assert(stats);
+
+    if(vcp == NULL) {
+        memset(stats, 0, sizeof(CliVcpStats));
+        return;
+    }
+    *stats = vcp->stats;
+    stats->time = furi_get_tick() - vcp->stats.time;
+}
+
+void cli_vcp_reset_stats() {
+    if(vcp == NULL) return;
+
+    memset(&vcp->stats, 0, sizeof(CliVcpStats));
+    vcp->stats.time = furi_get_tick();
+}
+
 CliSession cli_vcp = {
     cli_vcp_init,
     cli_vcp_deinit,
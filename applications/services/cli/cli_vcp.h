@@ -5,14 +5,36 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef struct CliSession CliSession;
 
+typedef struct {
+    uint32_t time; /**< ticks since the counters were reset */
+    uint32_t rx_bytes;
+    uint32_t rx_packets;
+    uint32_t rx_stalls; /**< times a packet waited for space in the ring */
+    uint32_t tx_bytes;
+    uint32_t tx_packets;
+    uint32_t tx_zlps; /**< zero-length packets ending transfers of full packets */
+    uint32_t tx_stalls; /**< times a writer waited for space in the ring */
+} CliVcpStats;
+
 extern CliSession cli_vcp;
 
+/** Get VCP throughput counters
+ *
+ * @param      stats  CliVcpStats to fill
+ */
+void cli_vcp_get_stats(CliVcpStats* stats);
+
+/** Reset VCP throughput counters */
+void cli_vcp_reset_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
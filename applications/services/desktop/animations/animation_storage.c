@@ -5,6 +5,7 @@
 #include <core/dangerous_defines.h>
 #include <storage/storage.h>
 #include <gui/icon_i.h>
+#include <gui/gui_i.h>
 #include <cfw.h>
 
 #include "animation_manager.h"
@@ -447,6 +448,9 @@ static void animation_storage_free_frames(BubbleAnimation* animation) {
     furi_assert(animation);
 
     const Icon* icon = &animation->icon_animation;
+    gui_remove_cached_icon(furi_record_open(RECORD_GUI), icon);
+    furi_record_close(RECORD_GUI);
+
     for(int i = 0; i < icon->frame_count; ++i) {
         if(icon->frames[i]) {
             free((void*)icon->frames[i]);
@@ -534,6 +538,9 @@ static bool animation_storage_load_frames(
         for(int i = 0; i < animation->icon_animation.frame_count; ++i) {
             furi_check(animation->icon_animation.frames[i]);
         }
+        // Frames are looped over and over, don't decode them on every draw
+        gui_add_cached_icon(furi_record_open(RECORD_GUI), &animation->icon_animation);
+        furi_record_close(RECORD_GUI);
     }
 
     storage_file_free(file);
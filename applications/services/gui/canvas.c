@@ -23,6 +23,7 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init() {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc();
+    canvas->icon_cache = icon_cache_alloc(ICON_CACHE_BUDGET);
 
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
@@ -41,6 +42,7 @@ Canvas* canvas_init() {
 
 void canvas_free(Canvas* canvas) {
     furi_assert(canvas);
+    icon_cache_free(canvas->icon_cache);
     compress_icon_free(canvas->compress_icon);
     free(canvas);
 }
@@ -247,6 +249,15 @@ uint8_t canvas_glyph_width(Canvas* canvas, char symbol) {
     return u8g2_GetGlyphWidth(&canvas->fb, symbol);
 }
 
+static const uint8_t* canvas_decode_icon(
+    Canvas* canvas,
+    const uint8_t* icon_data,
+    uint8_t width,
+    uint8_t height) {
+    size_t decoded_size = ((width + 7) / 8) * height;
+    return icon_cache_get(canvas->icon_cache, canvas->compress_icon, icon_data, decoded_size);
+}
+
 void canvas_draw_bitmap(
     Canvas* canvas,
     uint8_t x,
@@ -258,8 +269,8 @@ void canvas_draw_bitmap(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* bitmap_data = NULL;
-    compress_icon_decode(canvas->compress_icon, compressed_bitmap_data, &bitmap_data);
+    const uint8_t* bitmap_data =
+        canvas_decode_icon(canvas, compressed_bitmap_data, width, height);
     canvas_draw_u8g2_bitmap(&canvas->fb, x, y, width, height, bitmap_data, IconRotation0);
 }
 
@@ -273,17 +284,17 @@ void canvas_draw_icon_animation(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(
-        canvas->compress_icon, icon_animation_get_data(icon_animation), &icon_data);
-    canvas_draw_u8g2_bitmap(
-        &canvas->fb,
-        x,
-        y,
-        icon_animation_get_width(icon_animation),
-        icon_animation_get_height(icon_animation),
-        icon_data,
-        IconRotation0);
+    uint8_t width = icon_animation_get_width(icon_animation);
+    uint8_t height = icon_animation_get_height(icon_animation);
+    const uint8_t* icon_data =
+        canvas_decode_icon(canvas, icon_animation_get_data(icon_animation), width, height);
+    canvas_draw_u8g2_bitmap(&canvas->fb, x, y, width, height, icon_data, IconRotation0);
+
+    // Decode upcoming frame while GUI thread is idle
+    icon_cache_prefetch(
+        canvas->icon_cache,
+        icon_animation_get_next_data(icon_animation),
+        ((width + 7) / 8) * height);
 }
 
 static void canvas_draw_u8g2_bitmap_int(
@@ -359,6 +370,73 @@ static void canvas_draw_u8g2_bitmap_int(
     }
 }
 
+/* Write unrotated 1bpp bitmap straight into the page-organized framebuffer
+ * (vertical bytes, LSB on top), bypassing per-pixel u8g2_DrawHVLine calls.
+ * Returns false if bitmap can't be handled here. */
+static bool canvas_draw_u8g2_bitmap_fast(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t w,
+    u8g2_uint_t h,
+    const uint8_t* bitmap) {
+    if(u8g2->cb != U8G2_R0) return false;
+
+    uint16_t x_end = x + w;
+    uint16_t y_end = y + h;
+    // Wrapped coordinates are negative for u8g2, leave them to slow path
+    if(x_end > UINT8_MAX + 1 || y_end > UINT8_MAX + 1) return false;
+
+    uint16_t x0 = MAX(x, u8g2->clip_x0);
+    uint16_t x1 = MIN(x_end, u8g2->clip_x1);
+    uint16_t y0 = MAX(y, u8g2->clip_y0);
+    uint16_t y1 = MIN(y_end, u8g2->clip_y1);
+    x1 = MIN(x1, u8g2_GetBufferTileWidth(u8g2) * 8);
+    y1 = MIN(y1, u8g2_GetBufferTileHeight(u8g2) * 8);
+
+    uint8_t* buffer = u8g2_GetBufferPtr(u8g2);
+    const size_t stride = u8g2_GetBufferTileWidth(u8g2) * 8;
+    const size_t blen = (w + 7) >> 3;
+    const uint8_t color = u8g2->draw_color;
+    const uint8_t ncolor = (color == 0 ? 1 : 0);
+    const bool transparent = u8g2->bitmap_transparency;
+
+    for(uint16_t py = y0; py < y1; py++) {
+        const uint8_t* row = bitmap + (py - y) * blen;
+        uint8_t* page = buffer + (py >> 3) * stride;
+        const uint8_t mask = 1 << (py & 7);
+
+        for(uint16_t px = x0; px < x1; px++) {
+            uint16_t bx = px - x;
+            uint8_t src = row[bx >> 3];
+            if(transparent && !src) {
+                // Skip the rest of empty source byte
+                px += 7 - (bx & 7);
+                continue;
+            }
+
+            uint8_t pixel_color;
+            if(src & (1 << (bx & 7))) {
+                pixel_color = color;
+            } else if(!transparent) {
+                pixel_color = ncolor;
+            } else {
+                continue;
+            }
+
+            if(pixel_color == 0) {
+                page[px] &= ~mask;
+            } else if(pixel_color == 1) {
+                page[px] |= mask;
+            } else {
+                page[px] ^= mask;
+            }
+        }
+    }
+
+    return true;
+}
+
 void canvas_draw_u8g2_bitmap(
     u8g2_t* u8g2,
     u8g2_uint_t x,
@@ -377,7 +455,9 @@ void canvas_draw_u8g2_bitmap(
 
     switch(rotation) {
     case IconRotation0:
-        canvas_draw_u8g2_bitmap_int(u8g2, x, y, w, h, 0, 0, bitmap);
+        if(!canvas_draw_u8g2_bitmap_fast(u8g2, x, y, w, h, bitmap)) {
+            canvas_draw_u8g2_bitmap_int(u8g2, x, y, w, h, 0, 0, bitmap);
+        }
         break;
     case IconRotation90:
         canvas_draw_u8g2_bitmap_int(u8g2, x, y, w, h, 0, 1, bitmap);
@@ -404,8 +484,8 @@ void canvas_draw_icon_ex(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_data(icon), &icon_data);
+    const uint8_t* icon_data = canvas_decode_icon(
+        canvas, icon_get_data(icon), icon_get_width(icon), icon_get_height(icon));
     canvas_draw_u8g2_bitmap(
         &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data, rotation);
 }
@@ -416,8 +496,8 @@ void canvas_draw_icon(Canvas* canvas, uint8_t x, uint8_t y, const Icon* icon) {
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_data(icon), &icon_data);
+    const uint8_t* icon_data = canvas_decode_icon(
+        canvas, icon_get_data(icon), icon_get_width(icon), icon_get_height(icon));
     canvas_draw_u8g2_bitmap(
         &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data, IconRotation0);
 }
@@ -44,6 +44,10 @@ uint8_t gui_get_count_of_enabled_view_port_in_layer(Gui* gui, GuiLayer layer) {
 
 void gui_update(Gui* gui) {
     furi_assert(gui);
+    // Called from any thread and from interrupts
+    FURI_CRITICAL_ENTER();
+    gui->stats.update_requests++;
+    FURI_CRITICAL_EXIT();
     if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
 }
 
@@ -347,6 +351,7 @@ static void gui_redraw(Gui* gui) {
     do {
         if(gui->direct_draw) break;
 
+        uint32_t frame_start = DWT->CYCCNT;
         canvas_reset(gui->canvas);
 
         if(gui->lockdown) {
@@ -364,15 +369,31 @@ static void gui_redraw(Gui* gui) {
             }
         }
 
-        canvas_commit(gui->canvas);
-        for
-            M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
-                p->callback(
-                    canvas_get_buffer(gui->canvas),
-                    canvas_get_buffer_size(gui->canvas),
-                    canvas_get_orientation(gui->canvas),
-                    p->context);
-            }
+        uint8_t* buffer = canvas_get_buffer(gui->canvas);
+        size_t buffer_size = canvas_get_buffer_size(gui->canvas);
+        CanvasOrientation orientation = canvas_get_orientation(gui->canvas);
+        gui->stats.frames++;
+
+        // Display and framebuffer listeners already have this frame
+        if(!gui->force_commit && orientation == gui->last_orientation &&
+           memcmp(gui->last_frame, buffer, buffer_size) == 0) {
+            gui->stats.frames_unchanged++;
+        } else {
+            memcpy(gui->last_frame, buffer, buffer_size);
+            gui->last_orientation = orientation;
+            gui->force_commit = false;
+
+            canvas_commit(gui->canvas);
+            for
+                M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
+                    p->callback(buffer, buffer_size, orientation, p->context);
+                }
+        }
+
+        uint32_t frame_time_us =
+            (DWT->CYCCNT - frame_start) / furi_hal_cortex_instructions_per_microsecond();
+        gui->stats.frame_time_total_us += frame_time_us;
+        gui->stats.frame_time_max_us = MAX(gui->stats.frame_time_max_us, frame_time_us);
     } while(false);
 
     gui_unlock(gui);
@@ -597,6 +618,7 @@ void gui_add_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, vo
     gui_lock(gui);
     furi_assert(!CanvasCallbackPairArray_count(gui->canvas_callback_pair, p));
     CanvasCallbackPairArray_push_back(gui->canvas_callback_pair, p);
+    gui->force_commit = true;
     gui_unlock(gui);
 
     // Request redraw
@@ -665,11 +687,51 @@ void gui_direct_draw_release(Gui* gui) {
 
     gui_lock(gui);
     gui->direct_draw = false;
+    gui->force_commit = true;
     gui_unlock(gui);
 
     gui_update(gui);
 }
 
+void gui_set_max_fps(Gui* gui, uint32_t max_fps) {
+    furi_assert(gui);
+    gui_lock(gui);
+    gui->frame_interval = max_fps ? (furi_kernel_get_tick_frequency() / max_fps) : 0;
+    gui_unlock(gui);
+}
+
+void gui_get_redraw_stats(Gui* gui, GuiRedrawStats* stats) {
+    furi_assert(gui);
+    furi_assert(stats);
+    gui_lock(gui);
+    FURI_CRITICAL_ENTER();
+    *stats = gui->stats;
+    FURI_CRITICAL_EXIT();
+    gui_unlock(gui);
+}
+
+void gui_reset_redraw_stats(Gui* gui) {
+    furi_assert(gui);
+    gui_lock(gui);
+    FURI_CRITICAL_ENTER();
+    memset(&gui->stats, 0, sizeof(GuiRedrawStats));
+    FURI_CRITICAL_EXIT();
+    gui_unlock(gui);
+}
+
+void gui_add_cached_icon(Gui* gui, const Icon* icon) {
+    furi_assert(gui);
+    icon_cache_add_icon(gui->canvas->icon_cache, icon);
+}
+
+void gui_remove_cached_icon(Gui* gui, const Icon* icon) {
+    furi_assert(gui);
+    // No frame of the icon is drawn while cache drops it
+    gui_lock(gui);
+    icon_cache_remove_icon(gui->canvas->icon_cache, icon);
+    gui_unlock(gui);
+}
+
 Gui* gui_alloc() {
     Gui* gui = malloc(sizeof(Gui));
     // Thread ID
@@ -684,6 +746,9 @@ Gui* gui_alloc() {
     // Drawing canvas
     gui->canvas = canvas_init();
     CanvasCallbackPairArray_init(gui->canvas_callback_pair);
+    gui->last_frame = malloc(canvas_get_buffer_size(gui->canvas));
+    gui->force_commit = true;
+    gui->frame_interval = furi_kernel_get_tick_frequency() / GUI_MAX_FPS_DEFAULT;
 
     // Input
     gui->input_queue = furi_message_queue_alloc(8, sizeof(InputEvent));
@@ -707,9 +772,11 @@ int32_t gui_srv(void* p) {
 
     furi_record_create(RECORD_GUI, gui);
 
+    uint32_t timeout = FuriWaitForever;
     while(1) {
-        uint32_t flags =
-            furi_thread_flags_wait(GUI_THREAD_FLAG_ALL, FuriFlagWaitAny, FuriWaitForever);
+        uint32_t flags = furi_thread_flags_wait(GUI_THREAD_FLAG_ALL, FuriFlagWaitAny, timeout);
+        // Timeout means pending frame is due
+        if(flags & FuriFlagError) flags = 0;
         // Process and dispatch input
         if(flags & GUI_THREAD_FLAG_INPUT) {
             // Process till queue become empty
@@ -722,7 +789,19 @@ int32_t gui_srv(void* p) {
         if(flags & GUI_THREAD_FLAG_DRAW) {
             // Clear flags that arrived on input step
             furi_thread_flags_clear(GUI_THREAD_FLAG_DRAW);
-            gui_redraw(gui);
+            gui->redraw_pending = true;
+        }
+        // Coalesce requests until frame interval since last frame passes
+        timeout = FuriWaitForever;
+        if(gui->redraw_pending) {
+            uint32_t elapsed = furi_get_tick() - gui->last_frame_tick;
+            if(elapsed >= gui->frame_interval) {
+                gui->redraw_pending = false;
+                gui->last_frame_tick = furi_get_tick();
+                gui_redraw(gui);
+            } else {
+                timeout = gui->frame_interval - elapsed;
+            }
         }
     }
 
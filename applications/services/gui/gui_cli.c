@@ -0,0 +1,85 @@
+#include "gui_cli.h"
+#include "gui_i.h"
+
+#include <furi.h>
+#include <cli/cli.h>
+#include <lib/toolbox/args.h>
+
+static void gui_cli_command_print_usage() {
+    printf("Usage:\r\n");
+    printf("gui <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+    printf("\tstats\t - show redraw statistics\r\n");
+    printf("\tstats_reset\t - reset redraw statistics\r\n");
+    printf("\tfps <max_fps>\t - limit frame rate, 0 for no limit\r\n");
+}
+
+static void gui_cli_stats(Gui* gui) {
+    GuiRedrawStats stats;
+    gui_get_redraw_stats(gui, &stats);
+
+    printf("Update requests: %lu\r\n", stats.update_requests);
+    printf("Frames rendered: %lu\r\n", stats.frames);
+    printf("Frames unchanged: %lu\r\n", stats.frames_unchanged);
+    printf(
+        "Frame time avg: %luus\r\n",
+        stats.frames ? stats.frame_time_total_us / stats.frames : 0);
+    printf("Frame time max: %luus\r\n", stats.frame_time_max_us);
+}
+
+static void gui_cli_fps(Gui* gui, FuriString* args) {
+    int max_fps = 0;
+    if(!args_read_int_and_trim(args, &max_fps) || max_fps < 0) {
+        gui_cli_command_print_usage();
+        return;
+    }
+
+    gui_set_max_fps(gui, max_fps);
+}
+
+static void gui_cli(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    FuriString* cmd;
+    cmd = furi_string_alloc();
+    Gui* gui = furi_record_open(RECORD_GUI);
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            gui_cli_command_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "stats") == 0) {
+            gui_cli_stats(gui);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "stats_reset") == 0) {
+            gui_reset_redraw_stats(gui);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "fps") == 0) {
+            gui_cli_fps(gui, args);
+            break;
+        }
+
+        gui_cli_command_print_usage();
+    } while(false);
+
+    furi_record_close(RECORD_GUI);
+    furi_string_free(cmd);
+}
+
+void gui_on_system_start() {
+#ifdef SRV_CLI
+    Cli* cli = furi_record_open(RECORD_CLI);
+
+    cli_add_command(cli, "gui", CliCommandFlagParallelSafe, gui_cli, NULL);
+
+    furi_record_close(RECORD_CLI);
+#else
+    UNUSED(gui_cli);
+#endif
+}
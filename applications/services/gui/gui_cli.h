@@ -0,0 +1,11 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void gui_on_system_start();
+
+#ifdef __cplusplus
+}
+#endif
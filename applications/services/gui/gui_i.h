@@ -42,6 +42,9 @@
 #define GUI_THREAD_FLAG_INPUT (1 << 1)
 #define GUI_THREAD_FLAG_ALL (GUI_THREAD_FLAG_DRAW | GUI_THREAD_FLAG_INPUT)
 
+/* Redraw requests arriving faster than this are coalesced into one frame */
+#define GUI_MAX_FPS_DEFAULT 30
+
 ARRAY_DEF(ViewPortArray, ViewPort*, M_PTR_OPLIST);
 
 typedef struct {
@@ -55,6 +58,15 @@ ARRAY_DEF(CanvasCallbackPairArray, CanvasCallbackPair, M_POD_OPLIST);
 
 ALGO_DEF(CanvasCallbackPairArray, CanvasCallbackPairArray_t);
 
+/** Redraw statistics */
+typedef struct {
+    uint32_t update_requests; /**< gui_update calls */
+    uint32_t frames; /**< frames rendered */
+    uint32_t frames_unchanged; /**< frames not sent to display, identical to previous */
+    uint32_t frame_time_total_us;
+    uint32_t frame_time_max_us;
+} GuiRedrawStats;
+
 /** Gui structure */
 struct Gui {
     // Thread and lock
@@ -69,6 +81,15 @@ struct Gui {
     Canvas* canvas;
     CanvasCallbackPairArray_t canvas_callback_pair;
 
+    // Frame scheduling
+    uint32_t frame_interval;
+    uint32_t last_frame_tick;
+    bool redraw_pending;
+    bool force_commit;
+    uint8_t* last_frame;
+    CanvasOrientation last_orientation;
+    GuiRedrawStats stats;
+
     // Input
     FuriMessageQueue* input_queue;
     FuriPubSub* input_events;
@@ -106,6 +127,40 @@ void gui_input_events_callback(const void* value, void* ctx);
  */
 size_t gui_active_view_port_count(Gui* gui, GuiLayer layer);
 
+/** Set frame rate limit
+ *
+ * @param      gui      The Gui instance
+ * @param[in]  max_fps  maximum frames per second, 0 to disable limit
+ */
+void gui_set_max_fps(Gui* gui, uint32_t max_fps);
+
+/** Get redraw statistics
+ *
+ * @param      gui    The Gui instance
+ * @param      stats  GuiRedrawStats to fill
+ */
+void gui_get_redraw_stats(Gui* gui, GuiRedrawStats* stats);
+
+/** Reset redraw statistics
+ *
+ * @param      gui   The Gui instance
+ */
+void gui_reset_redraw_stats(Gui* gui);
+
+/** Cache decoded frames of an icon loaded to RAM
+ *
+ * @param      gui   The Gui instance
+ * @param      icon  Icon instance, its frames must stay valid till removed
+ */
+void gui_add_cached_icon(Gui* gui, const Icon* icon);
+
+/** Drop decoded frames of an icon from cache, must be called before freeing them
+ *
+ * @param      gui   The Gui instance
+ * @param      icon  Icon instance
+ */
+void gui_remove_cached_icon(Gui* gui, const Icon* icon);
+
 /** Lock GUI
  *
  * @param      gui   The Gui instance
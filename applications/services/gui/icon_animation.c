@@ -33,6 +33,10 @@ const uint8_t* icon_animation_get_data(const IconAnimation* instance) {
     return instance->icon->frames[instance->frame];
 }
 
+const uint8_t* icon_animation_get_next_data(const IconAnimation* instance) {
+    return instance->icon->frames[(instance->frame + 1) % instance->icon->frame_count];
+}
+
 void icon_animation_next_frame(IconAnimation* instance) {
     furi_assert(instance);
     instance->frame = (instance->frame + 1) % instance->icon->frame_count;
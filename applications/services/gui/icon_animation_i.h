@@ -26,6 +26,14 @@ struct IconAnimation {
  */
 const uint8_t* icon_animation_get_data(const IconAnimation* instance);
 
+/** Get pointer to next frame data
+ *
+ * @param      instance  IconAnimation instance
+ *
+ * @return     pointer to next frame XBM bitmap data
+ */
+const uint8_t* icon_animation_get_next_data(const IconAnimation* instance);
+
 /** Advance to next frame
  *
  * @param      instance  IconAnimation instance
@@ -0,0 +1,366 @@
+#include "icon_cache_i.h"
+#include "icon_i.h"
+
+#include <furi.h>
+#include <furi_hal.h>
+
+#define TAG "IconCache"
+
+#define ICON_CACHE_SLOT_NONE (SIZE_MAX)
+#define ICON_CACHE_PREFETCH_QUEUE_SIZE (2)
+#define ICON_CACHE_PREFETCH_STACK_SIZE (1024)
+#define ICON_CACHE_LOG_INTERVAL (1024)
+#define ICON_CACHE_RAM_ICONS_MAX (4)
+
+/* Slots are only filled while heap has this much left, and emptied below it */
+#define ICON_CACHE_HEAP_RESERVE (32 * 1024)
+
+typedef struct {
+    const uint8_t* icon_data;
+    size_t decoded_size;
+} IconCachePrefetchRequest;
+
+typedef struct {
+    const uint8_t* key;
+    uint32_t last_used;
+    bool loading;
+    uint8_t* data; /**< allocated on first use, freed under heap pressure */
+} IconCacheSlot;
+
+struct IconCache {
+    FuriMutex* mutex;
+    IconCacheSlot* slots;
+    size_t slot_count;
+    size_t pinned;
+    uint32_t clock;
+
+    FuriThread* thread;
+    FuriMessageQueue* queue;
+    CompressIcon* prefetch_decoder;
+    const uint8_t* prefetch_key; /**< frame being decoded by prefetch thread */
+
+    const Icon* ram_icons[ICON_CACHE_RAM_ICONS_MAX];
+
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t prefetched;
+    uint32_t decode_cycles;
+};
+
+static bool icon_cache_icon_has_frame(const Icon* icon, const uint8_t* icon_data) {
+    for(size_t i = 0; i < icon->frame_count; i++) {
+        if(icon->frames[i] == icon_data) return true;
+    }
+    return false;
+}
+
+/* Frames are matched by pointer alone. Icon data in RAM can be freed and its
+ * address reused, so it is only cached while its icon is registered with
+ * icon_cache_add_icon, which is undone before the frames are freed. Firmware
+ * image icons stay valid forever. Called with mutex held. */
+static bool icon_cache_is_cacheable(
+    IconCache* cache,
+    const uint8_t* icon_data,
+    size_t decoded_size) {
+    if(decoded_size > ICON_CACHE_SLOT_SIZE) return false;
+
+    bool in_flash = (size_t)icon_data >= furi_hal_flash_get_base() &&
+                    (const void*)icon_data < furi_hal_flash_get_free_start_address();
+    if(!in_flash) {
+        bool registered = false;
+        for(size_t i = 0; i < ICON_CACHE_RAM_ICONS_MAX && !registered; i++) {
+            registered = cache->ram_icons[i] &&
+                         icon_cache_icon_has_frame(cache->ram_icons[i], icon_data);
+        }
+        if(!registered) return false;
+    }
+
+    return compress_icon_get_compressed_size(icon_data);
+}
+
+static size_t icon_cache_find(IconCache* cache, const uint8_t* icon_data) {
+    for(size_t i = 0; i < cache->slot_count; i++) {
+        IconCacheSlot* slot = &cache->slots[i];
+        if(!slot->loading && slot->key == icon_data) {
+            return i;
+        }
+    }
+    return ICON_CACHE_SLOT_NONE;
+}
+
+/* Give slot memory back to heap, except the one handed out last */
+static void icon_cache_trim(IconCache* cache) {
+    for(size_t i = 0; i < cache->slot_count; i++) {
+        IconCacheSlot* slot = &cache->slots[i];
+        if(slot->loading || i == cache->pinned || !slot->data) continue;
+        free(slot->data);
+        slot->data = NULL;
+        slot->key = NULL;
+    }
+}
+
+/* Take free or least recently used slot, never the one handed out last */
+static size_t icon_cache_claim(IconCache* cache) {
+    bool can_grow = memmgr_get_free_heap() > ICON_CACHE_HEAP_RESERVE + ICON_CACHE_SLOT_SIZE;
+
+    size_t empty = ICON_CACHE_SLOT_NONE;
+    size_t oldest = ICON_CACHE_SLOT_NONE;
+    for(size_t i = 0; i < cache->slot_count; i++) {
+        IconCacheSlot* slot = &cache->slots[i];
+        if(slot->loading || i == cache->pinned) continue;
+        if(!slot->key) {
+            if(slot->data) {
+                empty = i;
+                break;
+            } else if(can_grow && empty == ICON_CACHE_SLOT_NONE) {
+                empty = i;
+            }
+        } else if(
+            oldest == ICON_CACHE_SLOT_NONE ||
+            (cache->clock - slot->last_used) > (cache->clock - cache->slots[oldest].last_used)) {
+            oldest = i;
+        }
+    }
+
+    size_t index = (empty != ICON_CACHE_SLOT_NONE) ? empty : oldest;
+
+    if(index != ICON_CACHE_SLOT_NONE) {
+        IconCacheSlot* slot = &cache->slots[index];
+        if(!slot->data) slot->data = malloc(ICON_CACHE_SLOT_SIZE);
+        slot->key = NULL;
+        slot->loading = true;
+    }
+
+    return index;
+}
+
+static void icon_cache_commit(IconCache* cache, size_t index, const uint8_t* icon_data, bool pin) {
+    IconCacheSlot* slot = &cache->slots[index];
+    slot->key = icon_data;
+    slot->last_used = ++cache->clock;
+    slot->loading = false;
+    if(pin) cache->pinned = index;
+}
+
+static void icon_cache_log_stats(IconCache* cache) {
+    IconCacheStats stats;
+    icon_cache_get_stats(cache, &stats);
+    FURI_LOG_D(
+        TAG,
+        "Hits %lu, misses %lu, prefetched %lu, decode %luus, saved %luus",
+        stats.hits,
+        stats.misses,
+        stats.prefetched,
+        stats.decode_us,
+        stats.saved_us);
+}
+
+static int32_t icon_cache_prefetch_worker(void* context) {
+    IconCache* cache = context;
+    IconCachePrefetchRequest request;
+
+    while(furi_message_queue_get(cache->queue, &request, FuriWaitForever) == FuriStatusOk) {
+        if(!request.icon_data) break;
+
+        furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+        size_t index = ICON_CACHE_SLOT_NONE;
+        // Icon may have been removed while request was queued
+        if(icon_cache_is_cacheable(cache, request.icon_data, request.decoded_size) &&
+           icon_cache_find(cache, request.icon_data) == ICON_CACHE_SLOT_NONE) {
+            index = icon_cache_claim(cache);
+        }
+        if(index != ICON_CACHE_SLOT_NONE) {
+            // Keeps icon_cache_remove_icon from returning while frame is read
+            cache->prefetch_key = request.icon_data;
+        }
+        furi_check(furi_mutex_release(cache->mutex) == FuriStatusOk);
+
+        if(index == ICON_CACHE_SLOT_NONE) continue;
+
+        uint8_t* decoded = NULL;
+        compress_icon_decode(cache->prefetch_decoder, request.icon_data, &decoded);
+        memcpy(cache->slots[index].data, decoded, request.decoded_size);
+
+        furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+        icon_cache_commit(cache, index, request.icon_data, false);
+        cache->prefetch_key = NULL;
+        cache->prefetched++;
+        furi_check(furi_mutex_release(cache->mutex) == FuriStatusOk);
+    }
+
+    return 0;
+}
+
+IconCache* icon_cache_alloc(size_t budget) {
+    IconCache* cache = malloc(sizeof(IconCache));
+    cache->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    cache->pinned = ICON_CACHE_SLOT_NONE;
+
+    size_t slot_count = budget / ICON_CACHE_SLOT_SIZE;
+    if(slot_count >= 2) {
+        cache->slots = malloc(sizeof(IconCacheSlot) * slot_count);
+        cache->slot_count = slot_count;
+
+        cache->queue = furi_message_queue_alloc(
+            ICON_CACHE_PREFETCH_QUEUE_SIZE, sizeof(IconCachePrefetchRequest));
+        cache->prefetch_decoder = compress_icon_alloc();
+        cache->thread = furi_thread_alloc_ex(
+            "IconCachePrefetch",
+            ICON_CACHE_PREFETCH_STACK_SIZE,
+            icon_cache_prefetch_worker,
+            cache);
+        furi_thread_set_priority(cache->thread, FuriThreadPriorityLow);
+        furi_thread_start(cache->thread);
+    }
+
+    return cache;
+}
+
+void icon_cache_free(IconCache* cache) {
+    furi_assert(cache);
+
+    if(cache->slot_count) {
+        IconCachePrefetchRequest request = {.icon_data = NULL};
+        furi_message_queue_put(cache->queue, &request, FuriWaitForever);
+        furi_thread_join(cache->thread);
+        furi_thread_free(cache->thread);
+        compress_icon_free(cache->prefetch_decoder);
+        furi_message_queue_free(cache->queue);
+        for(size_t i = 0; i < cache->slot_count; i++) {
+            free(cache->slots[i].data);
+        }
+        free(cache->slots);
+    }
+
+    furi_mutex_free(cache->mutex);
+    free(cache);
+}
+
+const uint8_t* icon_cache_get(
+    IconCache* cache,
+    CompressIcon* decoder,
+    const uint8_t* icon_data,
+    size_t decoded_size) {
+    furi_assert(cache);
+    furi_assert(decoder);
+    furi_assert(icon_data);
+
+    uint8_t* decoded = NULL;
+    if(!cache->slot_count) {
+        compress_icon_decode(decoder, icon_data, &decoded);
+        return decoded;
+    }
+
+    furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+    if(!icon_cache_is_cacheable(cache, icon_data, decoded_size)) {
+        furi_check(furi_mutex_release(cache->mutex) == FuriStatusOk);
+        compress_icon_decode(decoder, icon_data, &decoded);
+        return decoded;
+    }
+    if(memmgr_get_free_heap() < ICON_CACHE_HEAP_RESERVE) {
+        icon_cache_trim(cache);
+    }
+    size_t index = icon_cache_find(cache, icon_data);
+    if(index != ICON_CACHE_SLOT_NONE) {
+        cache->slots[index].last_used = ++cache->clock;
+        cache->pinned = index;
+        cache->hits++;
+    } else {
+        cache->misses++;
+        index = icon_cache_claim(cache);
+    }
+    bool hit = (index != ICON_CACHE_SLOT_NONE) && !cache->slots[index].loading;
+    if((cache->hits + cache->misses) % ICON_CACHE_LOG_INTERVAL == 0) {
+        icon_cache_log_stats(cache);
+    }
+    furi_check(furi_mutex_release(cache->mutex) == FuriStatusOk);
+
+    if(hit) {
+        return cache->slots[index].data;
+    }
+
+    uint32_t start = DWT->CYCCNT;
+    compress_icon_decode(decoder, icon_data, &decoded);
+    uint32_t cycles = DWT->CYCCNT - start;
+
+    if(index != ICON_CACHE_SLOT_NONE) {
+        memcpy(cache->slots[index].data, decoded, decoded_size);
+    }
+
+    furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+    cache->decode_cycles += cycles;
+    if(index != ICON_CACHE_SLOT_NONE) {
+        icon_cache_commit(cache, index, icon_data, true);
+    }
+    furi_check(furi_mutex_release(cache->mutex) == FuriStatusOk);
+
+    return (index != ICON_CACHE_SLOT_NONE) ? cache->slots[index].data : decoded;
+}
+
+void icon_cache_prefetch(IconCache* cache, const uint8_t* icon_data, size_t decoded_size) {
+    furi_assert(cache);
+    furi_assert(icon_data);
+
+    if(!cache->slot_count) return;
+
+    IconCachePrefetchRequest request = {
+        .icon_data = icon_data,
+        .decoded_size = decoded_size,
+    };
+    furi_message_queue_put(cache->queue, &request, 0);
+}
+
+void icon_cache_add_icon(IconCache* cache, const Icon* icon) {
+    furi_assert(cache);
+    furi_assert(icon);
+
+    furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+    for(size_t i = 0; i < ICON_CACHE_RAM_ICONS_MAX; i++) {
+        if(!cache->ram_icons[i]) {
+            cache->ram_icons[i] = icon;
+            break;
+        }
+    }
+    furi_check(furi_mutex_release(cache->mutex) == FuriStatusOk);
+}
+
+void icon_cache_remove_icon(IconCache* cache, const Icon* icon) {
+    furi_assert(cache);
+    furi_assert(icon);
+
+    while(true) {
+        furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+        if(cache->prefetch_key && icon_cache_icon_has_frame(icon, cache->prefetch_key)) {
+            // Prefetch thread is reading one of the frames, let it finish
+            furi_check(furi_mutex_release(cache->mutex) == FuriStatusOk);
+            furi_delay_tick(1);
+            continue;
+        }
+
+        for(size_t i = 0; i < ICON_CACHE_RAM_ICONS_MAX; i++) {
+            if(cache->ram_icons[i] == icon) cache->ram_icons[i] = NULL;
+        }
+        for(size_t i = 0; i < cache->slot_count; i++) {
+            IconCacheSlot* slot = &cache->slots[i];
+            if(slot->key && icon_cache_icon_has_frame(icon, slot->key)) {
+                slot->key = NULL;
+            }
+        }
+        furi_check(furi_mutex_release(cache->mutex) == FuriStatusOk);
+        break;
+    }
+}
+
+void icon_cache_get_stats(IconCache* cache, IconCacheStats* stats) {
+    furi_assert(cache);
+    furi_assert(stats);
+
+    uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    uint32_t decode_us = cache->decode_cycles / cycles_per_us;
+
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->prefetched = cache->prefetched;
+    stats->decode_us = decode_us;
+    stats->saved_us = cache->misses ? (uint64_t)decode_us * cache->hits / cache->misses : 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file icon_cache_i.h
+ * GUI: internal decoded icon frame cache
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <toolbox/compress.h>
+#include "icon.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Default cache budget: fits 16 full screen frames */
+#define ICON_CACHE_BUDGET (16 * 1024)
+
+/** Largest decoded frame that can be cached, one full screen */
+#define ICON_CACHE_SLOT_SIZE (128 * 64 / 8)
+
+typedef struct IconCache IconCache;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t prefetched;
+    uint32_t decode_us; /**< time spent decoding on draw path */
+    uint32_t saved_us; /**< estimated decode time saved by hits */
+} IconCacheStats;
+
+/** Allocate icon cache
+ *
+ * Slot memory is allocated from heap on demand, while enough heap is left,
+ * and given back when it runs low. Compressed icons of firmware image and of
+ * icons added with icon_cache_add_icon are cached, others are decoded on every
+ * lookup.
+ *
+ * @param      budget  cache size in bytes
+ *
+ * @return     IconCache instance
+ */
+IconCache* icon_cache_alloc(size_t budget);
+
+/** Free icon cache
+ *
+ * @param      cache  IconCache instance
+ */
+void icon_cache_free(IconCache* cache);
+
+/** Get decoded icon frame, decoding and caching it on miss
+ *
+ * @warning    returned pointer is valid till next icon_cache_get call
+ *
+ * @param      cache         IconCache instance
+ * @param      decoder       CompressIcon instance used on miss
+ * @param      icon_data     compressed icon data
+ * @param      decoded_size  size of decoded frame in bytes
+ *
+ * @return     pointer to decoded frame
+ */
+const uint8_t* icon_cache_get(
+    IconCache* cache,
+    CompressIcon* decoder,
+    const uint8_t* icon_data,
+    size_t decoded_size);
+
+/** Request decoding of a frame in background
+ *
+ * Request is dropped if prefetch thread is busy.
+ *
+ * @param      cache         IconCache instance
+ * @param      icon_data     compressed icon data
+ * @param      decoded_size  size of decoded frame in bytes
+ */
+void icon_cache_prefetch(IconCache* cache, const uint8_t* icon_data, size_t decoded_size);
+
+/** Cache frames of an icon loaded to RAM, e.g. dolphin animation from SD
+ *
+ * Only a few icons can be added at once, extra ones are not cached.
+ *
+ * @param      cache  IconCache instance
+ * @param      icon   Icon instance, its frames must stay valid till removed
+ */
+void icon_cache_add_icon(IconCache* cache, const Icon* icon);
+
+/** Drop icon frames from cache, must be called before they are freed
+ *
+ * Waits for prefetch of the icon frames to finish.
+ *
+ * @param      cache  IconCache instance
+ * @param      icon   Icon instance
+ */
+void icon_cache_remove_icon(IconCache* cache, const Icon* icon);
+
+/** Get cache statistics
+ *
+ * @param      cache  IconCache instance
+ * @param      stats  IconCacheStats to fill
+ */
+void icon_cache_get_stats(IconCache* cache, IconCacheStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -30,6 +30,7 @@ static void lfrfid_cli_print_usage() {
     printf("rfid raw_read <ask | psk> <filename>\r\n");
     printf("rfid raw_emulate <filename>\r\n");
     printf("rfid raw_analyze <filename>\r\n");
+    printf("rfid raw_replay <filename> <optional: protocol>\r\n");
 }
 
 typedef struct {
@@ -384,6 +385,203 @@ static void lfrfid_cli_raw_analyze(Cli* cli, FuriString* args) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define LFRFID_CLI_REPLAY_BATCH_SIZE (256)
+#define LFRFID_CLI_REPLAY_PSK_FREQUENCY_MAX (100000.0f)
+
+typedef struct {
+    uint32_t decodes;
+    uint32_t mismatches; /**< decoded data differs from the first decode */
+    bool data_valid;
+    uint8_t* data;
+} LFRFIDCliReplayProtocol;
+
+/* Replays a raw capture through all decoders of the capture modulation and
+ * counts every decode, so decoder changes can be checked and benchmarked
+ * against saved captures without a card */
+static void lfrfid_cli_raw_replay(Cli* cli, FuriString* args) {
+    FuriString *filepath, *protocol_name;
+    filepath = furi_string_alloc();
+    protocol_name = furi_string_alloc();
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+
+    size_t data_size_max = protocol_dict_get_max_data_size(dict);
+    uint8_t* data = malloc(data_size_max);
+    uint32_t* durations = malloc(sizeof(uint32_t) * LFRFID_CLI_REPLAY_BATCH_SIZE);
+    LFRFIDCliReplayProtocol* protocols =
+        malloc(sizeof(LFRFIDCliReplayProtocol) * LFRFIDProtocolMax);
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        protocols[i].data = malloc(data_size_max);
+    }
+
+    do {
+        float frequency = 0;
+        float duty_cycle = 0;
+        ProtocolId expected = PROTOCOL_NO;
+
+        if(!args_read_probably_quoted_string_and_trim(args, filepath)) {
+            lfrfid_cli_print_usage();
+            break;
+        }
+
+        if(args_read_string_and_trim(args, protocol_name)) {
+            expected =
+                protocol_dict_get_protocol_by_name(dict, furi_string_get_cstr(protocol_name));
+            if(expected == PROTOCOL_NO) {
+                printf("Unknown protocol %s\r\n", furi_string_get_cstr(protocol_name));
+                break;
+            }
+        }
+
+        if(!lfrfid_raw_file_open_read(file, furi_string_get_cstr(filepath))) {
+            printf("Failed to open file\r\n");
+            break;
+        }
+
+        if(!lfrfid_raw_file_read_header(file, &frequency, &duty_cycle)) {
+            printf("Invalid header\r\n");
+            break;
+        }
+
+        // PSK captures are taken with half the carrier frequency
+        uint32_t feature = (frequency < LFRFID_CLI_REPLAY_PSK_FREQUENCY_MAX) ? LFRFIDFeaturePSK :
+                                                                              LFRFIDFeatureASK;
+        if(expected != PROTOCOL_NO && !(protocol_dict_get_features(dict, expected) & feature)) {
+            printf("Protocol can't be decoded from this capture\r\n");
+            break;
+        }
+
+        bool file_end = false;
+        bool interrupted = false;
+        uint32_t total_warns = 0;
+        uint32_t total_pulses = 0;
+        uint64_t total_cycles = 0;
+
+        protocol_dict_decoders_start(dict);
+
+        while(!file_end && !interrupted) {
+            size_t count = 0;
+            while(count + 2 <= LFRFID_CLI_REPLAY_BATCH_SIZE && !file_end) {
+                uint32_t pulse = 0;
+                uint32_t duration = 0;
+                if(!lfrfid_raw_file_read_pair(file, &duration, &pulse, &file_end)) {
+                    printf("Failed to read pair\r\n");
+                    file_end = true;
+                } else if(file_end) {
+                    break;
+                } else if(pulse > duration || pulse == 0) {
+                    total_warns++;
+                } else {
+                    durations[count++] = pulse;
+                    durations[count++] = duration - pulse;
+                }
+            }
+
+            size_t position = 0;
+            while(position < count) {
+                size_t consumed = 0;
+                uint32_t start = DWT->CYCCNT;
+                ProtocolId protocol = protocol_dict_decoders_feed_batch_by_feature(
+                    dict, feature, true, &durations[position], count - position, &consumed);
+                total_cycles += DWT->CYCCNT - start;
+                position += consumed;
+
+                if(protocol == PROTOCOL_NO) break;
+
+                LFRFIDCliReplayProtocol* stats = &protocols[protocol];
+                size_t data_size = protocol_dict_get_data_size(dict, protocol);
+                protocol_dict_get_data(dict, protocol, data, data_size);
+                if(!stats->data_valid) {
+                    memcpy(stats->data, data, data_size);
+                    stats->data_valid = true;
+                } else if(memcmp(stats->data, data, data_size) != 0) {
+                    stats->mismatches++;
+                }
+                stats->decodes++;
+
+                protocol_dict_decoders_start(dict);
+                // Keep batches starting from pulse
+                position += position & 1;
+            }
+            total_pulses += count;
+
+            interrupted = cli_cmd_interrupt_received(cli);
+        }
+
+        if(interrupted) {
+            printf("Interrupted\r\n");
+        }
+
+        // Without an expected protocol, the most decoded one is taken as correct
+        ProtocolId reference = expected;
+        if(reference == PROTOCOL_NO) {
+            for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+                if(protocols[i].decodes &&
+                   (reference == PROTOCOL_NO ||
+                    protocols[i].decodes > protocols[reference].decodes)) {
+                    reference = i;
+                }
+            }
+        }
+
+        uint32_t total_us = total_cycles / furi_hal_cortex_instructions_per_microsecond();
+        uint32_t false_positives = 0;
+
+        printf("   Frequency: %f\r\n", (double)frequency);
+        printf("  Duty Cycle: %f\r\n", (double)duty_cycle);
+        printf("       Warns: %lu\r\n", total_warns);
+        printf("      Pulses: %lu\r\n", total_pulses);
+        printf(" Decode time: %lu us\r\n", total_us);
+        printf(
+            "  Throughput: %lu pulses/s\r\n",
+            total_us ? (uint32_t)((uint64_t)total_pulses * 1000000 / total_us) : 0);
+
+        for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+            if(!protocols[i].decodes) continue;
+            printf(
+                "%-16s decodes %lu, mismatches %lu%s\r\n",
+                protocol_dict_get_name(dict, i),
+                protocols[i].decodes,
+                protocols[i].mismatches,
+                ((ProtocolId)i == reference) ? " <-" : "");
+            if((ProtocolId)i != reference) {
+                false_positives += protocols[i].decodes;
+            }
+        }
+
+        printf("    Protocol: ");
+        if(reference != PROTOCOL_NO && protocols[reference].decodes) {
+            size_t data_size = protocol_dict_get_data_size(dict, reference);
+            protocol_dict_set_data(dict, reference, protocols[reference].data, data_size);
+            protocol_dict_render_data(dict, protocol_name, reference);
+            printf(
+                "%s\r\n%s\r\n",
+                protocol_dict_get_name(dict, reference),
+                furi_string_get_cstr(protocol_name));
+            printf(
+                "     Success: %lu\r\n",
+                protocols[reference].decodes - protocols[reference].mismatches);
+            printf("  Mismatches: %lu\r\n", protocols[reference].mismatches);
+        } else {
+            printf("not found\r\n");
+        }
+        printf("False positives: %lu\r\n", false_positives);
+    } while(false);
+
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        free(protocols[i].data);
+    }
+    free(protocols);
+    free(durations);
+    free(data);
+    protocol_dict_free(dict);
+    furi_string_free(filepath);
+    furi_string_free(protocol_name);
+    lfrfid_raw_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
 static void lfrfid_cli_raw_read_callback(LFRFIDWorkerReadRawResult result, void* context) {
     furi_assert(context);
     FuriEventFlag* event = context;
@@ -569,6 +767,8 @@ static void lfrfid_cli(Cli* cli, FuriString* args, void* context) {
         lfrfid_cli_raw_emulate(cli, args);
     } else if(furi_string_cmp_str(cmd, "raw_analyze") == 0) {
         lfrfid_cli_raw_analyze(cli, args);
+    } else if(furi_string_cmp_str(cmd, "raw_replay") == 0) {
+        lfrfid_cli_raw_replay(cli, args);
     } else {
         lfrfid_cli_print_usage();
     }
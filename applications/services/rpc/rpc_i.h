@@ -6,6 +6,7 @@
 #include <pb_encode.h>
 #include <flipper.pb.h>
 #include <cli/cli.h>
+#include "rpc_storage_md5_cache.h"
 
 typedef void* (*RpcSystemAlloc)(RpcSession* session);
 typedef void (*RpcSystemFree)(void* context);
@@ -25,6 +26,8 @@ void rpc_send_and_release_empty(RpcSession* session, uint32_t command_id, PB_Com
 
 void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* handler);
 
+RpcStorageMd5Cache* rpc_session_get_md5_cache(RpcSession* session);
+
 void* rpc_system_system_alloc(RpcSession* session);
 void* rpc_system_storage_alloc(RpcSession* session);
 void rpc_system_storage_free(void* ctx);
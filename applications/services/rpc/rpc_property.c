@@ -3,6 +3,8 @@
 #include <furi_hal_info.h>
 #include <furi_hal_power.h>
 #include <core/core_defines.h>
+#include <toolbox/profiler_probe.h>
+#include <toolbox/property.h>
 
 #include "rpc_i.h"
 
@@ -11,6 +13,10 @@
 #define PROPERTY_CATEGORY_DEVICE_INFO "devinfo"
 #define PROPERTY_CATEGORY_POWER_INFO "pwrinfo"
 #define PROPERTY_CATEGORY_POWER_DEBUG "pwrdebug"
+#define PROPERTY_CATEGORY_PROBES "probes"
+#define PROPERTY_CATEGORY_THREADS "threads"
+
+#define PROPERTY_THREADS_MAX 32
 
 typedef struct {
     RpcSession* session;
@@ -41,6 +47,66 @@ static void
     }
 }
 
+/* Scheduling statistics of all threads, keyed by enumeration index */
+static void rpc_system_property_threads_get(PropertyValueCallback out, char sep, void* context) {
+    FuriString* value = furi_string_alloc();
+    FuriString* key = furi_string_alloc();
+    FuriString* histogram = furi_string_alloc();
+
+    PropertyValueContext property_context = {
+        .key = key, .value = value, .out = out, .sep = sep, .last = false, .context = context};
+
+    property_value_out(&property_context, NULL, 2, "format", "major", "1");
+    property_value_out(&property_context, NULL, 2, "format", "minor", "0");
+    property_value_out(
+        &property_context,
+        "%lu",
+        1,
+        "clock",
+        furi_hal_cortex_instructions_per_microsecond() * 1000000UL);
+    property_value_out(&property_context, "%llu", 1, "run_time", furi_hal_cortex_get_cycles());
+
+    FuriThreadId threads_ids[PROPERTY_THREADS_MAX];
+    uint32_t thread_num = furi_thread_enumerate(threads_ids, PROPERTY_THREADS_MAX);
+    for(uint32_t i = 0; i < thread_num; i++) {
+        char index[4];
+        snprintf(index, sizeof(index), "%lu", i);
+
+        FuriThreadStats stats;
+        furi_thread_get_stats(threads_ids[i], &stats);
+
+        property_value_out(
+            &property_context, NULL, 2, index, "name", furi_thread_get_name(threads_ids[i]));
+        property_value_out(
+            &property_context, NULL, 2, index, "appid", furi_thread_get_appid(threads_ids[i]));
+        property_value_out(&property_context, "%llu", 2, index, "run_time", stats.run_time);
+        property_value_out(&property_context, "%lu", 2, index, "switches", stats.switches);
+        property_value_out(&property_context, "%lu", 2, index, "wakeups", stats.wakeups);
+        property_value_out(
+            &property_context, "%llu", 2, index, "latency_total", stats.latency_total);
+        property_value_out(&property_context, "%lu", 2, index, "latency_max", stats.latency_max);
+
+        furi_string_reset(histogram);
+        for(size_t j = 0; j < FURI_THREAD_LATENCY_HISTOGRAM_SIZE; j++) {
+            furi_string_cat_printf(histogram, j ? ",%lu" : "%lu", stats.latency_histogram[j]);
+        }
+        property_value_out(
+            &property_context,
+            NULL,
+            2,
+            index,
+            "latency_histogram",
+            furi_string_get_cstr(histogram));
+    }
+
+    property_context.last = true;
+    property_value_out(&property_context, "%lu", 1, "count", thread_num);
+
+    furi_string_free(histogram);
+    furi_string_free(key);
+    furi_string_free(value);
+}
+
 static void rpc_system_property_get_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(request->which_content == PB_Main_property_get_request_tag);
@@ -81,6 +147,10 @@ static void rpc_system_property_get_process(const PB_Main* request, void* contex
         furi_hal_power_info_get(rpc_system_property_get_callback, '.', &property_context);
     } else if(!furi_string_cmp(topkey, PROPERTY_CATEGORY_POWER_DEBUG)) {
         furi_hal_power_debug_get(rpc_system_property_get_callback, &property_context);
+    } else if(!furi_string_cmp(topkey, PROPERTY_CATEGORY_PROBES)) {
+        profiler_probe_info_get(rpc_system_property_get_callback, '.', &property_context);
+    } else if(!furi_string_cmp(topkey, PROPERTY_CATEGORY_THREADS)) {
+        rpc_system_property_threads_get(rpc_system_property_get_callback, '.', &property_context);
     } else {
         rpc_send_and_release_empty(
             session, request->command_id, PB_CommandStatus_ERROR_INVALID_PARAMETERS);
@@ -9,9 +9,11 @@
 #include "storage/filesystem_api_defines.h"
 #include "storage/storage.h"
 #include <stdint.h>
+#include <lib/toolbox/md5.h>
 #include <lib/toolbox/md5_calc.h>
 #include <lib/toolbox/path.h>
 #include <update_util/lfs_backup.h>
+#include "rpc_storage_md5_cache.h"
 
 #define TAG "RpcStorage"
 
@@ -30,6 +32,10 @@ typedef struct {
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+    /* MD5 of the file being written, fed chunk by chunk */
+    md5_context* write_md5;
+    FuriString* write_path;
+    RpcStorageMd5Cache* md5_cache;
 } RpcStorageSystem;
 
 static void rpc_system_storage_reset_state(
@@ -48,7 +54,15 @@ static void rpc_system_storage_reset_state(
         }
 
         if(rpc_storage->state == RpcStorageStateWriting) {
+            bool file_was_open = storage_file_is_open(rpc_storage->file);
             storage_file_close(rpc_storage->file);
+            if(!send_error && file_was_open) {
+                // Hash covers exactly the bytes written, so listings won't have to reread it
+                uint8_t md5[RPC_STORAGE_MD5_SIZE];
+                md5_finish(rpc_storage->write_md5, md5);
+                rpc_storage_md5_cache_put(
+                    rpc_storage->md5_cache, furi_string_get_cstr(rpc_storage->write_path), md5);
+            }
             storage_file_free(rpc_storage->file);
             furi_record_close(RECORD_STORAGE);
         }
@@ -292,7 +306,7 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
 
     bool include_md5 = list_request->include_md5;
     FuriString* md5 = furi_string_alloc();
-    FuriString* md5_path = furi_string_alloc();
+    RpcStorageMd5CacheDir* md5_cache = NULL;
     File* file = storage_file_alloc(fs_api);
 
     bool finish = false;
@@ -302,6 +316,8 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
         response.command_status = rpc_system_storage_get_file_error(dir);
         response.which_content = PB_Main_empty_tag;
         finish = true;
+    } else if(include_md5) {
+        md5_cache = rpc_storage_md5_cache_dir_open(rpc_storage->md5_cache, list_request->path);
     }
 
     while(!finish) {
@@ -322,9 +338,7 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
                 list->file[i].name = name;
 
                 if(include_md5 && !file_info_is_dir(&fileinfo)) {
-                    furi_string_printf(md5_path, "%s/%s", list_request->path, name); //-V576
-
-                    if(md5_string_calc_file(file, furi_string_get_cstr(md5_path), md5, NULL)) {
+                    if(rpc_storage_md5_cache_dir_get(md5_cache, file, name, fileinfo.size, md5)) {
                         char* md5sum = list->file[i].md5sum;
                         size_t md5sum_size = sizeof(list->file[i].md5sum);
                         snprintf(md5sum, md5sum_size, "%s", furi_string_get_cstr(md5));
@@ -345,8 +359,11 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     response.has_next = false;
     rpc_send_and_release(session, &response);
 
+    if(md5_cache) {
+        // Listing covered the whole directory, so entries of removed files can be dropped
+        rpc_storage_md5_cache_dir_close(md5_cache, true);
+    }
     furi_string_free(md5);
-    furi_string_free(md5_path);
     storage_dir_close(dir);
     storage_file_free(dir);
     storage_file_free(file);
@@ -453,6 +470,8 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
         const char* path = request->content.storage_write_request.path;
+        furi_string_set(rpc_storage->write_path, path);
+        md5_starts(rpc_storage->write_md5);
         fs_operation_success =
             storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
     }
@@ -468,6 +487,7 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
             size_t buffer_size = request->content.storage_write_request.file.data->size;
             uint16_t written_size = storage_file_write(file, buffer, buffer_size);
             fs_operation_success = (written_size == buffer_size);
+            md5_update(rpc_storage->write_md5, buffer, written_size);
         }
 
         send_response = !request->has_next;
@@ -715,6 +735,9 @@ void* rpc_system_storage_alloc(RpcSession* session) {
     rpc_storage->api = furi_record_open(RECORD_STORAGE);
     rpc_storage->session = session;
     rpc_storage->state = RpcStorageStateIdle;
+    rpc_storage->write_md5 = malloc(sizeof(md5_context));
+    rpc_storage->write_path = furi_string_alloc();
+    rpc_storage->md5_cache = rpc_session_get_md5_cache(session);
 
     RpcHandler rpc_handler = {
         .message_handler = NULL,
@@ -768,5 +791,7 @@ void rpc_system_storage_free(void* context) {
     furi_assert(session);
 
     rpc_system_storage_reset_state(rpc_storage, session, false);
+    furi_string_free(rpc_storage->write_path);
+    free(rpc_storage->write_md5);
     free(rpc_storage);
 }
@@ -0,0 +1,445 @@
+#include "rpc_storage_md5_cache.h"
+
+#include <furi.h>
+#include <m-dict.h>
+#include <toolbox/crc32_calc.h>
+#include <toolbox/m_cstr_dup.h>
+#include <toolbox/md5_calc.h>
+#include <toolbox/path.h>
+
+#define TAG "RpcStorageMd5"
+
+#define RPC_STORAGE_MD5_CACHE_MAGIC (0x4335444DUL) /* "MD5C" */
+#define RPC_STORAGE_MD5_CACHE_VERSION (2)
+
+/* Changes not applied to cache files yet, whole cache is dropped on overflow */
+#define RPC_STORAGE_MD5_CACHE_CHANGES_MAX (32)
+
+typedef struct {
+    uint64_t size;
+    uint8_t md5[RPC_STORAGE_MD5_SIZE];
+    bool used;
+} RpcStorageMd5CacheEntry;
+
+DICT_DEF2(
+    RpcStorageMd5CacheDict,
+    const char*,
+    M_CSTR_DUP_OPLIST,
+    RpcStorageMd5CacheEntry,
+    M_POD_OPLIST)
+
+typedef struct {
+    uint32_t dir_hash;
+    uint32_t name_hash;
+    uint32_t sequence;
+} RpcStorageMd5CacheChange;
+
+struct RpcStorageMd5Cache {
+    Storage* storage;
+    FuriPubSubSubscription* subscription;
+
+    /* Guards fields below. Storage thread takes it in event callback,
+     * so it must never be held across storage calls. */
+    FuriMutex* mutex;
+    RpcStorageMd5CacheChange changes[RPC_STORAGE_MD5_CACHE_CHANGES_MAX];
+    size_t changes_count;
+    uint32_t sequence;
+    bool reset;
+};
+
+struct RpcStorageMd5CacheDir {
+    RpcStorageMd5Cache* cache;
+    FuriString* dir_path;
+    FuriString* file_path;
+    uint32_t dir_hash;
+    uint32_t sequence; /* changes up to this one are applied to entries */
+    RpcStorageMd5CacheDict_t entries;
+    bool enabled;
+    bool dirty;
+};
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint16_t dir_path_length;
+} __attribute__((packed)) RpcStorageMd5CacheHeader;
+
+/* On-disk record header, followed by name_length bytes of file name */
+typedef struct {
+    uint64_t size;
+    uint8_t md5[RPC_STORAGE_MD5_SIZE];
+    uint8_t name_length;
+} __attribute__((packed)) RpcStorageMd5CacheRecord;
+
+static uint32_t rpc_storage_md5_cache_hash(const char* path, size_t length) {
+    uint32_t hash = 0;
+
+    // "/any" is resolved to "/ext" by storage, events and requests may use either
+    size_t prefix_length = strlen(STORAGE_ANY_PATH_PREFIX);
+    if(length >= prefix_length && strncmp(path, STORAGE_ANY_PATH_PREFIX, prefix_length) == 0) {
+        hash = crc32_calc_buffer(hash, STORAGE_EXT_PATH_PREFIX, strlen(STORAGE_EXT_PATH_PREFIX));
+        path += prefix_length;
+        length -= prefix_length;
+    }
+
+    return crc32_calc_buffer(hash, path, length);
+}
+
+static uint32_t rpc_storage_md5_cache_dir_hash(const char* dir_path) {
+    size_t length = strlen(dir_path);
+    while(length > 1 && dir_path[length - 1] == '/') {
+        length--;
+    }
+    return rpc_storage_md5_cache_hash(dir_path, length);
+}
+
+static void rpc_storage_md5_cache_add_change(RpcStorageMd5Cache* cache, const char* path) {
+    const char* name = strrchr(path, '/');
+    if(!name) return;
+
+    uint32_t dir_hash = rpc_storage_md5_cache_hash(path, name - path);
+    uint32_t name_hash = rpc_storage_md5_cache_hash(name + 1, strlen(name + 1));
+
+    furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+
+    cache->sequence++;
+
+    size_t i = 0;
+    for(; i < cache->changes_count; i++) {
+        if(cache->changes[i].dir_hash == dir_hash && cache->changes[i].name_hash == name_hash) {
+            break;
+        }
+    }
+
+    if(i < COUNT_OF(cache->changes)) {
+        cache->changes[i].dir_hash = dir_hash;
+        cache->changes[i].name_hash = name_hash;
+        cache->changes[i].sequence = cache->sequence;
+        if(i == cache->changes_count) cache->changes_count++;
+    } else {
+        cache->reset = true;
+        cache->changes_count = 0;
+    }
+
+    furi_mutex_release(cache->mutex);
+}
+
+static void rpc_storage_md5_cache_storage_callback(const void* message, void* context) {
+    const StorageEvent* event = message;
+    RpcStorageMd5Cache* cache = context;
+
+    if(event->type == StorageEventTypeCardMount) {
+        furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+        cache->reset = true;
+        cache->changes_count = 0;
+        furi_mutex_release(cache->mutex);
+    } else if(event->type == StorageEventTypeFileModified) {
+        // Skip our own cache files
+        size_t prefix_length = strlen(RPC_STORAGE_MD5_CACHE_PATH);
+        if(strncmp(event->path, RPC_STORAGE_MD5_CACHE_PATH, prefix_length) != 0) {
+            rpc_storage_md5_cache_add_change(cache, event->path);
+        }
+    }
+}
+
+RpcStorageMd5Cache* rpc_storage_md5_cache_alloc(Storage* storage) {
+    furi_assert(storage);
+
+    RpcStorageMd5Cache* cache = malloc(sizeof(RpcStorageMd5Cache));
+    cache->storage = storage;
+    cache->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    // Card could be changed while we were not watching
+    cache->reset = true;
+    cache->subscription = furi_pubsub_subscribe(
+        storage_get_pubsub(storage), rpc_storage_md5_cache_storage_callback, cache);
+
+    return cache;
+}
+
+static bool rpc_storage_md5_cache_reset(RpcStorageMd5Cache* cache) {
+    furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+    bool reset = cache->reset;
+    cache->reset = false;
+    if(reset) cache->changes_count = 0;
+    furi_mutex_release(cache->mutex);
+
+    if(reset && !storage_simply_remove_recursive(cache->storage, RPC_STORAGE_MD5_CACHE_PATH)) {
+        furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+        cache->reset = true;
+        furi_mutex_release(cache->mutex);
+        return false;
+    }
+
+    return true;
+}
+
+static void rpc_storage_md5_cache_load(RpcStorageMd5CacheDir* dir) {
+    RpcStorageMd5Cache* cache = dir->cache;
+
+    // Names changed in this directory since it was saved
+    uint32_t changed[RPC_STORAGE_MD5_CACHE_CHANGES_MAX];
+    size_t changed_count = 0;
+
+    furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+    for(size_t i = 0; i < cache->changes_count; i++) {
+        if(cache->changes[i].dir_hash == dir->dir_hash) {
+            changed[changed_count++] = cache->changes[i].name_hash;
+        }
+    }
+    dir->sequence = cache->sequence;
+    furi_mutex_release(cache->mutex);
+
+    File* file = storage_file_alloc(cache->storage);
+    char* name = malloc(UINT8_MAX + 1);
+
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(dir->file_path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        // Anything unexpected is overwritten on close, so it can't outlive our changes
+        dir->dirty = true;
+
+        RpcStorageMd5CacheHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != RPC_STORAGE_MD5_CACHE_MAGIC ||
+           header.version != RPC_STORAGE_MD5_CACHE_VERSION ||
+           header.dir_path_length != furi_string_size(dir->dir_path)) {
+            break;
+        }
+
+        // Same hash, different directory
+        char* dir_path = malloc(header.dir_path_length + 1);
+        bool same_dir = storage_file_read(file, dir_path, header.dir_path_length) ==
+                        header.dir_path_length;
+        dir_path[header.dir_path_length] = '\0';
+        same_dir = same_dir && furi_string_equal_str(dir->dir_path, dir_path);
+        free(dir_path);
+        if(!same_dir) break;
+
+        dir->dirty = false;
+
+        RpcStorageMd5CacheRecord record;
+        while(storage_file_read(file, &record, sizeof(record)) == sizeof(record)) {
+            if(storage_file_read(file, name, record.name_length) != record.name_length) {
+                dir->dirty = true;
+                break;
+            }
+            name[record.name_length] = '\0';
+
+            bool is_changed = false;
+            if(changed_count) {
+                uint32_t name_hash = rpc_storage_md5_cache_hash(name, record.name_length);
+                for(size_t i = 0; i < changed_count; i++) {
+                    if(changed[i] == name_hash) {
+                        is_changed = true;
+                        break;
+                    }
+                }
+            }
+
+            if(is_changed) {
+                dir->dirty = true;
+                continue;
+            }
+
+            RpcStorageMd5CacheEntry entry = {
+                .size = record.size,
+                .used = false,
+            };
+            memcpy(entry.md5, record.md5, RPC_STORAGE_MD5_SIZE);
+            RpcStorageMd5CacheDict_set_at(dir->entries, name, entry);
+        }
+    } while(false);
+
+    free(name);
+    storage_file_close(file);
+    storage_file_free(file);
+}
+
+static bool rpc_storage_md5_cache_save(RpcStorageMd5CacheDir* dir, bool prune) {
+    Storage* storage = dir->cache->storage;
+    File* file = storage_file_alloc(storage);
+    bool result = false;
+
+    do {
+        if(!storage_simply_mkdir(storage, STORAGE_CACHE_PATH_PREFIX)) break;
+        if(!storage_simply_mkdir(storage, RPC_STORAGE_MD5_CACHE_PATH)) break;
+        if(!storage_file_open(
+               file, furi_string_get_cstr(dir->file_path), FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+
+        RpcStorageMd5CacheHeader header = {
+            .magic = RPC_STORAGE_MD5_CACHE_MAGIC,
+            .version = RPC_STORAGE_MD5_CACHE_VERSION,
+            .dir_path_length = furi_string_size(dir->dir_path),
+        };
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(storage_file_write(
+               file, furi_string_get_cstr(dir->dir_path), header.dir_path_length) !=
+           header.dir_path_length)
+            break;
+
+        result = true;
+
+        RpcStorageMd5CacheDict_it_t it;
+        for(RpcStorageMd5CacheDict_it(it, dir->entries); !RpcStorageMd5CacheDict_end_p(it);
+            RpcStorageMd5CacheDict_next(it)) {
+            const RpcStorageMd5CacheDict_itref_t* itref = RpcStorageMd5CacheDict_cref(it);
+            if(prune && !itref->value.used) continue;
+
+            size_t name_length = strlen(itref->key);
+            if(name_length > UINT8_MAX) continue;
+
+            RpcStorageMd5CacheRecord record = {
+                .size = itref->value.size,
+                .name_length = name_length,
+            };
+            memcpy(record.md5, itref->value.md5, RPC_STORAGE_MD5_SIZE);
+
+            if(storage_file_write(file, &record, sizeof(record)) != sizeof(record) ||
+               storage_file_write(file, itref->key, name_length) != name_length) {
+                result = false;
+                break;
+            }
+        }
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    if(!result) {
+        // Partially written file may still hold entries we meant to drop
+        storage_simply_remove(storage, furi_string_get_cstr(dir->file_path));
+    }
+
+    return result;
+}
+
+RpcStorageMd5CacheDir*
+    rpc_storage_md5_cache_dir_open(RpcStorageMd5Cache* cache, const char* dir_path) {
+    furi_assert(cache);
+    furi_assert(dir_path);
+
+    RpcStorageMd5CacheDir* dir = malloc(sizeof(RpcStorageMd5CacheDir));
+    dir->cache = cache;
+    dir->dir_path = furi_string_alloc_set(dir_path);
+    dir->dir_hash = rpc_storage_md5_cache_dir_hash(dir_path);
+    dir->file_path = furi_string_alloc_printf(
+        RPC_STORAGE_MD5_CACHE_PATH "/%08lX", dir->dir_hash);
+    RpcStorageMd5CacheDict_init(dir->entries);
+    dir->dirty = false;
+
+    // Without reset stale files may still be there, so work uncached
+    dir->enabled = rpc_storage_md5_cache_reset(cache);
+    if(dir->enabled) {
+        rpc_storage_md5_cache_load(dir);
+    }
+
+    return dir;
+}
+
+void rpc_storage_md5_cache_dir_close(RpcStorageMd5CacheDir* dir, bool prune) {
+    furi_assert(dir);
+    RpcStorageMd5Cache* cache = dir->cache;
+
+    if(dir->enabled && (!dir->dirty || rpc_storage_md5_cache_save(dir, prune))) {
+        // Changes seen by load are on disk now, later ones stay for the next load
+        furi_check(furi_mutex_acquire(cache->mutex, FuriWaitForever) == FuriStatusOk);
+        size_t count = 0;
+        for(size_t i = 0; i < cache->changes_count; i++) {
+            const RpcStorageMd5CacheChange* change = &cache->changes[i];
+            if(change->dir_hash == dir->dir_hash && change->sequence <= dir->sequence) continue;
+            cache->changes[count++] = *change;
+        }
+        cache->changes_count = count;
+        furi_mutex_release(cache->mutex);
+    }
+
+    RpcStorageMd5CacheDict_clear(dir->entries);
+    furi_string_free(dir->file_path);
+    furi_string_free(dir->dir_path);
+    free(dir);
+}
+
+static void
+    rpc_storage_md5_cache_format(const uint8_t md5[RPC_STORAGE_MD5_SIZE], FuriString* output) {
+    furi_string_reset(output);
+    for(size_t i = 0; i < RPC_STORAGE_MD5_SIZE; i++) {
+        furi_string_cat_printf(output, "%02x", md5[i]);
+    }
+}
+
+bool rpc_storage_md5_cache_dir_get(
+    RpcStorageMd5CacheDir* dir,
+    File* file,
+    const char* name,
+    uint64_t size,
+    FuriString* output) {
+    furi_assert(dir);
+    furi_assert(file);
+    furi_assert(name);
+    furi_assert(output);
+
+    bool result = false;
+    RpcStorageMd5CacheEntry* entry = RpcStorageMd5CacheDict_get(dir->entries, name);
+
+    if(entry && entry->size == size) {
+        entry->used = true;
+        rpc_storage_md5_cache_format(entry->md5, output);
+        result = true;
+    } else {
+        FuriString* path = furi_string_alloc();
+        path_concat(furi_string_get_cstr(dir->dir_path), name, path);
+
+        RpcStorageMd5CacheEntry new_entry = {
+            .size = size,
+            .used = true,
+        };
+        result = md5_calc_file(file, furi_string_get_cstr(path), new_entry.md5, NULL);
+        if(result) {
+            rpc_storage_md5_cache_format(new_entry.md5, output);
+            if(dir->enabled) {
+                RpcStorageMd5CacheDict_set_at(dir->entries, name, new_entry);
+                dir->dirty = true;
+            }
+        }
+
+        furi_string_free(path);
+    }
+
+    return result;
+}
+
+void rpc_storage_md5_cache_put(
+    RpcStorageMd5Cache* cache,
+    const char* path,
+    const uint8_t md5[RPC_STORAGE_MD5_SIZE]) {
+    furi_assert(cache);
+    furi_assert(path);
+
+    FileInfo fileinfo;
+    if(storage_common_stat(cache->storage, path, &fileinfo) != FSE_OK) return;
+
+    FuriString* dir_path = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+    path_extract_dirname(path, dir_path);
+    path_extract_basename(path, name);
+
+    // Write close has just reported this file, load drops its old entry
+    RpcStorageMd5CacheDir* dir =
+        rpc_storage_md5_cache_dir_open(cache, furi_string_get_cstr(dir_path));
+    if(dir->enabled) {
+        RpcStorageMd5CacheEntry entry = {
+            .size = fileinfo.size,
+            .used = true,
+        };
+        memcpy(entry.md5, md5, RPC_STORAGE_MD5_SIZE);
+        RpcStorageMd5CacheDict_set_at(dir->entries, furi_string_get_cstr(name), entry);
+        dir->dirty = true;
+    }
+    rpc_storage_md5_cache_dir_close(dir, false);
+
+    furi_string_free(name);
+    furi_string_free(dir_path);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Hidden directory holding cache files, one per listed directory */
+#define RPC_STORAGE_MD5_CACHE_PATH CACHE_PATH("rpc_md5")
+
+#define RPC_STORAGE_MD5_SIZE (16)
+
+/** MD5 cache for RPC storage listings
+ *
+ * Entries are keyed by file name and validated by file size. Storage
+ * service reports every file that was written or removed, such files are
+ * dropped from cache before the next lookup. Whole cache is dropped on card
+ * mount and on first use after boot, since card could be changed elsewhere.
+ */
+typedef struct RpcStorageMd5Cache RpcStorageMd5Cache;
+
+/** Cache of one directory, open for the duration of a listing */
+typedef struct RpcStorageMd5CacheDir RpcStorageMd5CacheDir;
+
+/** Allocate cache and subscribe to storage events
+ *
+ * @param      storage  Storage instance
+ *
+ * @return     RpcStorageMd5Cache instance
+ */
+RpcStorageMd5Cache* rpc_storage_md5_cache_alloc(Storage* storage);
+
+/** Open directory cache and load persisted entries
+ *
+ * @param      cache     RpcStorageMd5Cache instance
+ * @param      dir_path  directory path
+ *
+ * @return     RpcStorageMd5CacheDir instance
+ */
+RpcStorageMd5CacheDir*
+    rpc_storage_md5_cache_dir_open(RpcStorageMd5Cache* cache, const char* dir_path);
+
+/** Save directory cache if it was modified and close it
+ *
+ * @param      dir    RpcStorageMd5CacheDir instance
+ * @param      prune  drop entries that were not looked up since opening
+ */
+void rpc_storage_md5_cache_dir_close(RpcStorageMd5CacheDir* dir, bool prune);
+
+/** Get MD5 of a file in directory, calculating it on cache miss
+ *
+ * @param      dir     RpcStorageMd5CacheDir instance
+ * @param      file    File instance used for calculation
+ * @param      name    file name inside directory
+ * @param      size    current file size
+ * @param      output  hex string output
+ *
+ * @return     true on success
+ */
+bool rpc_storage_md5_cache_dir_get(
+    RpcStorageMd5CacheDir* dir,
+    File* file,
+    const char* name,
+    uint64_t size,
+    FuriString* output);
+
+/** Store already known MD5 of a file, e.g. one computed while writing it
+ *
+ * @param      cache  RpcStorageMd5Cache instance
+ * @param      path   full file path
+ * @param      md5    file MD5
+ */
+void rpc_storage_md5_cache_put(
+    RpcStorageMd5Cache* cache,
+    const char* path,
+    const uint8_t md5[RPC_STORAGE_MD5_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
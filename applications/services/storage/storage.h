@@ -13,6 +13,7 @@ extern "C" {
 #define STORAGE_APP_DATA_PATH_PREFIX "/data"
 #define STORAGE_APP_ASSETS_PATH_PREFIX "/assets"
 #define STORAGE_CFG_PATH_PREFIX STORAGE_EXT_PATH_PREFIX "/.config"
+#define STORAGE_CACHE_PATH_PREFIX STORAGE_EXT_PATH_PREFIX "/.cache"
 
 #define INT_PATH(path) STORAGE_INT_PATH_PREFIX "/" path
 #define EXT_PATH(path) STORAGE_EXT_PATH_PREFIX "/" path
@@ -20,6 +21,7 @@ extern "C" {
 #define APP_DATA_PATH(path) STORAGE_APP_DATA_PATH_PREFIX "/" path
 #define APP_ASSETS_PATH(path) STORAGE_APP_ASSETS_PATH_PREFIX "/" path
 #define CFG_PATH(path) STORAGE_CFG_PATH_PREFIX "/" path
+#define CACHE_PATH(path) STORAGE_CACHE_PATH_PREFIX "/" path
 
 #define RECORD_STORAGE "storage"
 
@@ -40,15 +42,18 @@ typedef enum {
     StorageEventTypeCardMountError,
     StorageEventTypeFileClose,
     StorageEventTypeDirClose,
+    StorageEventTypeFileModified, /**< File opened for writing was closed or file was removed */
 } StorageEventType;
 
 typedef struct {
     StorageEventType type;
+    const char* path; /**< Modified file path, valid only during the callback */
 } StorageEvent;
 
 /**
  * Get storage pubsub.
  * Storage will send StorageEvent messages.
+ * Callbacks run in storage thread and must not call storage API.
  * @param storage 
  * @return FuriPubSub* 
  */
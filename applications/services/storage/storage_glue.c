@@ -9,18 +9,21 @@ void storage_file_init(StorageFile* obj) {
     obj->file = NULL;
     obj->file_data = NULL;
     obj->path = furi_string_alloc();
+    obj->write = false;
 }
 
 void storage_file_init_set(StorageFile* obj, const StorageFile* src) {
     obj->file = src->file;
     obj->file_data = src->file_data;
     obj->path = furi_string_alloc_set(src->path);
+    obj->write = src->write;
 }
 
 void storage_file_set(StorageFile* obj, const StorageFile* src) { //-V524
     obj->file = src->file;
     obj->file_data = src->file_data;
     furi_string_set(obj->path, src->path);
+    obj->write = src->write;
 }
 
 void storage_file_clear(StorageFile* obj) {
@@ -126,11 +129,12 @@ void* storage_get_storage_file_data(const File* file, StorageData* storage) {
     return storage_file_ref->file_data;
 }
 
-void storage_push_storage_file(File* file, FuriString* path, StorageData* storage) {
+void storage_push_storage_file(File* file, FuriString* path, bool write, StorageData* storage) {
     StorageFile* storage_file = StorageFileList_push_new(storage->files);
     file->file_id = (uint32_t)storage_file;
     storage_file->file = file;
     furi_string_set(storage_file->path, path);
+    storage_file->write = write;
 }
 
 bool storage_pop_storage_file(File* file, StorageData* storage) {
@@ -152,6 +156,18 @@ bool storage_pop_storage_file(File* file, StorageData* storage) {
     return result;
 }
 
+bool storage_get_storage_file_write_path(
+    const File* file,
+    FuriString* path,
+    StorageData* storage) {
+    StorageFile* storage_file_ref = storage_get_file(file, storage);
+    bool write = storage_file_ref && storage_file_ref->write;
+    if(write) {
+        furi_string_set(path, storage_file_ref->path);
+    }
+    return write;
+}
+
 size_t storage_open_files_count(StorageData* storage) {
     size_t count = StorageFileList_size(storage->files);
     return count;
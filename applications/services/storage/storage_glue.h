@@ -20,6 +20,7 @@ typedef struct {
     File* file;
     void* file_data;
     FuriString* path;
+    bool write; /**< opened with write access */
 } StorageFile;
 
 typedef enum {
@@ -65,8 +66,9 @@ bool storage_path_already_open(FuriString* path, StorageData* storage_data);
 void storage_set_storage_file_data(const File* file, void* file_data, StorageData* storage);
 void* storage_get_storage_file_data(const File* file, StorageData* storage);
 
-void storage_push_storage_file(File* file, FuriString* path, StorageData* storage);
+void storage_push_storage_file(File* file, FuriString* path, bool write, StorageData* storage);
 bool storage_pop_storage_file(File* file, StorageData* storage);
+bool storage_get_storage_file_write_path(const File* file, FuriString* path, StorageData* storage);
 
 size_t storage_open_files_count(StorageData* storage);
 
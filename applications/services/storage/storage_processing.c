@@ -98,6 +98,14 @@ FS_Error storage_get_data(Storage* app, FuriString* path, StorageData** storage)
     }
 }
 
+static void storage_process_publish_modified(Storage* app, FuriString* path) {
+    StorageEvent event = {
+        .type = StorageEventTypeFileModified,
+        .path = furi_string_get_cstr(path),
+    };
+    furi_pubsub_publish(app->pubsub, &event);
+}
+
 /******************* File Functions *******************/
 
 bool storage_process_file_open(
@@ -117,7 +125,7 @@ bool storage_process_file_open(
             if(access_mode & FSAM_WRITE) {
                 storage_data_timestamp(storage);
             }
-            storage_push_storage_file(file, path, storage);
+            storage_push_storage_file(file, path, access_mode & FSAM_WRITE, storage);
 
             const char* path_cstr_no_vfs = cstr_path_without_vfs_prefix(path);
             FS_CALL(storage, file.open(storage, file, path_cstr_no_vfs, access_mode, open_mode));
@@ -134,11 +142,19 @@ bool storage_process_file_close(Storage* app, File* file) {
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
+        FuriString* path = furi_string_alloc();
+        bool write = storage_get_storage_file_write_path(file, path, storage);
+
         FS_CALL(storage, file.close(storage, file));
         storage_pop_storage_file(file, storage);
 
         StorageEvent event = {.type = StorageEventTypeFileClose};
         furi_pubsub_publish(app->pubsub, &event);
+
+        if(write) {
+            storage_process_publish_modified(app, path);
+        }
+        furi_string_free(path);
     }
 
     return ret;
@@ -284,7 +300,7 @@ bool storage_process_dir_open(Storage* app, File* file, FuriString* path) {
         if(storage_path_already_open(path, storage)) {
             file->error_id = FSE_ALREADY_OPEN;
         } else {
-            storage_push_storage_file(file, path, storage);
+            storage_push_storage_file(file, path, false, storage);
             FS_CALL(storage, dir.open(storage, file, cstr_path_without_vfs_prefix(path)));
         }
     }
@@ -377,6 +393,10 @@ static FS_Error storage_process_common_remove(Storage* app, FuriString* path) {
 
         storage_data_timestamp(storage);
         FS_CALL(storage, common.remove(storage, cstr_path_without_vfs_prefix(path)));
+
+        if(ret == FSE_OK) {
+            storage_process_publish_modified(app, path);
+        }
     } while(false);
 
     return ret;
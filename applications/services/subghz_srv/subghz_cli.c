@@ -9,6 +9,7 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_capture_index.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <applications/drivers/subghz/cc1101_ext/cc1101_ext_interconnect.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
@@ -30,6 +31,10 @@
 
 #define TAG "SubGhzCli"
 
+#define SUBGHZ_CLI_MATCH_MAX 5
+#define SUBGHZ_CLI_MATCH_MIN_SCORE 50
+#define SUBGHZ_CLI_MATCH_PENDING_MAX 4
+
 static void subghz_cli_radio_device_power_on() {
     uint8_t attempts = 5;
     while(--attempts > 0) {
@@ -261,8 +266,62 @@ typedef struct {
     volatile bool overrun;
     FuriStreamBuffer* stream;
     size_t packet_count;
+
+    // Live matching against saved captures, only when index exists.
+    // Decoder only queues fingerprints, index is read when stream is idle.
+    Storage* storage;
+    SubGhzRadioPreset preset;
+    SubGhzCaptureIndexMatch* matches;
+    FuriMessageQueue* fingerprints;
+    size_t fingerprints_dropped;
 } SubGhzCliCommandRx;
 
+static void subghz_cli_print_matches(
+    const SubGhzCaptureIndexMatch* matches,
+    size_t match_count,
+    uint32_t time) {
+    printf("Matches %zu, %lums\r\n", match_count, time);
+    for(size_t i = 0; i < match_count; i++) {
+        printf("\t%3u%%\t%s\r\n", matches[i].score, matches[i].path);
+    }
+}
+
+static void subghz_cli_command_rx_match_queue(
+    SubGhzCliCommandRx* instance,
+    SubGhzProtocolDecoderBase* decoder_base) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    SubGhzCaptureFingerprint fingerprint;
+
+    if(subghz_protocol_decoder_base_serialize(decoder_base, flipper_format, &instance->preset) ==
+           SubGhzProtocolStatusOk &&
+       subghz_capture_fingerprint_load(flipper_format, &fingerprint)) {
+        if(furi_message_queue_put(instance->fingerprints, &fingerprint, 0) != FuriStatusOk) {
+            instance->fingerprints_dropped++;
+        }
+    }
+
+    flipper_format_free(flipper_format);
+}
+
+static bool subghz_cli_command_rx_match(SubGhzCliCommandRx* instance) {
+    SubGhzCaptureFingerprint fingerprint;
+    if(furi_message_queue_get(instance->fingerprints, &fingerprint, 0) != FuriStatusOk) {
+        return false;
+    }
+
+    uint32_t start = furi_get_tick();
+    size_t match_count = subghz_capture_index_query(
+        instance->storage,
+        SUBGHZ_RAW_FOLDER,
+        &fingerprint,
+        SUBGHZ_CLI_MATCH_MIN_SCORE,
+        instance->matches,
+        SUBGHZ_CLI_MATCH_MAX);
+    subghz_cli_print_matches(instance->matches, match_count, furi_get_tick() - start);
+
+    return true;
+}
+
 static void subghz_cli_command_rx_capture_callback(bool level, uint32_t duration, void* context) {
     SubGhzCliCommandRx* instance = context;
 
@@ -285,9 +344,10 @@ static void subghz_cli_command_rx_callback(
 
     FuriString* text = furi_string_alloc();
     subghz_protocol_decoder_base_get_string(decoder_base, text);
-    subghz_receiver_reset(receiver);
     printf("%s", furi_string_get_cstr(text));
     furi_string_free(text);
+    if(instance->matches) subghz_cli_command_rx_match_queue(instance, decoder_base);
+    subghz_receiver_reset(receiver);
 }
 
 void subghz_cli_command_rx(Cli* cli, FuriString* args, void* context) {
@@ -342,6 +402,16 @@ void subghz_cli_command_rx(Cli* cli, FuriString* args, void* context) {
     subghz_devices_load_preset(device, FuriHalSubGhzPresetOok650Async, NULL);
     frequency = subghz_devices_set_frequency(device, frequency);
 
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->preset.name = furi_string_alloc_set("AM650");
+    instance->preset.frequency = frequency;
+    if(storage_file_exists(
+           instance->storage, SUBGHZ_RAW_FOLDER "/" SUBGHZ_CAPTURE_INDEX_FILE_NAME)) {
+        instance->matches = malloc(sizeof(SubGhzCaptureIndexMatch) * SUBGHZ_CLI_MATCH_MAX);
+        instance->fingerprints = furi_message_queue_alloc(
+            SUBGHZ_CLI_MATCH_PENDING_MAX, sizeof(SubGhzCaptureFingerprint));
+    }
+
     furi_hal_power_suppress_charge_enter();
 
     // Prepare and start RX
@@ -365,6 +435,9 @@ void subghz_cli_command_rx(Cli* cli, FuriString* args, void* context) {
                 uint32_t duration = level_duration_get_duration(level_duration);
                 subghz_receiver_decode(receiver, level, duration);
             }
+        } else if(instance->matches) {
+            // Stream is idle, SD access won't stall decoding now
+            subghz_cli_command_rx_match(instance);
         }
     }
 
@@ -378,11 +451,22 @@ void subghz_cli_command_rx(Cli* cli, FuriString* args, void* context) {
     furi_hal_power_suppress_charge_exit();
 
     printf("\r\nPackets received %zu\r\n", instance->packet_count);
+    if(instance->matches) {
+        while(subghz_cli_command_rx_match(instance))
+            ;
+        if(instance->fingerprints_dropped) {
+            printf("Not matched, busy: %zu\r\n", instance->fingerprints_dropped);
+        }
+    }
 
     // Cleanup
     subghz_receiver_free(receiver);
     subghz_environment_free(environment);
     furi_stream_buffer_free(instance->stream);
+    free(instance->matches);
+    if(instance->fingerprints) furi_message_queue_free(instance->fingerprints);
+    furi_string_free(instance->preset.name);
+    furi_record_close(RECORD_STORAGE);
     free(instance);
 }
 
@@ -573,6 +657,81 @@ void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
     furi_string_free(file_name);
 }
 
+static void subghz_cli_command_index(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    FuriString* dir_path = furi_string_alloc_set(SUBGHZ_RAW_FOLDER);
+    if(furi_string_size(args)) {
+        args_read_string_and_trim(args, dir_path);
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    SubGhzCaptureIndexBuildStats stats;
+    printf("Indexing %s\r\n", furi_string_get_cstr(dir_path));
+    if(subghz_capture_index_build(storage, furi_string_get_cstr(dir_path), &stats)) {
+        printf(
+            "Indexed %zu captures, parsed %zu, failed %zu in %lums\r\n",
+            stats.files,
+            stats.parsed,
+            stats.failed,
+            stats.time);
+    } else {
+        printf("subghz index \033[0;31mError building index\033[0m\r\n");
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    furi_string_free(dir_path);
+}
+
+static void subghz_cli_command_match(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    FuriString* file_name = furi_string_alloc();
+    FuriString* dir_path = furi_string_alloc_set(SUBGHZ_RAW_FOLDER);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    SubGhzCaptureIndexMatch* matches =
+        malloc(sizeof(SubGhzCaptureIndexMatch) * SUBGHZ_CLI_MATCH_MAX);
+
+    do {
+        if(!args_read_string_and_trim(args, file_name)) {
+            cli_print_usage(
+                "subghz match", "<file_name: path_file> <dir: path>", furi_string_get_cstr(args));
+            break;
+        }
+        if(furi_string_size(args)) {
+            args_read_string_and_trim(args, dir_path);
+        }
+
+        uint32_t start = furi_get_tick();
+        SubGhzCaptureFingerprint fingerprint;
+        if(!flipper_format_file_open_existing(flipper_format, furi_string_get_cstr(file_name)) ||
+           !subghz_capture_fingerprint_load(flipper_format, &fingerprint)) {
+            printf(
+                "subghz match \033[0;31mError reading capture\033[0m %s\r\n",
+                furi_string_get_cstr(file_name));
+            break;
+        }
+
+        size_t match_count = subghz_capture_index_query(
+            storage,
+            furi_string_get_cstr(dir_path),
+            &fingerprint,
+            SUBGHZ_CLI_MATCH_MIN_SCORE,
+            matches,
+            SUBGHZ_CLI_MATCH_MAX);
+        subghz_cli_print_matches(matches, match_count, furi_get_tick() - start);
+    } while(false);
+
+    free(matches);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+
+    furi_string_free(dir_path);
+    furi_string_free(file_name);
+}
+
 static void subghz_cli_command_print_usage() {
     printf("Usage:\r\n");
     printf("subghz <cmd> <args>\r\n");
@@ -585,6 +744,8 @@ static void subghz_cli_command_print_usage() {
     printf("\trx <frequency:in Hz> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Receive\r\n");
     printf("\trx_raw <frequency:in Hz>\t - Receive RAW\r\n");
     printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
+    printf("\tindex <dir: path>\t - Index saved captures for matching\r\n");
+    printf("\tmatch <file_name: path_file> <dir: path>\t - Find similar saved captures\r\n");
 
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
         printf("\r\n");
@@ -898,6 +1059,16 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "index") == 0) {
+            subghz_cli_command_index(cli, args, context);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "match") == 0) {
+            subghz_cli_command_match(cli, args, context);
+            break;
+        }
+
         if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
             if(furi_string_cmp_str(cmd, "encrypt_keeloq") == 0) {
                 subghz_cli_command_encrypt_keeloq(cli, args);
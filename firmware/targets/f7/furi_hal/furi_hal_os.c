@@ -5,6 +5,8 @@
 #include <furi_hal_gpio.h>
 #include <furi_hal_resources.h>
 #include <furi_hal_idle_timer.h>
+#include <furi_hal_profiler.h>
+#include <furi_hal_cortex.h>
 
 #include <stm32wbxx_ll_cortex.h>
 
@@ -76,6 +78,10 @@ void furi_hal_os_tick() {
         furi_hal_gpio_write(
             FURI_HAL_OS_DEBUG_TICK_GPIO, !furi_hal_gpio_read(FURI_HAL_OS_DEBUG_TICK_GPIO));
 #endif
+        // Keep 64 bit cycle counter from missing a wrap
+        furi_hal_cortex_get_cycles();
+        // Before the tick handler switches context
+        furi_hal_profiler_tick();
         xPortSysTickHandler();
     }
 }
@@ -197,6 +203,7 @@ void vPortSuppressTicksAndSleep(TickType_t expected_idle_ticks) {
                 completed_ticks = expected_idle_ticks;
             }
             vTaskStepTick(completed_ticks);
+            furi_hal_profiler_sleep(completed_ticks);
         }
     } while(0);
     // Reenable IRQ
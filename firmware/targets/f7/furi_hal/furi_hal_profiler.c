@@ -0,0 +1,111 @@
+#include <furi_hal_profiler.h>
+#include <furi.h>
+
+#include <stm32wbxx.h>
+#include <FreeRTOS.h>
+#include <task.h>
+
+/* Hardware stacked exception frame: r0-r3, r12, lr, pc, xpsr */
+#define FURI_HAL_PROFILER_FRAME_LR (5)
+#define FURI_HAL_PROFILER_FRAME_PC (6)
+
+typedef struct {
+    FuriHalProfilerSample* buffer;
+    size_t size;
+    volatile size_t head; /* written by the tick interrupt only */
+    volatile size_t tail; /* written by the reader only */
+    volatile bool running;
+    FuriHalProfilerStats stats;
+} FuriHalProfiler;
+
+static FuriHalProfiler furi_hal_profiler = {0};
+
+void furi_hal_profiler_start(FuriHalProfilerSample* buffer, size_t size) {
+    furi_check(buffer);
+    furi_check(size > 1);
+
+    FURI_CRITICAL_ENTER();
+    furi_check(!furi_hal_profiler.running);
+    furi_hal_profiler.buffer = buffer;
+    furi_hal_profiler.size = size;
+    furi_hal_profiler.head = 0;
+    furi_hal_profiler.tail = 0;
+    memset(&furi_hal_profiler.stats, 0, sizeof(FuriHalProfilerStats));
+    furi_hal_profiler.running = true;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_profiler_stop() {
+    FURI_CRITICAL_ENTER();
+    furi_hal_profiler.running = false;
+    furi_hal_profiler.buffer = NULL;
+    FURI_CRITICAL_EXIT();
+}
+
+bool furi_hal_profiler_is_running() {
+    return furi_hal_profiler.running;
+}
+
+size_t furi_hal_profiler_read(FuriHalProfilerSample* samples, size_t count) {
+    furi_assert(samples);
+
+    if(!furi_hal_profiler.running) return 0;
+
+    size_t head = furi_hal_profiler.head;
+    size_t tail = furi_hal_profiler.tail;
+    size_t read = 0;
+
+    while(tail != head && read < count) {
+        samples[read++] = furi_hal_profiler.buffer[tail];
+        tail = (tail + 1) % furi_hal_profiler.size;
+    }
+
+    // Slots must be copied before the interrupt may reuse them
+    __DMB();
+    furi_hal_profiler.tail = tail;
+
+    return read;
+}
+
+void furi_hal_profiler_get_stats(FuriHalProfilerStats* stats) {
+    furi_assert(stats);
+
+    FURI_CRITICAL_ENTER();
+    *stats = furi_hal_profiler.stats;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_profiler_tick() {
+    if(!furi_hal_profiler.running) return;
+
+    size_t head = furi_hal_profiler.head;
+    size_t next = (head + 1) % furi_hal_profiler.size;
+    if(next == furi_hal_profiler.tail) {
+        furi_hal_profiler.stats.dropped++;
+        return;
+    }
+
+    FuriHalProfilerSample* sample = &furi_hal_profiler.buffer[head];
+    // Tick has the lowest priority, so normally it preempts thread code only
+    if(SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) {
+        // Threads run on the process stack, it holds the frame of the interrupted code
+        uint32_t* frame = (uint32_t*)__get_PSP();
+        sample->pc = frame[FURI_HAL_PROFILER_FRAME_PC];
+        sample->lr = frame[FURI_HAL_PROFILER_FRAME_LR];
+        sample->thread = (uint32_t)xTaskGetCurrentTaskHandle();
+    } else {
+        sample->pc = 0;
+        sample->lr = 0;
+        sample->thread = 0;
+    }
+
+    __DMB();
+    furi_hal_profiler.head = next;
+    furi_hal_profiler.stats.samples++;
+}
+
+void furi_hal_profiler_sleep(uint32_t ticks) {
+    if(!furi_hal_profiler.running) return;
+
+    furi_hal_profiler.stats.sleep_ticks += ticks;
+}
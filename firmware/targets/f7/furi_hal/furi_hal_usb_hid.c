@@ -308,6 +308,91 @@ bool furi_hal_hid_kb_release_all() {
     return hid_send_report(ReportIdKeyboard);
 }
 
+static bool hid_kb_type_send(const uint8_t* keys, size_t count, uint8_t mods, uint32_t interval) {
+    // Held keys occupy their slots, typed ones go to the free ones
+    for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
+        if(hid_report.keyboard.boot.btn[key_nb] == 0 && count > 0) {
+            hid_report.keyboard.boot.btn[key_nb] = *keys++;
+            count--;
+        }
+    }
+    hid_report.keyboard.boot.mods |= mods;
+
+    bool state = hid_send_report(ReportIdKeyboard);
+    if(interval) furi_delay_ms(interval);
+    return state;
+}
+
+size_t furi_hal_hid_kb_type(
+    const uint16_t* keys,
+    size_t count,
+    HidKbTypeMode mode,
+    uint32_t interval) {
+    furi_assert(keys);
+
+    uint8_t held_mods = hid_report.keyboard.boot.mods;
+    uint8_t held_btn[HID_KB_MAX_KEYS];
+    memcpy(held_btn, hid_report.keyboard.boot.btn, sizeof(held_btn));
+
+    size_t free_slots = 0;
+    for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
+        if(held_btn[key_nb] == 0) free_slots++;
+    }
+    if(free_slots == 0) return 0;
+
+    size_t group_max = (mode == HidKbTypeModePacked) ? free_slots : 1;
+    uint8_t group[HID_KB_MAX_KEYS];
+    uint8_t prev[HID_KB_MAX_KEYS];
+    size_t prev_count = 0;
+    uint8_t prev_mods = 0;
+    size_t typed = 0;
+
+    while(typed < count) {
+        // Keys sharing a report must have the same modifiers and be distinct
+        uint8_t mods = keys[typed] >> 8;
+        size_t group_count = 0;
+        while((typed + group_count < count) && (group_count < group_max)) {
+            uint16_t key = keys[typed + group_count];
+            if((key >> 8) != mods) break;
+            if(memchr(group, key & 0xFF, group_count)) break;
+            group[group_count++] = key & 0xFF;
+        }
+
+        // Keys still down from the previous report would not be pressed again
+        bool release = (prev_count > 0) &&
+                       ((mode == HidKbTypeModeNormal) || (mods != prev_mods));
+        for(size_t i = 0; (i < group_count) && !release; i++) {
+            release = (memchr(prev, group[i], prev_count) != NULL);
+        }
+        if(release) {
+            memcpy(hid_report.keyboard.boot.btn, held_btn, sizeof(held_btn));
+            hid_report.keyboard.boot.mods = held_mods;
+            if(!hid_kb_type_send(NULL, 0, 0, interval)) break;
+        }
+
+        memcpy(hid_report.keyboard.boot.btn, held_btn, sizeof(held_btn));
+        hid_report.keyboard.boot.mods = held_mods;
+        if(!hid_kb_type_send(group, group_count, mods, interval)) {
+            prev_count = 0;
+            break;
+        }
+
+        memcpy(prev, group, group_count);
+        prev_count = group_count;
+        prev_mods = mods;
+        typed += group_count;
+    }
+
+    memcpy(hid_report.keyboard.boot.btn, held_btn, sizeof(held_btn));
+    hid_report.keyboard.boot.mods = held_mods;
+    if(typed < count || prev_count > 0) {
+        // Also tries to release keys if the host stopped polling in between
+        hid_kb_type_send(NULL, 0, 0, interval);
+    }
+
+    return typed;
+}
+
 bool furi_hal_hid_mouse_move(int8_t dx, int8_t dy) {
     hid_report.mouse.x = dx;
     hid_report.mouse.y = dy;
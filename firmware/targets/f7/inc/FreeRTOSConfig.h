@@ -27,7 +27,8 @@ extern uint32_t SystemCoreClock;
 /* Heap size determined automatically by linker */
 // #define configTOTAL_HEAP_SIZE                    ((size_t)0)
 #define configMAX_TASK_NAME_LEN (32)
-#define configGENERATE_RUN_TIME_STATS 0
+#define configGENERATE_RUN_TIME_STATS 1
+#define configRUN_TIME_COUNTER_TYPE uint64_t
 #define configUSE_TRACE_FACILITY 1
 #define configUSE_16_BIT_TICKS 0
 #define configUSE_MUTEXES 1
@@ -78,7 +79,7 @@ to exclude the API function. */
 #define INCLUDE_xTimerPendFunctionCall 1
 
 /* Furi-specific */
-#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
 
 extern __attribute__((__noreturn__)) void furi_thread_catch();
 #define configTASK_RETURN_ADDRESS (furi_thread_catch + 2)
@@ -136,9 +137,48 @@ standard names. */
 #define configOVERRIDE_DEFAULT_TICK_CONFIGURATION \
     1 /* required only for Keil but does not hurt otherwise */
 
-#define traceTASK_SWITCHED_IN()                                     \
-    extern void furi_hal_mpu_set_stack_protection(uint32_t* stack); \
-    furi_hal_mpu_set_stack_protection((uint32_t*)pxCurrentTCB->pxStack)
+/* Run time is counted in CPU cycles, DWT is started by furi_hal_cortex_init_early */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE() furi_hal_cortex_get_cycles()
+extern uint64_t furi_hal_cortex_get_cycles();
+
+#define traceTASK_SWITCHED_IN()                                                  \
+    extern void furi_hal_mpu_set_stack_protection(uint32_t* stack);              \
+    extern void furi_thread_trace_switched_in(void* thread);                     \
+    furi_hal_mpu_set_stack_protection((uint32_t*)pxCurrentTCB->pxStack);         \
+    furi_thread_trace_switched_in(pxCurrentTCB->pvThreadLocalStoragePointers[0])
+
+/* Only wake ups matter for latency, not preemption of the running task */
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB)                              \
+    extern void furi_thread_trace_ready(void* thread);                     \
+    if((pxTCB) != pxCurrentTCB) {                                          \
+        furi_thread_trace_ready((pxTCB)->pvThreadLocalStoragePointers[0]); \
+    }
+
+/* Event loop subscribed to the object is kept in its trace number */
+#define traceQUEUE_SEND(pxQueue)                                     \
+    extern void furi_event_loop_trace_send(void* event_loop);        \
+    if((pxQueue)->uxQueueNumber) {                                   \
+        furi_event_loop_trace_send((void*)(pxQueue)->uxQueueNumber); \
+    }
+
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)                            \
+    extern void furi_event_loop_trace_send(void* event_loop);        \
+    if((pxQueue)->uxQueueNumber) {                                   \
+        furi_event_loop_trace_send((void*)(pxQueue)->uxQueueNumber); \
+    }
+
+#define traceSTREAM_BUFFER_SEND(xStreamBuffer, xBytesSent)                     \
+    extern void furi_event_loop_trace_stream_buffer_send(void* stream_buffer); \
+    if((xStreamBuffer)->uxStreamBufferNumber) {                                \
+        furi_event_loop_trace_stream_buffer_send(xStreamBuffer);               \
+    }
+
+#define traceSTREAM_BUFFER_SEND_FROM_ISR(xStreamBuffer, xBytesSent)            \
+    extern void furi_event_loop_trace_stream_buffer_send(void* stream_buffer); \
+    if((xStreamBuffer)->uxStreamBufferNumber) {                                \
+        furi_event_loop_trace_stream_buffer_send(xStreamBuffer);               \
+    }
 
 #define portCLEAN_UP_TCB(pxTCB)                                   \
     extern void furi_thread_cleanup_tcb_event(TaskHandle_t task); \
@@ -18,6 +18,7 @@ struct STOP_EXTERNING_ME {};
 #include <furi_hal_debug.h>
 #include <furi_hal_dma.h>
 #include <furi_hal_os.h>
+#include <furi_hal_profiler.h>
 #include <furi_hal_sd.h>
 #include <furi_hal_i2c.h>
 #include <furi_hal_region.h>
@@ -28,6 +28,16 @@ void furi_hal_cortex_init_early();
  */
 void furi_hal_cortex_delay_us(uint32_t microseconds);
 
+/** Get 64 bit CPU cycles counter
+ *
+ * Extends DWT cycle counter, which wraps every minute or so. Must be called
+ * at least once per wrap period to notice it, OS tick takes care of that.
+ * Counter doesn't advance while the core is in stop mode.
+ *
+ * @return     CPU cycles since boot
+ */
+uint64_t furi_hal_cortex_get_cycles();
+
 /** Get instructions per microsecond count
  *
  * @return     instructions per microsecond count
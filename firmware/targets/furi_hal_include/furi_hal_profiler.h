@@ -0,0 +1,79 @@
+/**
+ * @file furi_hal_profiler.h
+ * Sampling profiler HAL API
+ *
+ * Every OS tick interrupted program counter and thread are put into a ring,
+ * the consumer thread drains it with furi_hal_profiler_read. Time spent in
+ * tickless sleep isn't sampled, it is counted separately.
+ *
+ * @warning    Samples are locked to SysTick, there is no spare timer to sample
+ *             from independently. Work that runs in phase with the tick, like
+ *             code woken by it or periodic with a multiple of its period, is
+ *             over- or under-represented. Use results as an estimate.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t pc; /**< interrupted instruction, 0 if an interrupt was running */
+    uint32_t lr; /**< link register of the interrupted code, usually its caller */
+    uint32_t thread; /**< FuriThreadId of the interrupted thread, 0 if an interrupt was running */
+} FuriHalProfilerSample;
+
+typedef struct {
+    uint32_t samples; /**< samples put into the ring */
+    uint32_t dropped; /**< samples lost because the ring was full */
+    uint32_t sleep_ticks; /**< ticks spent in tickless sleep */
+} FuriHalProfilerStats;
+
+/** Start sampling
+ *
+ * @param      buffer  ring for samples, must be valid until furi_hal_profiler_stop
+ * @param[in]  size    ring size in samples, one is always kept free
+ */
+void furi_hal_profiler_start(FuriHalProfilerSample* buffer, size_t size);
+
+/** Stop sampling */
+void furi_hal_profiler_stop();
+
+/** Check if sampling is running
+ *
+ * @return     true if running
+ */
+bool furi_hal_profiler_is_running();
+
+/** Take samples out of the ring
+ *
+ * @param[out] samples  array to fill
+ * @param[in]  count    samples array size
+ *
+ * @return     number of samples read
+ */
+size_t furi_hal_profiler_read(FuriHalProfilerSample* samples, size_t count);
+
+/** Get counters since furi_hal_profiler_start
+ *
+ * @param[out] stats  FuriHalProfilerStats to fill
+ */
+void furi_hal_profiler_get_stats(FuriHalProfilerStats* stats);
+
+/** Take a sample, called by the OS tick interrupt */
+void furi_hal_profiler_tick();
+
+/** Count ticks skipped by tickless sleep
+ *
+ * @param[in]  ticks  slept ticks
+ */
+void furi_hal_profiler_sleep(uint32_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,5 @@
 #pragma once
+#include <stddef.h>
 #include "hid_usage_desktop.h"
 #include "hid_usage_button.h"
 #include "hid_usage_keyboard.h"
@@ -184,6 +185,13 @@ enum HidKeyboardLeds {
     HID_KB_LED_SCROLL = (1 << 2),
 };
 
+/** HID keyboard typing modes */
+typedef enum {
+    HidKbTypeModeNormal, /**< Press and release report for each key */
+    HidKbTypeModeCollapse, /**< Next key press replaces release of the previous one */
+    HidKbTypeModePacked, /**< Up to HID_KB_MAX_KEYS distinct keys in one report */
+} HidKbTypeMode;
+
 /** HID mouse buttons */
 enum HidMouseButtons {
     HID_MOUSE_BTN_LEFT = (1 << 0),
@@ -227,6 +235,26 @@ bool furi_hal_hid_kb_release(uint16_t button);
  */
 bool furi_hal_hid_kb_release_all();
 
+/** Type a sequence of keys using as few HID reports as the mode allows
+ *
+ * Keys share a report only if they have the same modifiers and are distinct,
+ * a key repeated in the next report gets released first. Keys held with
+ * furi_hal_hid_kb_press stay pressed. Every report waits for the host to poll
+ * the previous one, so typing stops once the host goes away.
+ *
+ * @param      keys      key codes with modifiers
+ * @param      count     number of keys
+ * @param      mode      typing mode
+ * @param      interval  extra delay after each report in ms, 0 - host polling rate
+ *
+ * @return     number of typed keys, less than count on failure
+ */
+size_t furi_hal_hid_kb_type(
+    const uint16_t* keys,
+    size_t count,
+    HidKbTypeMode mode,
+    uint32_t interval);
+
 /** Set mouse movement and send HID report
  *
  * @param      dx  x coordinate delta
@@ -0,0 +1,367 @@
+#include "event_loop.h"
+#include "common_defines.h"
+#include "check.h"
+#include "kernel.h"
+#include "thread.h"
+#include "pool_queue_i.h"
+
+#include <stdlib.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <FreeRTOS-Kernel/include/stream_buffer.h>
+#include <m-array.h>
+
+// Index 0 is used for stream buffers, 1 for thread flags
+#define FURI_EVENT_LOOP_NOTIFY_INDEX 2
+
+typedef enum {
+    FuriEventLoopFlagEvent = (1 << 0),
+    FuriEventLoopFlagStop = (1 << 1),
+} FuriEventLoopFlag;
+
+typedef enum {
+    FuriEventLoopObjectTypeMessageQueue,
+    FuriEventLoopObjectTypePoolQueue,
+    FuriEventLoopObjectTypeStreamBuffer,
+    FuriEventLoopObjectTypeSemaphore,
+} FuriEventLoopObjectType;
+
+typedef struct {
+    void* object;
+    void* handle; // kernel object: object itself, or queue inside of FuriPoolQueue
+    FuriEventLoopObjectType type;
+    FuriEventLoopEventCallback callback;
+    void* context;
+} FuriEventLoopSubscription;
+
+ARRAY_DEF(FuriEventLoopSubscriptionArray, FuriEventLoopSubscription, M_POD_OPLIST);
+
+ARRAY_DEF(FuriEventLoopTimerArray, FuriEventLoopTimer*, M_PTR_OPLIST);
+
+struct FuriEventLoopTimer {
+    FuriEventLoop* owner;
+    FuriEventLoopTimerCallback callback;
+    void* context;
+    FuriTimerType type;
+
+    uint32_t start;
+    uint32_t interval;
+    bool is_running;
+};
+
+struct FuriEventLoop {
+    FuriThreadId thread_id;
+    FuriEventLoopSubscriptionArray_t subscriptions;
+    FuriEventLoopTimerArray_t timers;
+};
+
+/* Event loop is stored in trace number of the kernel object, kernel trace
+ * hooks read it on every send and wake the loop up */
+static void furi_event_loop_link(FuriEventLoopSubscription* subscription, FuriEventLoop* loop) {
+    FURI_CRITICAL_ENTER();
+    if(subscription->type == FuriEventLoopObjectTypeStreamBuffer) {
+        StreamBufferHandle_t stream_buffer = subscription->handle;
+        furi_check(!loop || !uxStreamBufferGetStreamBufferNumber(stream_buffer));
+        vStreamBufferSetStreamBufferNumber(stream_buffer, (UBaseType_t)loop);
+    } else {
+        QueueHandle_t queue = subscription->handle;
+        furi_check(!loop || !uxQueueGetQueueNumber(queue));
+        vQueueSetQueueNumber(queue, (UBaseType_t)loop);
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+static void furi_event_loop_notify(FuriEventLoop* instance, uint32_t flags) {
+    if(FURI_IS_IRQ_MODE()) {
+        BaseType_t yield = pdFALSE;
+        (void)xTaskNotifyIndexedFromISR(
+            instance->thread_id, FURI_EVENT_LOOP_NOTIFY_INDEX, flags, eSetBits, &yield);
+        portYIELD_FROM_ISR(yield);
+    } else {
+        (void)xTaskNotifyIndexed(
+            instance->thread_id, FURI_EVENT_LOOP_NOTIFY_INDEX, flags, eSetBits);
+    }
+}
+
+/* Called by the kernel on queue and semaphore send, inside critical section */
+void furi_event_loop_trace_send(void* context) {
+    furi_event_loop_notify(context, FuriEventLoopFlagEvent);
+}
+
+/* Called by the kernel on stream buffer send, not in critical section */
+void furi_event_loop_trace_stream_buffer_send(void* stream_buffer) {
+    FURI_CRITICAL_ENTER();
+    FuriEventLoop* instance = (FuriEventLoop*)uxStreamBufferGetStreamBufferNumber(stream_buffer);
+    if(instance) {
+        furi_event_loop_notify(instance, FuriEventLoopFlagEvent);
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+FuriEventLoop* furi_event_loop_alloc() {
+    furi_assert(!FURI_IS_IRQ_MODE());
+
+    FuriEventLoop* instance = malloc(sizeof(FuriEventLoop));
+    instance->thread_id = furi_thread_get_current_id();
+    furi_check(instance->thread_id);
+
+    FuriEventLoopSubscriptionArray_init(instance->subscriptions);
+    FuriEventLoopTimerArray_init(instance->timers);
+
+    return instance;
+}
+
+void furi_event_loop_free(FuriEventLoop* instance) {
+    furi_assert(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    furi_check(FuriEventLoopSubscriptionArray_size(instance->subscriptions) == 0);
+    furi_check(FuriEventLoopTimerArray_size(instance->timers) == 0);
+
+    FuriEventLoopSubscriptionArray_clear(instance->subscriptions);
+    FuriEventLoopTimerArray_clear(instance->timers);
+
+    // Drop a stop request that came after the loop ended
+    (void)xTaskNotifyStateClearIndexed(NULL, FURI_EVENT_LOOP_NOTIFY_INDEX);
+
+    free(instance);
+}
+
+static bool furi_event_loop_is_ready(FuriEventLoopSubscription* subscription) {
+    bool ready = false;
+
+    switch(subscription->type) {
+    case FuriEventLoopObjectTypeMessageQueue:
+    case FuriEventLoopObjectTypePoolQueue:
+        ready = furi_message_queue_get_count(subscription->handle) > 0;
+        break;
+    case FuriEventLoopObjectTypeStreamBuffer:
+        ready = furi_stream_buffer_bytes_available(subscription->object) > 0;
+        break;
+    case FuriEventLoopObjectTypeSemaphore:
+        ready = furi_semaphore_get_count(subscription->object) > 0;
+        break;
+    }
+
+    return ready;
+}
+
+/* Returns true if somebody was called and may still have data */
+static bool furi_event_loop_process_subscriptions(FuriEventLoop* instance) {
+    bool processed = false;
+
+    // Callbacks may unsubscribe, so no iterators here
+    for(size_t i = 0; i < FuriEventLoopSubscriptionArray_size(instance->subscriptions); i++) {
+        FuriEventLoopSubscription subscription =
+            *FuriEventLoopSubscriptionArray_get(instance->subscriptions, i);
+        if(furi_event_loop_is_ready(&subscription)) {
+            subscription.callback(subscription.object, subscription.context);
+            processed = true;
+        }
+    }
+
+    return processed;
+}
+
+/* Returns ticks until the next timer expires */
+static uint32_t furi_event_loop_process_timers(FuriEventLoop* instance) {
+    uint32_t timeout = FuriWaitForever;
+
+    for(size_t i = 0; i < FuriEventLoopTimerArray_size(instance->timers); i++) {
+        FuriEventLoopTimer* timer = *FuriEventLoopTimerArray_get(instance->timers, i);
+        if(!timer->is_running) continue;
+
+        uint32_t elapsed = furi_get_tick() - timer->start;
+        if(elapsed >= timer->interval) {
+            if(timer->type == FuriTimerTypePeriodic) {
+                // Keep period stable, but don't try to catch up after a stall
+                timer->start += timer->interval;
+                if(furi_get_tick() - timer->start >= timer->interval) {
+                    timer->start = furi_get_tick();
+                }
+            } else {
+                timer->is_running = false;
+            }
+
+            timer->callback(timer->context);
+            elapsed = furi_get_tick() - timer->start;
+        }
+
+        if(timer->is_running) {
+            uint32_t remaining = elapsed < timer->interval ? timer->interval - elapsed : 0;
+            timeout = MIN(timeout, remaining);
+        }
+    }
+
+    return timeout;
+}
+
+void furi_event_loop_run(FuriEventLoop* instance) {
+    furi_assert(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    uint32_t timeout = 0;
+    while(true) {
+        uint32_t flags = 0;
+        (void)xTaskNotifyWaitIndexed(
+            FURI_EVENT_LOOP_NOTIFY_INDEX, 0, UINT32_MAX, &flags, (TickType_t)timeout);
+
+        if(flags & FuriEventLoopFlagStop) break;
+
+        timeout = furi_event_loop_process_timers(instance);
+        if(furi_event_loop_process_subscriptions(instance)) {
+            // Level triggered: check again without sleeping
+            timeout = 0;
+        }
+    }
+}
+
+void furi_event_loop_stop(FuriEventLoop* instance) {
+    furi_assert(instance);
+    furi_event_loop_notify(instance, FuriEventLoopFlagStop);
+}
+
+static void furi_event_loop_subscribe(
+    FuriEventLoop* instance,
+    void* object,
+    FuriEventLoopObjectType type,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_assert(instance);
+    furi_assert(object);
+    furi_assert(callback);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    FuriEventLoopSubscription subscription = {
+        .object = object,
+        .handle = object,
+        .type = type,
+        .callback = callback,
+        .context = context,
+    };
+
+    if(type == FuriEventLoopObjectTypePoolQueue) {
+        subscription.handle = furi_pool_queue_get_message_queue(object);
+    }
+
+    furi_event_loop_link(&subscription, instance);
+    FuriEventLoopSubscriptionArray_push_back(instance->subscriptions, subscription);
+
+    // Object may already have data
+    furi_event_loop_notify(instance, FuriEventLoopFlagEvent);
+}
+
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* message_queue,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance, message_queue, FuriEventLoopObjectTypeMessageQueue, callback, context);
+}
+
+void furi_event_loop_subscribe_pool_queue(
+    FuriEventLoop* instance,
+    FuriPoolQueue* pool_queue,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance, pool_queue, FuriEventLoopObjectTypePoolQueue, callback, context);
+}
+
+void furi_event_loop_subscribe_stream_buffer(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance, stream_buffer, FuriEventLoopObjectTypeStreamBuffer, callback, context);
+}
+
+void furi_event_loop_subscribe_semaphore(
+    FuriEventLoop* instance,
+    FuriSemaphore* semaphore,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance, semaphore, FuriEventLoopObjectTypeSemaphore, callback, context);
+}
+
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, void* object) {
+    furi_assert(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    for(size_t i = 0; i < FuriEventLoopSubscriptionArray_size(instance->subscriptions); i++) {
+        FuriEventLoopSubscription* subscription =
+            FuriEventLoopSubscriptionArray_get(instance->subscriptions, i);
+        if(subscription->object == object) {
+            // Kernel would keep notifying a loop that may be gone by then
+            furi_event_loop_link(subscription, NULL);
+            FuriEventLoopSubscriptionArray_remove_v(instance->subscriptions, i, i + 1);
+            return;
+        }
+    }
+
+    furi_crash("Object is not subscribed");
+}
+
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriTimerType type,
+    void* context) {
+    furi_assert(instance);
+    furi_assert(callback);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    FuriEventLoopTimer* timer = malloc(sizeof(FuriEventLoopTimer));
+    timer->owner = instance;
+    timer->callback = callback;
+    timer->type = type;
+    timer->context = context;
+
+    FuriEventLoopTimerArray_push_back(instance->timers, timer);
+
+    return timer;
+}
+
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer) {
+    furi_assert(timer);
+    FuriEventLoop* instance = timer->owner;
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    for(size_t i = 0; i < FuriEventLoopTimerArray_size(instance->timers); i++) {
+        if(*FuriEventLoopTimerArray_get(instance->timers, i) == timer) {
+            FuriEventLoopTimerArray_remove_v(instance->timers, i, i + 1);
+            break;
+        }
+    }
+
+    free(timer);
+}
+
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval) {
+    furi_assert(timer);
+    furi_assert(interval > 0);
+    furi_check(timer->owner->thread_id == furi_thread_get_current_id());
+
+    timer->start = furi_get_tick();
+    timer->interval = interval;
+    timer->is_running = true;
+
+    // Recalculate wait timeout
+    furi_event_loop_notify(timer->owner, FuriEventLoopFlagEvent);
+}
+
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer) {
+    furi_assert(timer);
+    furi_check(timer->owner->thread_id == furi_thread_get_current_id());
+
+    timer->is_running = false;
+}
+
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer) {
+    furi_assert(timer);
+    return timer->is_running;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file event_loop.h
+ * FuriEventLoop
+ *
+ * Waits on several message queues, pool queues, stream buffers, semaphores and timers in
+ * one thread and dispatches callbacks, so lightweight services can share a
+ * thread instead of each spinning its own.
+ *
+ * Events are level triggered: a callback is called while its object has data,
+ * so it must consume at least one item or it is called again right away.
+ * Callbacks run in the loop thread and must not block.
+ */
+#pragma once
+
+#include "core/base.h"
+#include "core/message_queue.h"
+#include "core/pool_queue.h"
+#include "core/semaphore.h"
+#include "core/stream_buffer.h"
+#include "core/timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriEventLoop FuriEventLoop;
+
+typedef struct FuriEventLoopTimer FuriEventLoopTimer;
+
+/** Object event callback
+ *
+ * @param      object   object that has data: FuriMessageQueue, FuriPoolQueue,
+ *                      FuriStreamBuffer or FuriSemaphore
+ * @param      context  callback context
+ */
+typedef void (*FuriEventLoopEventCallback)(void* object, void* context);
+
+/** Timer callback
+ *
+ * @param      context  callback context
+ */
+typedef void (*FuriEventLoopTimerCallback)(void* context);
+
+/** Allocate event loop, it belongs to the current thread
+ *
+ * @return     pointer to FuriEventLoop instance
+ */
+FuriEventLoop* furi_event_loop_alloc();
+
+/** Free event loop
+ *
+ * @warning    all objects must be unsubscribed and all timers freed
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ */
+void furi_event_loop_free(FuriEventLoop* instance);
+
+/** Run event loop until furi_event_loop_stop, owner thread only
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ */
+void furi_event_loop_run(FuriEventLoop* instance);
+
+/** Stop event loop, can be called from any thread or interrupt
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ */
+void furi_event_loop_stop(FuriEventLoop* instance);
+
+/** Subscribe to message queue, callback is called while queue is not empty
+ *
+ * An object can be subscribed to one event loop at a time.
+ *
+ * @param      instance       pointer to FuriEventLoop instance
+ * @param      message_queue  pointer to FuriMessageQueue instance
+ * @param      callback       event callback
+ * @param      context        callback context
+ */
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* message_queue,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
+/** Subscribe to pooled message queue, callback is called while queue is not empty
+ *
+ * @param      instance    pointer to FuriEventLoop instance
+ * @param      pool_queue  pointer to FuriPoolQueue instance
+ * @param      callback    event callback
+ * @param      context     callback context
+ */
+void furi_event_loop_subscribe_pool_queue(
+    FuriEventLoop* instance,
+    FuriPoolQueue* pool_queue,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
+/** Subscribe to stream buffer, callback is called while it has bytes available
+ *
+ * @param      instance       pointer to FuriEventLoop instance
+ * @param      stream_buffer  pointer to FuriStreamBuffer instance
+ * @param      callback       event callback
+ * @param      context        callback context
+ */
+void furi_event_loop_subscribe_stream_buffer(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
+/** Subscribe to semaphore, callback is called while it can be acquired
+ *
+ * @param      instance   pointer to FuriEventLoop instance
+ * @param      semaphore  pointer to FuriSemaphore instance
+ * @param      callback   event callback
+ * @param      context    callback context
+ */
+void furi_event_loop_subscribe_semaphore(
+    FuriEventLoop* instance,
+    FuriSemaphore* semaphore,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
+/** Unsubscribe from object, owner thread only
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ * @param      object    subscribed object
+ */
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, void* object);
+
+/** Allocate timer, callback runs in the event loop thread
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ * @param[in]  callback  timer callback
+ * @param[in]  type      timer type
+ * @param      context   callback context
+ *
+ * @return     pointer to FuriEventLoopTimer instance
+ */
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriTimerType type,
+    void* context);
+
+/** Free timer, owner thread only, not from its own callback
+ *
+ * @param      timer  pointer to FuriEventLoopTimer instance
+ */
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer);
+
+/** Start or restart timer, owner thread only
+ *
+ * @param      timer     pointer to FuriEventLoopTimer instance
+ * @param[in]  interval  interval in ticks
+ */
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval);
+
+/** Stop timer, owner thread only
+ *
+ * @param      timer  pointer to FuriEventLoopTimer instance
+ */
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer);
+
+/** Check if timer is running
+ *
+ * @param      timer  pointer to FuriEventLoopTimer instance
+ *
+ * @return     true if running
+ */
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,6 +16,8 @@ FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size
 void furi_message_queue_free(FuriMessageQueue* instance) {
     furi_assert(furi_kernel_is_irq_or_masked() == 0U);
     furi_assert(instance);
+    // Still subscribed to an event loop, it would keep a dangling pointer
+    furi_check(uxQueueGetQueueNumber((QueueHandle_t)instance) == 0);
 
     vQueueDelete((QueueHandle_t)instance);
 }
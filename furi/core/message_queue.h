@@ -22,6 +22,8 @@ typedef void FuriMessageQueue;
 FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size);
 
 /** Free queue
+ *
+ * @warning    must be unsubscribed from event loop
  *
  * @param      instance  pointer to FuriMessageQueue instance
  */
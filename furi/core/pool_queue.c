@@ -0,0 +1,169 @@
+#include "pool_queue.h"
+#include "pool_queue_i.h"
+#include "message_queue.h"
+#include "common_defines.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Keep every block suitable for any message struct
+#define FURI_POOL_QUEUE_BLOCK_ALIGN 8
+
+struct FuriPoolQueue {
+    FuriMessageQueue* free; // pointers to blocks in pool
+    FuriMessageQueue* queue; // pointers to blocks put and not taken yet
+
+    uint8_t* blocks;
+    bool* owned; // block is out of pool, catches double release
+    bool* queued; // block is in queue, catches double put
+    uint32_t msg_count;
+    uint32_t msg_size;
+    uint32_t block_size;
+
+    uint32_t used_max;
+    uint32_t acquire_failed;
+};
+
+static uint32_t furi_pool_queue_get_index(FuriPoolQueue* instance, void* msg) {
+    furi_check(msg);
+    uint8_t* block = msg;
+    furi_check(block >= instance->blocks);
+
+    size_t offset = block - instance->blocks;
+    furi_check(offset % instance->block_size == 0);
+
+    uint32_t index = offset / instance->block_size;
+    furi_check(index < instance->msg_count);
+    return index;
+}
+
+FuriPoolQueue* furi_pool_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
+    furi_assert(msg_count > 0U && msg_size > 0U);
+
+    FuriPoolQueue* instance = malloc(sizeof(FuriPoolQueue));
+    instance->msg_count = msg_count;
+    instance->msg_size = msg_size;
+    instance->block_size =
+        (msg_size + FURI_POOL_QUEUE_BLOCK_ALIGN - 1) & ~(FURI_POOL_QUEUE_BLOCK_ALIGN - 1);
+
+    instance->blocks =
+        aligned_malloc(msg_count * instance->block_size, FURI_POOL_QUEUE_BLOCK_ALIGN);
+    instance->owned = malloc(msg_count * sizeof(bool));
+    instance->queued = malloc(msg_count * sizeof(bool));
+
+    instance->free = furi_message_queue_alloc(msg_count, sizeof(void*));
+    instance->queue = furi_message_queue_alloc(msg_count, sizeof(void*));
+
+    for(uint32_t i = 0; i < msg_count; i++) {
+        void* block = instance->blocks + i * instance->block_size;
+        furi_check(furi_message_queue_put(instance->free, &block, 0) == FuriStatusOk);
+    }
+
+    return instance;
+}
+
+void furi_pool_queue_free(FuriPoolQueue* instance) {
+    furi_assert(instance);
+    // Freeing blocks somebody still owns ends badly
+    furi_check(furi_message_queue_get_count(instance->free) == instance->msg_count);
+
+    furi_message_queue_free(instance->queue);
+    furi_message_queue_free(instance->free);
+    free(instance->queued);
+    free(instance->owned);
+    aligned_free(instance->blocks);
+    free(instance);
+}
+
+void* furi_pool_queue_acquire(FuriPoolQueue* instance, uint32_t timeout) {
+    furi_assert(instance);
+
+    void* block = NULL;
+    FuriStatus status = furi_message_queue_get(instance->free, &block, timeout);
+
+    FURI_CRITICAL_ENTER();
+    if(status == FuriStatusOk) {
+        uint32_t index = furi_pool_queue_get_index(instance, block);
+        furi_check(!instance->owned[index]);
+        instance->owned[index] = true;
+
+        uint32_t used = instance->msg_count - furi_message_queue_get_count(instance->free);
+        if(used > instance->used_max) instance->used_max = used;
+    } else {
+        instance->acquire_failed++;
+        block = NULL;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return block;
+}
+
+void furi_pool_queue_put(FuriPoolQueue* instance, void* msg) {
+    furi_assert(instance);
+
+    uint32_t index = furi_pool_queue_get_index(instance, msg);
+
+    FURI_CRITICAL_ENTER();
+    furi_check(instance->owned[index]);
+    furi_check(!instance->queued[index]);
+    instance->queued[index] = true;
+    FURI_CRITICAL_EXIT();
+
+    furi_check(furi_message_queue_put(instance->queue, &msg, 0) == FuriStatusOk);
+}
+
+void* furi_pool_queue_get(FuriPoolQueue* instance, uint32_t timeout) {
+    furi_assert(instance);
+
+    void* msg = NULL;
+    if(furi_message_queue_get(instance->queue, &msg, timeout) != FuriStatusOk) {
+        return NULL;
+    }
+
+    uint32_t index = furi_pool_queue_get_index(instance, msg);
+
+    FURI_CRITICAL_ENTER();
+    furi_check(instance->queued[index]);
+    instance->queued[index] = false;
+    FURI_CRITICAL_EXIT();
+
+    return msg;
+}
+
+void furi_pool_queue_release(FuriPoolQueue* instance, void* msg) {
+    furi_assert(instance);
+
+    uint32_t index = furi_pool_queue_get_index(instance, msg);
+
+    FURI_CRITICAL_ENTER();
+    furi_check(instance->owned[index]);
+    // Releasing a block that is still in queue hands it out twice
+    furi_check(!instance->queued[index]);
+    instance->owned[index] = false;
+    FURI_CRITICAL_EXIT();
+
+    furi_check(furi_message_queue_put(instance->free, &msg, 0) == FuriStatusOk);
+}
+
+FuriMessageQueue* furi_pool_queue_get_message_queue(FuriPoolQueue* instance) {
+    furi_assert(instance);
+    return instance->queue;
+}
+
+uint32_t furi_pool_queue_get_message_size(FuriPoolQueue* instance) {
+    furi_assert(instance);
+    return instance->msg_size;
+}
+
+void furi_pool_queue_get_stats(FuriPoolQueue* instance, FuriPoolQueueStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+
+    FURI_CRITICAL_ENTER();
+    stats->capacity = instance->msg_count;
+    stats->used = instance->msg_count - furi_message_queue_get_count(instance->free);
+    stats->used_max = instance->used_max;
+    stats->pending = furi_message_queue_get_count(instance->queue);
+    stats->acquire_failed = instance->acquire_failed;
+    FURI_CRITICAL_EXIT();
+}
@@ -0,0 +1,100 @@
+/**
+ * @file pool_queue.h
+ * FuriPoolQueue
+ *
+ * Message queue variant for large messages: messages live in fixed size blocks
+ * of a per-queue pool and only pointers go through the queue, nothing is
+ * copied. Block ownership moves explicitly: sender acquires a block, fills it
+ * and puts it, receiver gets it and must release it back to the pool.
+ */
+#pragma once
+
+#include "core/base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriPoolQueue FuriPoolQueue;
+
+/** FuriPoolQueue statistics */
+typedef struct {
+    uint32_t capacity; /**< Blocks in pool */
+    uint32_t used; /**< Blocks acquired and not released yet */
+    uint32_t used_max; /**< High water mark of used blocks */
+    uint32_t pending; /**< Messages put and not taken yet */
+    uint32_t acquire_failed; /**< Acquire attempts that ran out of blocks */
+} FuriPoolQueueStats;
+
+/** Allocate pooled message queue
+ *
+ * @param[in]  msg_count  pool size and queue capacity
+ * @param[in]  msg_size   message block size
+ *
+ * @return     pointer to FuriPoolQueue instance
+ */
+FuriPoolQueue* furi_pool_queue_alloc(uint32_t msg_count, uint32_t msg_size);
+
+/** Free pooled message queue
+ *
+ * @warning    all blocks must be released
+ *
+ * @param      instance  pointer to FuriPoolQueue instance
+ */
+void furi_pool_queue_free(FuriPoolQueue* instance);
+
+/** Acquire free message block, caller owns it
+ *
+ * Block content is undefined.
+ *
+ * @param      instance  pointer to FuriPoolQueue instance
+ * @param[in]  timeout   timeout in ticks, must be 0 in interrupt
+ *
+ * @return     message block or NULL if pool stays empty for timeout
+ */
+void* furi_pool_queue_acquire(FuriPoolQueue* instance, uint32_t timeout);
+
+/** Put acquired message block into queue, ownership passes to receiver
+ *
+ * Never blocks: queue has room for every block of the pool. Putting a block
+ * that is already in queue crashes.
+ *
+ * @param      instance  pointer to FuriPoolQueue instance
+ * @param      msg       message block from furi_pool_queue_acquire
+ */
+void furi_pool_queue_put(FuriPoolQueue* instance, void* msg);
+
+/** Get message block from queue, caller owns it
+ *
+ * @param      instance  pointer to FuriPoolQueue instance
+ * @param[in]  timeout   timeout in ticks, must be 0 in interrupt
+ *
+ * @return     message block or NULL if queue stays empty for timeout
+ */
+void* furi_pool_queue_get(FuriPoolQueue* instance, uint32_t timeout);
+
+/** Release owned message block back to pool
+ *
+ * @param      instance  pointer to FuriPoolQueue instance
+ * @param      msg       message block from furi_pool_queue_acquire or furi_pool_queue_get
+ */
+void furi_pool_queue_release(FuriPoolQueue* instance, void* msg);
+
+/** Get message block size
+ *
+ * @param      instance  pointer to FuriPoolQueue instance
+ *
+ * @return     message block size in bytes
+ */
+uint32_t furi_pool_queue_get_message_size(FuriPoolQueue* instance);
+
+/** Get pool and queue statistics
+ *
+ * @param      instance  pointer to FuriPoolQueue instance
+ * @param      stats     pointer to FuriPoolQueueStats to fill
+ */
+void furi_pool_queue_get_stats(FuriPoolQueue* instance, FuriPoolQueueStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "pool_queue.h"
+#include "message_queue.h"
+
+/** Get queue of message block pointers, event loop subscribes to it
+ *
+ * @param      instance  pointer to FuriPoolQueue instance
+ *
+ * @return     pointer to FuriMessageQueue instance
+ */
+FuriMessageQueue* furi_pool_queue_get_message_queue(FuriPoolQueue* instance);
@@ -32,6 +32,8 @@ void furi_semaphore_free(FuriSemaphore* instance) {
     furi_assert(!FURI_IS_IRQ_MODE());
 
     SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)instance;
+    // Still subscribed to an event loop, it would keep a dangling pointer
+    furi_check(uxQueueGetQueueNumber(hSemaphore) == 0);
 
     vSemaphoreDelete(hSemaphore);
 }
@@ -23,6 +23,8 @@ typedef void FuriSemaphore;
 FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count);
 
 /** Free semaphore
+ *
+ * @warning    must be unsubscribed from event loop
  *
  * @param      instance  The pointer to FuriSemaphore instance
  */
@@ -16,6 +16,8 @@ FuriStreamBuffer* furi_stream_buffer_alloc(size_t size, size_t trigger_level) {
 
 void furi_stream_buffer_free(FuriStreamBuffer* stream_buffer) {
     furi_assert(stream_buffer);
+    // Still subscribed to an event loop, it would keep a dangling pointer
+    furi_check(uxStreamBufferGetStreamBufferNumber(stream_buffer) == 0);
     vStreamBufferDelete(stream_buffer);
 };
 
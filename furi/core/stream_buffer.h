@@ -37,6 +37,8 @@ FuriStreamBuffer* furi_stream_buffer_alloc(size_t size, size_t trigger_level);
 /**
  * @brief Free stream buffer instance
  * 
+ * @warning must be unsubscribed from event loop
+ * 
  * @param stream_buffer The stream buffer instance.
  */
 void furi_stream_buffer_free(FuriStreamBuffer* stream_buffer);
@@ -14,6 +14,8 @@
 #include "log.h"
 #include <furi_hal_rtc.h>
 #include <furi_hal_console.h>
+#include <furi_hal_cortex.h>
+#include <stm32wbxx.h>
 
 #define TAG "FuriThread"
 
@@ -39,6 +41,26 @@ static void furi_thread_set_state(FuriThread* thread, FuriThreadState state) {
     }
 }
 
+/* Trace level only, every thread exit would be too noisy otherwise */
+static void furi_thread_log_stats(FuriThread* thread) {
+    if(furi_log_get_level() < FuriLogLevelTrace) return;
+
+    FuriThreadStats stats;
+    furi_thread_get_stats(thread->task_handle, &stats);
+
+    uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    uint32_t latency_avg = stats.wakeups ? stats.latency_total / stats.wakeups : 0;
+    FURI_LOG_T(
+        TAG,
+        "%s run %lu us, switches %lu, wakeups %lu, latency avg %lu us, max %lu us",
+        thread->name ? thread->name : "Thread",
+        (uint32_t)(stats.run_time / cycles_per_us),
+        stats.switches,
+        stats.wakeups,
+        latency_avg / cycles_per_us,
+        stats.latency_max / cycles_per_us);
+}
+
 static void furi_thread_body(void* context) {
     furi_assert(context);
     FuriThread* thread = context;
@@ -78,6 +100,8 @@ static void furi_thread_body(void* context) {
             thread->name ? thread->name : "<unknown service>");
     }
 
+    furi_thread_log_stats(thread);
+
     // flush stdout
     __furi_thread_stdout_flush(thread);
 
@@ -224,6 +248,10 @@ void furi_thread_start(FuriThread* thread) {
 
     furi_thread_set_state(thread, FuriThreadStateStarting);
 
+    memset(&thread->stats, 0, sizeof(thread->stats));
+    thread->is_ready = false;
+    thread->latency_shift = 31 - __CLZ(furi_hal_cortex_instructions_per_microsecond());
+
     uint32_t stack = thread->stack_size / sizeof(StackType_t);
     UBaseType_t priority = thread->priority ? thread->priority : FuriThreadPriorityNormal;
     if(thread->is_service) {
@@ -254,6 +282,36 @@ void furi_thread_cleanup_tcb_event(TaskHandle_t task) {
     }
 }
 
+/* Called by the kernel with scheduler locked, keep it short */
+void furi_thread_trace_ready(void* context) {
+    FuriThread* thread = context;
+    if(thread && !thread->is_ready) {
+        thread->ready_time = DWT->CYCCNT;
+        thread->is_ready = true;
+    }
+}
+
+/* Called by the kernel on context switch, keep it short */
+void furi_thread_trace_switched_in(void* context) {
+    FuriThread* thread = context;
+    if(!thread) return;
+
+    thread->stats.switches++;
+    if(thread->is_ready) {
+        thread->is_ready = false;
+        uint32_t latency = DWT->CYCCNT - thread->ready_time;
+        thread->stats.wakeups++;
+        thread->stats.latency_total += latency;
+        if(latency > thread->stats.latency_max) thread->stats.latency_max = latency;
+
+        // log2 of latency in microseconds, from raw cycles: no division in PendSV
+        uint32_t bucket = 31 - __CLZ(latency | 1);
+        bucket = (bucket > thread->latency_shift) ? bucket - thread->latency_shift : 0;
+        bucket = MIN(bucket, (uint32_t)FURI_THREAD_LATENCY_HISTOGRAM_SIZE - 1);
+        thread->stats.latency_histogram[bucket]++;
+    }
+}
+
 bool furi_thread_join(FuriThread* thread) {
     furi_assert(thread);
 
@@ -537,6 +595,30 @@ uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
     return (sz);
 }
 
+bool furi_thread_get_stats(FuriThreadId thread_id, FuriThreadStats* stats) {
+    TaskHandle_t hTask = (TaskHandle_t)thread_id;
+    furi_assert(stats);
+
+    memset(stats, 0, sizeof(FuriThreadStats));
+    if(FURI_IS_IRQ_MODE() || (hTask == NULL)) {
+        return false;
+    }
+
+    FuriThread* thread = (FuriThread*)pvTaskGetThreadLocalStoragePointer(hTask, 0);
+    if(thread) {
+        // Updated from the scheduler, copy with it locked out
+        FURI_CRITICAL_ENTER();
+        *stats = thread->stats;
+        FURI_CRITICAL_EXIT();
+    }
+
+    TaskStatus_t status;
+    vTaskGetInfo(hTask, &status, pdFALSE, eInvalid);
+    stats->run_time = status.ulRunTimeCounter;
+
+    return thread != NULL;
+}
+
 static size_t __furi_thread_stdout_write(FuriThread* thread, const char* data, size_t size) {
     if(thread->output.write_callback != NULL) {
         thread->output.write_callback(data, size);
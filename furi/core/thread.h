@@ -31,6 +31,23 @@ typedef enum {
     FuriThreadPriorityIsr = (configMAX_PRIORITIES - 1), /**< Deferred ISR (highest possible) */
 } FuriThreadPriority;
 
+/** Latency histogram size, bucket N counts latencies of [2^N, 2^(N+1)) us
+ *
+ * Bounds are whole powers of two CPU cycles, exact when cycles per
+ * microsecond is a power of two too.
+ */
+#define FURI_THREAD_LATENCY_HISTOGRAM_SIZE (16)
+
+/** FuriThread scheduling statistics, times are in CPU cycles */
+typedef struct {
+    uint64_t run_time; /**< Time spent running */
+    uint32_t switches; /**< Times thread was switched in */
+    uint32_t wakeups; /**< Times thread was made ready by someone else */
+    uint64_t latency_total; /**< Sum of wake up to run latencies */
+    uint32_t latency_max; /**< Worst wake up to run latency */
+    uint32_t latency_histogram[FURI_THREAD_LATENCY_HISTOGRAM_SIZE];
+} FuriThreadStats;
+
 /** FuriThread anonymous structure */
 typedef struct FuriThread FuriThread;
 
@@ -281,6 +298,18 @@ const char* furi_thread_get_appid(FuriThreadId thread_id);
  */
 uint32_t furi_thread_get_stack_space(FuriThreadId thread_id);
 
+/** Get thread scheduling statistics
+ *
+ * Run time is available for every thread, the rest is collected for
+ * FuriThread only. Statistics are reset on furi_thread_start.
+ *
+ * @param      thread_id  thread id
+ * @param      stats      pointer to FuriThreadStats to fill
+ *
+ * @return     true if scheduling statistics are available
+ */
+bool furi_thread_get_stats(FuriThreadId thread_id, FuriThreadStats* stats);
+
 /** Get STDOUT callback for thead
  *
  * @return STDOUT callback
@@ -28,10 +28,15 @@ struct FuriThread {
 
     FuriThreadStdout output;
 
+    FuriThreadStats stats;
+    uint32_t ready_time; // DWT cycles, valid while is_ready is set
+    uint32_t latency_shift; // log2 of DWT cycles per microsecond, for the latency histogram
+
     // Keep all non-alignable byte types in one place,
     // this ensures that the size of this structure is minimal
     bool is_service;
     bool heap_trace_enabled;
+    bool is_ready;
 
     configSTACK_DEPTH_TYPE stack_size;
 };
\ No newline at end of file
@@ -5,12 +5,14 @@
 #include "core/check.h"
 #include "core/common_defines.h"
 #include "core/event_flag.h"
+#include "core/event_loop.h"
 #include "core/kernel.h"
 #include "core/log.h"
 #include "core/memmgr.h"
 #include "core/memmgr_heap.h"
 #include "core/message_queue.h"
 #include "core/mutex.h"
+#include "core/pool_queue.h"
 #include "core/pubsub.h"
 #include "core/record.h"
 #include "core/semaphore.h"
@@ -21,7 +21,6 @@ struct ReloadBuffer {
 
 struct DigitalSequence {
     uint8_t signals_size;
-    bool bake;
     uint32_t sequence_used;
     uint32_t sequence_size;
     DigitalSignal** signals;
@@ -33,6 +32,9 @@ struct DigitalSequence {
     LL_DMA_InitTypeDef dma_config_timer;
     uint32_t* gpio_buff;
     struct ReloadBuffer* dma_buffer;
+
+    uint32_t send_start;
+    DigitalSequenceStats stats; /* times in core ticks */
 };
 
 struct DigitalSignalInternals {
@@ -344,7 +346,6 @@ DigitalSequence* digital_sequence_alloc(uint32_t size, const GpioPin* gpio) {
     DigitalSequence* sequence = malloc(sizeof(DigitalSequence));
 
     sequence->gpio = gpio;
-    sequence->bake = false;
 
     sequence->dma_buffer = malloc(sizeof(struct ReloadBuffer));
     sequence->dma_buffer->size = RINGBUFFER_SIZE;
@@ -442,41 +443,25 @@ static bool digital_sequence_setup_dma(DigitalSequence* sequence) {
     return true;
 }
 
-static DigitalSignal* digital_sequence_bake(DigitalSequence* sequence) {
-    furi_assert(sequence);
-
-    uint32_t edges = 0;
-
-    for(uint32_t pos = 0; pos < sequence->sequence_used; pos++) {
-        uint8_t signal_index = sequence->sequence[pos];
-        DigitalSignal* sig = sequence->signals[signal_index];
-
-        edges += sig->edge_cnt;
-    }
-
-    DigitalSignal* ret = digital_signal_alloc(edges);
-
-    for(uint32_t pos = 0; pos < sequence->sequence_used; pos++) {
-        uint8_t signal_index = sequence->sequence[pos];
-        DigitalSignal* sig = sequence->signals[signal_index];
-
-        digital_signal_append(ret, sig);
-    }
-
-    return ret;
-}
-
 static void digital_sequence_finish(DigitalSequence* sequence) {
     struct ReloadBuffer* dma_buffer = sequence->dma_buffer;
 
     if(dma_buffer->dma_active) {
         uint32_t prev_timer = DWT->CYCCNT;
+        uint32_t prev_length = LL_DMA_GetDataLength(DMA1, LL_DMA_CHANNEL_2);
         do {
             /* we are finished, when the DMA transferred the SEQ_TIMER_MAX marker */
             if(TIM2->ARR == SEQ_TIMER_MAX) {
                 break;
             }
+            /* only a stalled DMA is a hang, the tail of a long sequence may take a while */
+            uint32_t length = LL_DMA_GetDataLength(DMA1, LL_DMA_CHANNEL_2);
+            if(length != prev_length) {
+                prev_length = length;
+                prev_timer = DWT->CYCCNT;
+            }
             if(DWT->CYCCNT - prev_timer > SEQ_LOCK_WAIT_TICKS) {
+                sequence->stats.timeouts++;
                 dma_buffer->read_pos =
                     RINGBUFFER_SIZE - LL_DMA_GetDataLength(DMA1, LL_DMA_CHANNEL_2);
                 FURI_LOG_D(
@@ -511,6 +496,7 @@ static void digital_sequence_queue_pulse(DigitalSequence* sequence, uint32_t len
             }
 
             if(DWT->CYCCNT - prev_timer > SEQ_LOCK_WAIT_TICKS) {
+                sequence->stats.timeouts++;
                 FURI_LOG_D(
                     TAG,
                     "[SEQ] hung %lu ms in queue (ARR 0x%08lx, read %lu, write %lu)",
@@ -521,6 +507,7 @@ static void digital_sequence_queue_pulse(DigitalSequence* sequence, uint32_t len
                 break;
             }
             if(TIM2->ARR == SEQ_TIMER_MAX) {
+                sequence->stats.underruns++;
                 FURI_LOG_D(
                     TAG,
                     "[SEQ] buffer underrun in queue (ARR 0x%08lx, read %lu, write %lu)",
@@ -543,24 +530,20 @@ bool digital_sequence_send(DigitalSequence* sequence) {
 
     struct ReloadBuffer* dma_buffer = sequence->dma_buffer;
 
+    sequence->send_start = DWT->CYCCNT;
+
     furi_hal_gpio_init(sequence->gpio, GpioModeOutputPushPull, GpioPullNo, GpioSpeedVeryHigh);
 #ifdef DIGITAL_SIGNAL_DEBUG_OUTPUT_PIN
     furi_hal_gpio_init(
         &DIGITAL_SIGNAL_DEBUG_OUTPUT_PIN, GpioModeOutputPushPull, GpioPullNo, GpioSpeedVeryHigh);
 #endif
 
-    if(sequence->bake) {
-        DigitalSignal* sig = digital_sequence_bake(sequence);
-
-        digital_signal_send(sig, sequence->gpio);
-        digital_signal_free(sig);
-        return true;
-    }
-
     if(!sequence->sequence_used) {
         return false;
     }
 
+    sequence->stats.sends++;
+
     int32_t remainder = 0;
     uint32_t trade_for_next = 0;
     uint32_t seq_pos_next = 1;
@@ -627,9 +610,21 @@ bool digital_sequence_send(DigitalSequence* sequence) {
                         digital_sequence_setup_dma(sequence);
                         digital_signal_setup_timer();
 
+                        uint32_t now = DWT->CYCCNT;
+                        sequence->stats.prepare_time_max =
+                            MAX(sequence->stats.prepare_time_max, now - sequence->send_start);
+
                         /* if the send time is specified, wait till the core timer passed beyond that time */
                         if(sequence->send_time_active) {
                             sequence->send_time_active = false;
+
+                            int32_t late = now - sequence->send_time;
+                            if(late > 0) {
+                                sequence->stats.deadline_misses++;
+                                sequence->stats.late_time_max =
+                                    MAX(sequence->stats.late_time_max, (uint32_t)late);
+                            }
+
                             while(sequence->send_time - DWT->CYCCNT < 0x80000000) {
                             }
                         }
@@ -658,6 +653,23 @@ void digital_sequence_clear(DigitalSequence* sequence) {
     sequence->sequence_used = 0;
 }
 
+void digital_sequence_get_stats(DigitalSequence* sequence, DigitalSequenceStats* stats) {
+    furi_assert(sequence);
+    furi_assert(stats);
+
+    uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
+    *stats = sequence->stats;
+    stats->prepare_time_max /= cycles_per_us;
+    stats->late_time_max /= cycles_per_us;
+}
+
+void digital_sequence_reset_stats(DigitalSequence* sequence) {
+    furi_assert(sequence);
+
+    memset(&sequence->stats, 0, sizeof(DigitalSequenceStats));
+}
+
 void digital_sequence_timebase_correction(DigitalSequence* sequence, float factor) {
     for(uint32_t sig_pos = 0; sig_pos < sequence->signals_size; sig_pos++) {
         DigitalSignal* signal = sequence->signals[sig_pos];
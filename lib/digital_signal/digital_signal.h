@@ -31,6 +31,16 @@ typedef struct DigitalSignal {
 
 typedef struct DigitalSequence DigitalSequence;
 
+/* times in microseconds */
+typedef struct {
+    uint32_t sends;
+    uint32_t prepare_time_max; /* worst time from send call to transmission start */
+    uint32_t deadline_misses; /* transmission started after the requested send time */
+    uint32_t late_time_max; /* worst start delay past the requested send time */
+    uint32_t underruns; /* reload values were not queued in time */
+    uint32_t timeouts; /* DMA made no progress for too long */
+} DigitalSequenceStats;
+
 DigitalSignal* digital_signal_alloc(uint32_t max_edges_cnt);
 
 void digital_signal_free(DigitalSignal* signal);
@@ -68,6 +78,10 @@ bool digital_sequence_send(DigitalSequence* sequence);
 
 void digital_sequence_clear(DigitalSequence* sequence);
 
+void digital_sequence_get_stats(DigitalSequence* sequence, DigitalSequenceStats* stats);
+
+void digital_sequence_reset_stats(DigitalSequence* sequence);
+
 void digital_sequence_timebase_correction(DigitalSequence* sequence, float factor);
 
 #ifdef __cplusplus
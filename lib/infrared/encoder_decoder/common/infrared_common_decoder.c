@@ -275,6 +275,22 @@ InfraredMessage*
     return message;
 }
 
+bool infrared_common_decoder_is_plausible(InfraredCommonDecoder* decoder, uint32_t mark) {
+    furi_assert(decoder);
+
+    const InfraredTimings* timings = &decoder->protocol->timings;
+    if(timings->preamble_mark == 0) return true;
+
+    /* Only an idle decoder would drop this mark and the following space unseen */
+    bool is_idle = (decoder->state == InfraredCommonDecoderStateWaitPreamble) &&
+                   (decoder->databit_cnt == 0) &&
+                   ((decoder->timings_cnt == 0) ||
+                    ((decoder->timings_cnt == 1) && !decoder->level));
+    if(!is_idle) return true;
+
+    return MATCH_TIMING(mark, timings->preamble_mark, timings->preamble_tolerance);
+}
+
 void* infrared_common_decoder_alloc(const InfraredCommonProtocolSpec* protocol) {
     furi_assert(protocol);
 
@@ -19,6 +19,7 @@ typedef struct {
     InfraredDecoderReset reset;
     InfraredFree free;
     InfraredDecoderCheckReady check_ready;
+    InfraredDecoderIsPlausible is_plausible;
 } InfraredDecoders;
 
 typedef struct {
@@ -30,6 +31,7 @@ typedef struct {
 
 struct InfraredDecoderHandler {
     void** ctx;
+    uint32_t skip_mask; /**< decoders that can't start a frame with the last mark */
 };
 
 struct InfraredEncoderHandler {
@@ -50,6 +52,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_nec_decode,
              .reset = infrared_decoder_nec_reset,
              .check_ready = infrared_decoder_nec_check_ready,
+             .is_plausible = infrared_decoder_nec_is_plausible,
              .free = infrared_decoder_nec_free},
         .encoder =
             {.alloc = infrared_encoder_nec_alloc,
@@ -64,6 +67,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_samsung32_decode,
              .reset = infrared_decoder_samsung32_reset,
              .check_ready = infrared_decoder_samsung32_check_ready,
+             .is_plausible = infrared_decoder_samsung32_is_plausible,
              .free = infrared_decoder_samsung32_free},
         .encoder =
             {.alloc = infrared_encoder_samsung32_alloc,
@@ -78,6 +82,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc5_decode,
              .reset = infrared_decoder_rc5_reset,
              .check_ready = infrared_decoder_rc5_check_ready,
+             .is_plausible = infrared_decoder_rc5_is_plausible,
              .free = infrared_decoder_rc5_free},
         .encoder =
             {.alloc = infrared_encoder_rc5_alloc,
@@ -92,6 +97,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc6_decode,
              .reset = infrared_decoder_rc6_reset,
              .check_ready = infrared_decoder_rc6_check_ready,
+             .is_plausible = infrared_decoder_rc6_is_plausible,
              .free = infrared_decoder_rc6_free},
         .encoder =
             {.alloc = infrared_encoder_rc6_alloc,
@@ -106,6 +112,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_sirc_decode,
              .reset = infrared_decoder_sirc_reset,
              .check_ready = infrared_decoder_sirc_check_ready,
+             .is_plausible = infrared_decoder_sirc_is_plausible,
              .free = infrared_decoder_sirc_free},
         .encoder =
             {.alloc = infrared_encoder_sirc_alloc,
@@ -120,6 +127,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_kaseikyo_decode,
              .reset = infrared_decoder_kaseikyo_reset,
              .check_ready = infrared_decoder_kaseikyo_check_ready,
+             .is_plausible = infrared_decoder_kaseikyo_is_plausible,
              .free = infrared_decoder_kaseikyo_free},
         .encoder =
             {.alloc = infrared_encoder_kaseikyo_alloc,
@@ -134,6 +142,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rca_decode,
              .reset = infrared_decoder_rca_reset,
              .check_ready = infrared_decoder_rca_check_ready,
+             .is_plausible = infrared_decoder_rca_is_plausible,
              .free = infrared_decoder_rca_free},
         .encoder =
             {.alloc = infrared_encoder_rca_alloc,
@@ -144,6 +153,10 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
     },
 };
 
+_Static_assert(
+    COUNT_OF(infrared_encoder_decoder) <= 32,
+    "Decoders don't fit InfraredDecoderHandler skip mask");
+
 static int infrared_find_index_by_protocol(InfraredProtocol protocol);
 static const InfraredProtocolVariant* infrared_get_variant_by_protocol(InfraredProtocol protocol);
 
@@ -154,7 +167,20 @@ const InfraredMessage*
     InfraredMessage* message = NULL;
     InfraredMessage* result = NULL;
 
+    /* Decoders waiting for a preamble this mark doesn't match would drop the mark
+     * and the following space anyway, so skip them until the next mark */
+    if(level) {
+        handler->skip_mask = 0;
+        for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+            const InfraredDecoders* decoder = &infrared_encoder_decoder[i].decoder;
+            if(decoder->is_plausible && !decoder->is_plausible(handler->ctx[i], duration)) {
+                handler->skip_mask |= (1UL << i);
+            }
+        }
+    }
+
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        if(handler->skip_mask & (1UL << i)) continue;
         if(infrared_encoder_decoder[i].decoder.decode) {
             message = infrared_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
             if(!result && message) {
@@ -194,6 +220,7 @@ void infrared_free_decoder(InfraredDecoderHandler* handler) {
 }
 
 void infrared_reset_decoder(InfraredDecoderHandler* handler) {
+    handler->skip_mask = 0;
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
         if(infrared_encoder_decoder[i].decoder.reset)
             infrared_encoder_decoder[i].decoder.reset(handler->ctx[i]);
@@ -207,6 +234,8 @@ const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* hand
     InfraredMessage* result = NULL;
 
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        /* Skipped decoders are idle and have nothing to report */
+        if(handler->skip_mask & (1UL << i)) continue;
         if(infrared_encoder_decoder[i].decoder.check_ready) {
             message = infrared_encoder_decoder[i].decoder.check_ready(handler->ctx[i]);
             if(!result && message) {
@@ -5,6 +5,10 @@ InfraredMessage* infrared_decoder_kaseikyo_check_ready(void* ctx) {
     return infrared_common_decoder_check_ready(ctx);
 }
 
+bool infrared_decoder_kaseikyo_is_plausible(void* ctx, uint32_t mark) {
+    return infrared_common_decoder_is_plausible(ctx, mark);
+}
+
 bool infrared_decoder_kaseikyo_interpret(InfraredCommonDecoder* decoder) {
     furi_assert(decoder);
 
@@ -20,6 +20,7 @@ void* infrared_decoder_kaseikyo_alloc(void);
 void infrared_decoder_kaseikyo_reset(void* decoder);
 void infrared_decoder_kaseikyo_free(void* decoder);
 InfraredMessage* infrared_decoder_kaseikyo_check_ready(void* decoder);
+bool infrared_decoder_kaseikyo_is_plausible(void* decoder, uint32_t mark);
 InfraredMessage* infrared_decoder_kaseikyo_decode(void* decoder, bool level, uint32_t duration);
 
 void* infrared_encoder_kaseikyo_alloc(void);
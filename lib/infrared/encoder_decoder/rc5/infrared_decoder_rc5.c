@@ -13,6 +13,11 @@ InfraredMessage* infrared_decoder_rc5_check_ready(void* ctx) {
     return infrared_common_decoder_check_ready(decoder->common_decoder);
 }
 
+bool infrared_decoder_rc5_is_plausible(void* ctx, uint32_t mark) {
+    InfraredRc5Decoder* decoder = ctx;
+    return infrared_common_decoder_is_plausible(decoder->common_decoder, mark);
+}
+
 bool infrared_decoder_rc5_interpret(InfraredCommonDecoder* decoder) {
     furi_assert(decoder);
 
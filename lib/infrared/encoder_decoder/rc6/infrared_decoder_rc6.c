@@ -13,6 +13,11 @@ InfraredMessage* infrared_decoder_rc6_check_ready(void* ctx) {
     return infrared_common_decoder_check_ready(decoder_rc6->common_decoder);
 }
 
+bool infrared_decoder_rc6_is_plausible(void* ctx, uint32_t mark) {
+    InfraredRc6Decoder* decoder_rc6 = ctx;
+    return infrared_common_decoder_is_plausible(decoder_rc6->common_decoder, mark);
+}
+
 bool infrared_decoder_rc6_interpret(InfraredCommonDecoder* decoder) {
     furi_assert(decoder);
 
@@ -20,6 +20,7 @@ void* infrared_decoder_rca_alloc(void);
 void infrared_decoder_rca_reset(void* decoder);
 void infrared_decoder_rca_free(void* decoder);
 InfraredMessage* infrared_decoder_rca_check_ready(void* decoder);
+bool infrared_decoder_rca_is_plausible(void* decoder, uint32_t mark);
 InfraredMessage* infrared_decoder_rca_decode(void* decoder, bool level, uint32_t duration);
 
 void* infrared_encoder_rca_alloc(void);
@@ -26,6 +26,7 @@
 void* infrared_decoder_sirc_alloc(void);
 void infrared_decoder_sirc_reset(void* decoder);
 InfraredMessage* infrared_decoder_sirc_check_ready(void* decoder);
+bool infrared_decoder_sirc_is_plausible(void* decoder, uint32_t mark);
 void infrared_decoder_sirc_free(void* decoder);
 InfraredMessage* infrared_decoder_sirc_decode(void* decoder, bool level, uint32_t duration);
 
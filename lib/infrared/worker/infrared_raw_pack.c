@@ -0,0 +1,146 @@
+#include "infrared_raw_pack.h"
+
+#include <core/check.h>
+#include <toolbox/varint.h>
+
+#include <string.h>
+
+/* Frames start from mark, so spaces are at odd indices */
+static size_t
+    infrared_raw_pack_get_frame_end(const uint32_t* timings, size_t timings_cnt, size_t start) {
+    for(size_t i = start | 1; i < timings_cnt; i += 2) {
+        if(timings[i] >= INFRARED_RAW_PACK_FRAME_GAP_US) {
+            return i + 1;
+        }
+    }
+    return timings_cnt;
+}
+
+static size_t infrared_raw_pack_put(uint32_t value, uint8_t* output) {
+    return output ? varint_uint32_pack(value, output) : varint_uint32_length(value);
+}
+
+size_t infrared_raw_pack(const uint32_t* timings, size_t timings_cnt, uint8_t* output) {
+    furi_assert(timings);
+
+    size_t packed_size = 0;
+    size_t start = 0;
+
+    while(start < timings_cnt) {
+        size_t end = infrared_raw_pack_get_frame_end(timings, timings_cnt, start);
+        size_t frame_size = end - start;
+        uint32_t repeats = 1;
+
+        size_t next = end;
+        while(next < timings_cnt) {
+            size_t next_end = infrared_raw_pack_get_frame_end(timings, timings_cnt, next);
+            // Exact match only, packing must give back the very same timings
+            if((next_end - next != frame_size) ||
+               memcmp(&timings[start], &timings[next], frame_size * sizeof(uint32_t)) != 0) {
+                break;
+            }
+            ++repeats;
+            next = next_end;
+        }
+
+        packed_size += infrared_raw_pack_put(frame_size, output ? &output[packed_size] : NULL);
+        packed_size += infrared_raw_pack_put(repeats, output ? &output[packed_size] : NULL);
+        for(size_t i = start; i < end; ++i) {
+            packed_size += infrared_raw_pack_put(timings[i], output ? &output[packed_size] : NULL);
+        }
+
+        start = next;
+    }
+
+    return packed_size;
+}
+
+static bool infrared_raw_pack_get(
+    const uint8_t* data,
+    size_t size,
+    size_t* position,
+    uint32_t* value) {
+    if(*position >= size) return false;
+
+    size_t left = size - *position;
+    size_t length = varint_uint32_unpack(value, &data[*position], left);
+    if(length > left) return false;
+
+    *position += length;
+    return true;
+}
+
+size_t infrared_raw_pack_get_timings_count(const uint8_t* data, size_t size) {
+    furi_assert(data);
+
+    size_t timings_cnt = 0;
+    size_t position = 0;
+    bool is_odd_frame_seen = false;
+
+    while(position < size) {
+        uint32_t frame_size, repeats, timing;
+        if(!infrared_raw_pack_get(data, size, &position, &frame_size)) return 0;
+        if(!infrared_raw_pack_get(data, size, &position, &repeats)) return 0;
+        if(!frame_size || !repeats) return 0;
+
+        // Only the last frame may end with mark, otherwise levels get out of order
+        if(is_odd_frame_seen) return 0;
+        if(frame_size % 2) {
+            if(repeats > 1) return 0;
+            is_odd_frame_seen = true;
+        }
+
+        for(uint32_t i = 0; i < frame_size; ++i) {
+            if(!infrared_raw_pack_get(data, size, &position, &timing)) return 0;
+        }
+
+        timings_cnt += (size_t)frame_size * repeats;
+    }
+
+    return timings_cnt;
+}
+
+void infrared_raw_unpacker_init(InfraredRawUnpacker* unpacker, const uint8_t* data, size_t size) {
+    furi_assert(unpacker);
+    furi_assert(data);
+
+    unpacker->data = data;
+    unpacker->size = size;
+    unpacker->position = 0;
+    unpacker->frame_start = 0;
+    unpacker->frame_timings_cnt = 0;
+    unpacker->frame_timings_left = 0;
+    unpacker->frame_repeats_left = 0;
+}
+
+bool infrared_raw_unpacker_next(InfraredRawUnpacker* unpacker, uint32_t* duration) {
+    furi_assert(unpacker);
+    furi_assert(duration);
+
+    if(!unpacker->frame_timings_left) {
+        if(unpacker->frame_repeats_left > 1) {
+            --unpacker->frame_repeats_left;
+            unpacker->position = unpacker->frame_start;
+        } else {
+            uint32_t frame_size, repeats;
+            if(!infrared_raw_pack_get(
+                   unpacker->data, unpacker->size, &unpacker->position, &frame_size) ||
+               !infrared_raw_pack_get(
+                   unpacker->data, unpacker->size, &unpacker->position, &repeats) ||
+               !frame_size || !repeats) {
+                return false;
+            }
+            unpacker->frame_start = unpacker->position;
+            unpacker->frame_timings_cnt = frame_size;
+            unpacker->frame_repeats_left = repeats;
+        }
+        unpacker->frame_timings_left = unpacker->frame_timings_cnt;
+    }
+
+    if(!infrared_raw_pack_get(unpacker->data, unpacker->size, &unpacker->position, duration)) {
+        return false;
+    }
+
+    --unpacker->frame_timings_left;
+    return true;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file infrared_raw_pack.h
+ * Infrared: compact raw signal representation
+ *
+ * Raw timings are split into frames, each ending with a space longer than
+ * INFRARED_RAW_PACK_FRAME_GAP_US. Every frame is stored as varint timings
+ * count, varint repeat count and varint timings. Frames identical to the
+ * previous one only increase its repeat count, so packing is lossless.
+ * Packed signals always start from mark.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Minimal space that ends a frame */
+#define INFRARED_RAW_PACK_FRAME_GAP_US (10000U)
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+    size_t frame_start;
+    uint32_t frame_timings_cnt;
+    uint32_t frame_timings_left;
+    uint32_t frame_repeats_left;
+} InfraredRawUnpacker;
+
+/** Pack raw timings
+ *
+ * @param[in]   timings - array of timings, starting from mark
+ * @param[in]   timings_cnt - timings array size
+ * @param[out]  output - output buffer, NULL to only calculate packed size
+ *
+ * @return      packed size in bytes
+ */
+size_t infrared_raw_pack(const uint32_t* timings, size_t timings_cnt, uint8_t* output);
+
+/** Validate packed data and count timings it expands to
+ *
+ * @param[in]   data - packed data
+ * @param[in]   size - packed data size
+ *
+ * @return      timings count, 0 if data is malformed
+ */
+size_t infrared_raw_pack_get_timings_count(const uint8_t* data, size_t size);
+
+/** Start iterating over packed timings
+ *
+ * @param[out]  unpacker - InfraredRawUnpacker to initialize
+ * @param[in]   data - packed data, must stay valid while iterating
+ * @param[in]   size - packed data size
+ */
+void infrared_raw_unpacker_init(InfraredRawUnpacker* unpacker, const uint8_t* data, size_t size);
+
+/** Get next timing
+ *
+ * Safe to call from interrupt context.
+ *
+ * @param[in]   unpacker - InfraredRawUnpacker instance
+ * @param[out]  duration - timing duration
+ *
+ * @return      true if timing was read, false at the end of data
+ */
+bool infrared_raw_unpacker_next(InfraredRawUnpacker* unpacker, uint32_t* duration);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,5 @@
 #include "infrared.h"
+#include "infrared_raw_pack.h"
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -10,6 +11,8 @@ static uint32_t infrared_tx_raw_timings_index = 0;
 static uint32_t infrared_tx_raw_timings_number = 0;
 static uint32_t infrared_tx_raw_start_from_mark = 0;
 static bool infrared_tx_raw_add_silence = false;
+static InfraredRawUnpacker infrared_tx_raw_unpacker;
+static uint32_t infrared_tx_raw_next_timing = 0;
 
 FuriHalInfraredTxGetDataState
     infrared_get_raw_data_callback(void* context, uint32_t* duration, bool* level) {
@@ -56,6 +59,52 @@ void infrared_send_raw_ext(
     furi_assert(!furi_hal_infrared_is_busy());
 }
 
+static FuriHalInfraredTxGetDataState
+    infrared_get_raw_packed_data_callback(void* context, uint32_t* duration, bool* level) {
+    furi_assert(duration);
+    furi_assert(level);
+    UNUSED(context);
+
+    FuriHalInfraredTxGetDataState state = FuriHalInfraredTxGetDataStateOk;
+
+    if(infrared_tx_raw_add_silence) {
+        infrared_tx_raw_add_silence = false;
+        *level = false;
+        *duration = INFRARED_RAW_TX_TIMING_DELAY_US;
+    } else {
+        *level = !(infrared_tx_raw_timings_index % 2);
+        *duration = infrared_tx_raw_next_timing;
+        ++infrared_tx_raw_timings_index;
+        /* Look one timing ahead to mark the last one */
+        if(!infrared_raw_unpacker_next(&infrared_tx_raw_unpacker, &infrared_tx_raw_next_timing)) {
+            state = FuriHalInfraredTxGetDataStateLastDone;
+        }
+    }
+
+    return state;
+}
+
+void infrared_send_raw_packed_ext(
+    const uint8_t* data,
+    size_t size,
+    uint32_t frequency,
+    float duty_cycle) {
+    furi_assert(data);
+
+    infrared_raw_unpacker_init(&infrared_tx_raw_unpacker, data, size);
+    if(!infrared_raw_unpacker_next(&infrared_tx_raw_unpacker, &infrared_tx_raw_next_timing)) {
+        return;
+    }
+
+    infrared_tx_raw_timings_index = 0;
+    infrared_tx_raw_add_silence = true;
+    furi_hal_infrared_async_tx_set_data_isr_callback(infrared_get_raw_packed_data_callback, NULL);
+    furi_hal_infrared_async_tx_start(frequency, duty_cycle);
+    furi_hal_infrared_async_tx_wait_termination();
+
+    furi_assert(!furi_hal_infrared_is_busy());
+}
+
 void infrared_send_raw(const uint32_t timings[], uint32_t timings_cnt, bool start_from_mark) {
     infrared_send_raw_ext(
         timings,
@@ -41,6 +41,20 @@ void infrared_send_raw_ext(
     uint32_t frequency,
     float duty_cycle);
 
+/**
+ * Send packed raw data through infrared port, timings are unpacked on the fly.
+ *
+ * \param[in]   data - packed timings starting from mark, see infrared_raw_pack.h
+ * \param[in]   size - packed data size
+ * \param[in]   frequency - frequency to generate on PWM
+ * \param[in]   duty_cycle - duty cycle to generate on PWM
+ */
+void infrared_send_raw_packed_ext(
+    const uint8_t* data,
+    size_t size,
+    uint32_t frequency,
+    float duty_cycle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,4 +1,5 @@
 #include "infrared_worker.h"
+#include "infrared_raw_pack.h"
 
 #include <furi_hal_infrared.h>
 #include <float_tools.h>
@@ -45,6 +46,9 @@ struct InfraredWorkerSignal {
             uint32_t timings[MAX_TIMINGS_AMOUNT + 1];
             uint32_t frequency;
             float duty_cycle;
+            /* Set instead of timings for packed signals, owned by caller */
+            const uint8_t* packed;
+            size_t packed_size;
         } raw;
     };
 };
@@ -70,6 +74,8 @@ struct InfraredWorker {
             uint32_t frequency;
             float duty_cycle;
             uint32_t tx_raw_cnt;
+            uint32_t tx_raw_next;
+            InfraredRawUnpacker tx_raw_unpacker;
             bool need_reinitialization;
             bool steady_signal_sent;
         } tx;
@@ -420,6 +426,32 @@ static bool infrared_get_new_signal(InfraredWorker* instance) {
     return new_signal_obtained;
 }
 
+static InfraredStatus
+    infrared_worker_tx_get_packed_timing(InfraredWorker* instance, InfraredWorkerTiming* timing) {
+    InfraredRawUnpacker* unpacker = &instance->tx.tx_raw_unpacker;
+
+    /* raw always starts from Mark, but we fill it with space delay at start */
+    if(instance->tx.tx_raw_cnt == 0) {
+        infrared_raw_unpacker_init(
+            unpacker, instance->signal.raw.packed, instance->signal.raw.packed_size);
+        furi_check(infrared_raw_unpacker_next(unpacker, &instance->tx.tx_raw_next));
+        timing->duration = INFRARED_RAW_TX_TIMING_DELAY_US;
+    } else {
+        timing->duration = instance->tx.tx_raw_next;
+    }
+    timing->level = (instance->tx.tx_raw_cnt % 2);
+    ++instance->tx.tx_raw_cnt;
+
+    /* Look one timing ahead to mark the last one */
+    if((instance->tx.tx_raw_cnt > 1) &&
+       !infrared_raw_unpacker_next(unpacker, &instance->tx.tx_raw_next)) {
+        instance->tx.tx_raw_cnt = 0;
+        return InfraredStatusDone;
+    }
+
+    return InfraredStatusOk;
+}
+
 static bool infrared_worker_tx_fill_buffer(InfraredWorker* instance) {
     bool new_data_available = true;
     InfraredWorkerTiming timing;
@@ -429,6 +461,8 @@ static bool infrared_worker_tx_fill_buffer(InfraredWorker* instance) {
           new_data_available) {
         if(instance->signal.decoded) {
             status = infrared_encode(instance->infrared_encoder, &timing.duration, &timing.level);
+        } else if(instance->signal.raw.packed) {
+            status = infrared_worker_tx_get_packed_timing(instance, &timing);
         } else {
             timing.duration = instance->signal.raw.timings[instance->tx.tx_raw_cnt];
             /* raw always starts from Mark, but we fill it with space delay at start */
@@ -584,6 +618,7 @@ void infrared_worker_tx_stop(InfraredWorker* instance) {
     furi_hal_infrared_async_tx_set_signal_sent_isr_callback(NULL, NULL);
 
     instance->signal.timings_cnt = 0;
+    instance->signal.raw.packed = NULL;
     FuriStatus status = furi_stream_buffer_reset(instance->stream);
     furi_assert(status == FuriStatusOk);
     (void)status;
@@ -616,6 +651,29 @@ void infrared_worker_set_raw_signal(
     instance->signal.raw.duty_cycle = duty_cycle;
     instance->signal.raw.timings[0] = INFRARED_RAW_TX_TIMING_DELAY_US;
     memcpy(&instance->signal.raw.timings[1], timings, timings_cnt * sizeof(uint32_t));
+    instance->signal.raw.packed = NULL;
+    instance->signal.raw.packed_size = 0;
+    instance->signal.decoded = false;
+    instance->signal.timings_cnt = timings_cnt + 1;
+}
+
+void infrared_worker_set_raw_signal_packed(
+    InfraredWorker* instance,
+    const uint8_t* data,
+    size_t size,
+    uint32_t frequency,
+    float duty_cycle) {
+    furi_assert(instance);
+    furi_assert(data);
+    furi_assert((frequency <= INFRARED_MAX_FREQUENCY) && (frequency >= INFRARED_MIN_FREQUENCY));
+    furi_assert((duty_cycle < 1.0f) && (duty_cycle > 0.0f));
+    size_t timings_cnt = infrared_raw_pack_get_timings_count(data, size);
+    furi_check(timings_cnt > 0);
+
+    instance->signal.raw.frequency = frequency;
+    instance->signal.raw.duty_cycle = duty_cycle;
+    instance->signal.raw.packed = data;
+    instance->signal.raw.packed_size = size;
     instance->signal.decoded = false;
     instance->signal.timings_cnt = timings_cnt + 1;
 }
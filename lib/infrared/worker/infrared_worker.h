@@ -182,6 +182,23 @@ void infrared_worker_set_raw_signal(
     uint32_t frequency,
     float duty_cycle);
 
+/** Set current raw signal in packed form for InfraredWorker instance
+ *
+ * Packed data is not copied and must stay valid until transmission stops.
+ *
+ * @param[out]  instance - InfraredWorker instance
+ * @param[in]   data - packed timings, see infrared_raw_pack.h
+ * @param[in]   size - packed data size
+ * @param[in]   frequency - carrier frequency in Hertz
+ * @param[in]   duty_cycle - carrier duty cycle (0.0 - 1.0)
+ */
+void infrared_worker_set_raw_signal_packed(
+    InfraredWorker* instance,
+    const uint8_t* data,
+    size_t size,
+    uint32_t frequency,
+    float duty_cycle);
+
 #ifdef __cplusplus
 }
 #endif
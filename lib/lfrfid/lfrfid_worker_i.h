@@ -38,6 +38,7 @@ struct LFRFIDWorker {
     FuriThread* thread;
 
     LFRFIDWorkerReadType read_type;
+    LFRFIDFeature read_feature_last; /**< family of last auto read, tried first next time */
 
     LFRFIDWorkerReadCallback read_cb;
     LFRFIDWorkerWriteCallback write_cb;
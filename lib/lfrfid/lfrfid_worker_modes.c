@@ -27,6 +27,8 @@
 #define LFRFID_WORKER_READ_DROP_TIME_MS 50
 #define LFRFID_WORKER_READ_STABILIZE_TIME_MS 450
 #define LFRFID_WORKER_READ_SWITCH_TIME_MS 2000
+// Card is in the field, but none of current family protocols decoded it
+#define LFRFID_WORKER_READ_SENSE_SWITCH_TIME_MS 700
 
 #define LFRFID_WORKER_WRITE_VERIFY_TIME_MS 2000
 #define LFRFID_WORKER_WRITE_DROP_TIME_MS 50
@@ -140,8 +142,11 @@ static LFRFIDWorkerReadState lfrfid_worker_read_ttf( //tag talks first
     uint8_t* last_data = malloc(last_size);
     uint8_t* protocol_data = malloc(last_size);
     size_t last_read_count = 0;
+    // Every varint pair takes at least 2 bytes and gives 2 durations
+    uint32_t* durations = malloc(LFRFID_WORKER_READ_BUFFER_SIZE * sizeof(uint32_t));
 
     uint32_t switch_os_tick_last = furi_get_tick();
+    uint32_t sense_os_tick = 0;
 
     uint32_t average_duration = 0;
     uint32_t average_pulse = 0;
@@ -180,6 +185,7 @@ static LFRFIDWorkerReadState lfrfid_worker_read_ttf( //tag talks first
         size_t size = buffer_get_size(buffer);
         uint8_t* data = buffer_get_data(buffer);
         size_t index = 0;
+        size_t durations_count = 0;
 
         while(index < size) {
             uint32_t duration;
@@ -201,16 +207,19 @@ static LFRFIDWorkerReadState lfrfid_worker_read_ttf( //tag talks first
                     average_duration = 0;
                     average_index = 0;
 
-                    if(worker->read_cb) {
-                        if(average > 0.2f && average < 0.8f) {
-                            if(!card_detected) {
-                                card_detected = true;
+                    if(average > 0.2f && average < 0.8f) {
+                        if(!card_detected) {
+                            card_detected = true;
+                            sense_os_tick = furi_get_tick();
+                            if(worker->read_cb) {
                                 worker->read_cb(
                                     LFRFIDWorkerReadSenseStart, PROTOCOL_NO, worker->cb_ctx);
                             }
-                        } else {
-                            if(card_detected) {
-                                card_detected = false;
+                        }
+                    } else {
+                        if(card_detected) {
+                            card_detected = false;
+                            if(worker->read_cb) {
                                 worker->read_cb(
                                     LFRFIDWorkerReadSenseEnd, PROTOCOL_NO, worker->cb_ctx);
                             }
@@ -218,70 +227,79 @@ static LFRFIDWorkerReadState lfrfid_worker_read_ttf( //tag talks first
                     }
                 }
 
-                ProtocolId protocol = PROTOCOL_NO;
-
-                protocol = protocol_dict_decoders_feed_by_feature(
-                    worker->protocols, feature, true, pulse);
-                if(protocol == PROTOCOL_NO) {
-                    protocol = protocol_dict_decoders_feed_by_feature(
-                        worker->protocols, feature, false, duration - pulse);
-                }
-
-                if(protocol != PROTOCOL_NO) {
-                    // reset switch timer
-                    switch_os_tick_last = furi_get_tick();
-
-                    size_t protocol_data_size =
-                        protocol_dict_get_data_size(worker->protocols, protocol);
-                    protocol_dict_get_data(
-                        worker->protocols, protocol, protocol_data, protocol_data_size);
-
-                    // validate protocol
-                    if(protocol == last_protocol &&
-                       memcmp(last_data, protocol_data, protocol_data_size) == 0) {
-                        last_read_count = last_read_count + 1;
-
-                        size_t validation_count =
-                            protocol_dict_get_validate_count(worker->protocols, protocol);
-
-                        if(last_read_count >= validation_count) {
-                            state = LFRFIDWorkerReadOK;
-                            *result_protocol = protocol;
-                            break;
-                        }
-                    } else {
-                        if(last_protocol == PROTOCOL_NO && worker->read_cb) {
-                            worker->read_cb(
-                                LFRFIDWorkerReadSenseCardStart, protocol, worker->cb_ctx);
-                        }
+                durations[durations_count++] = pulse;
+                durations[durations_count++] = duration - pulse;
+            }
+        }
 
-                        last_protocol = protocol;
-                        memcpy(last_data, protocol_data, protocol_data_size);
-                        last_read_count = 0;
+        size_t position = 0;
+        while(position < durations_count) {
+            size_t consumed = 0;
+            ProtocolId protocol = protocol_dict_decoders_feed_batch_by_feature(
+                worker->protocols,
+                feature,
+                true,
+                &durations[position],
+                durations_count - position,
+                &consumed);
+            position += consumed;
+
+            if(protocol != PROTOCOL_NO) {
+                // Decoder got ready on pulse, rest of the period is not fed
+                position += position & 1;
+
+                // reset switch timer
+                switch_os_tick_last = furi_get_tick();
+
+                size_t protocol_data_size =
+                    protocol_dict_get_data_size(worker->protocols, protocol);
+                protocol_dict_get_data(
+                    worker->protocols, protocol, protocol_data, protocol_data_size);
+
+                // validate protocol
+                if(protocol == last_protocol &&
+                   memcmp(last_data, protocol_data, protocol_data_size) == 0) {
+                    last_read_count = last_read_count + 1;
+
+                    size_t validation_count =
+                        protocol_dict_get_validate_count(worker->protocols, protocol);
+
+                    if(last_read_count >= validation_count) {
+                        state = LFRFIDWorkerReadOK;
+                        *result_protocol = protocol;
+                        break;
+                    }
+                } else {
+                    if(last_protocol == PROTOCOL_NO && worker->read_cb) {
+                        worker->read_cb(LFRFIDWorkerReadSenseCardStart, protocol, worker->cb_ctx);
                     }
 
-                    if(furi_log_get_level() >= FuriLogLevelDebug) {
-                        FuriString* string_info;
-                        string_info = furi_string_alloc();
-                        for(uint8_t i = 0; i < protocol_data_size; i++) {
-                            if(i != 0) {
-                                furi_string_cat_printf(string_info, " ");
-                            }
+                    last_protocol = protocol;
+                    memcpy(last_data, protocol_data, protocol_data_size);
+                    last_read_count = 0;
+                }
 
-                            furi_string_cat_printf(string_info, "%02X", protocol_data[i]);
+                if(furi_log_get_level() >= FuriLogLevelDebug) {
+                    FuriString* string_info;
+                    string_info = furi_string_alloc();
+                    for(uint8_t i = 0; i < protocol_data_size; i++) {
+                        if(i != 0) {
+                            furi_string_cat_printf(string_info, " ");
                         }
 
-                        FURI_LOG_D(
-                            TAG,
-                            "%s, %zu, [%s]",
-                            protocol_dict_get_name(worker->protocols, protocol),
-                            last_read_count,
-                            furi_string_get_cstr(string_info));
-                        furi_string_free(string_info);
+                        furi_string_cat_printf(string_info, "%02X", protocol_data[i]);
                     }
 
-                    protocol_dict_decoders_start(worker->protocols);
+                    FURI_LOG_D(
+                        TAG,
+                        "%s, %zu, [%s]",
+                        protocol_dict_get_name(worker->protocols, protocol),
+                        last_read_count,
+                        furi_string_get_cstr(string_info));
+                    furi_string_free(string_info);
                 }
+
+                protocol_dict_decoders_start(worker->protocols);
             }
         }
 
@@ -299,6 +317,15 @@ static LFRFIDWorkerReadState lfrfid_worker_read_ttf( //tag talks first
             state = LFRFIDWorkerReadTimeout;
             break;
         }
+
+        // Don't wait for the whole window if the card is not of this family
+        if(worker->read_type == LFRFIDWorkerReadTypeAuto && card_detected &&
+           last_protocol == PROTOCOL_NO &&
+           (furi_get_tick() - sense_os_tick) > LFRFID_WORKER_READ_SENSE_SWITCH_TIME_MS) {
+            FURI_LOG_D(TAG, "Card sensed but not decoded, switching");
+            state = LFRFIDWorkerReadTimeout;
+            break;
+        }
     }
 
     FURI_LOG_D(TAG, "Read stopped");
@@ -318,6 +345,7 @@ static LFRFIDWorkerReadState lfrfid_worker_read_ttf( //tag talks first
     varint_pair_free(ctx.pair);
     buffer_stream_free(ctx.stream);
 
+    free(durations);
     free(protocol_data);
     free(last_data);
 
@@ -397,6 +425,8 @@ static void lfrfid_worker_mode_read_process(LFRFIDWorker* worker) {
         feature = LFRFIDFeaturePSK;
     } else if(worker->read_type == LFRFIDWorkerReadTypeRTFOnly) {
         feature = LFRFIDFeatureRTF;
+    } else if(worker->read_feature_last) {
+        feature = worker->read_feature_last;
     } else {
         feature = LFRFIDFeatureASK;
     }
@@ -413,7 +443,10 @@ static void lfrfid_worker_mode_read_process(LFRFIDWorker* worker) {
                     worker, feature, LFRFID_WORKER_READ_SWITCH_TIME_MS, &read_result);
             }
 
-            if(state == LFRFIDWorkerReadOK || state == LFRFIDWorkerReadExit) {
+            if(state == LFRFIDWorkerReadOK) {
+                worker->read_feature_last = feature;
+                break;
+            } else if(state == LFRFIDWorkerReadExit) {
                 break;
             }
 
@@ -0,0 +1,305 @@
+#include "mf_classic_key_stats.h"
+
+#include <furi.h>
+#include <furi_hal_rtc.h>
+#include <lib/toolbox/path.h>
+#include <lib/flipper_format/flipper_format.h>
+#include <lib/nfc/protocols/nfc_util.h>
+
+#define TAG "MfClassicKeyStats"
+
+#define MF_CLASSIC_KEY_STATS_FILE_TYPE "Flipper MF Classic key stats"
+#define MF_CLASSIC_KEY_STATS_VERSION (1)
+
+/* hits on cards of the same class count that many times more */
+#define MF_CLASSIC_KEY_STATS_CLASS_WEIGHT (4)
+
+typedef struct {
+    uint8_t key[6];
+    uint16_t hits;
+    uint32_t last_hit;
+    uint32_t card_class;
+} MfClassicKeyStatsRecord;
+
+typedef struct {
+    uint64_t key;
+    uint32_t score;
+    uint32_t last_hit;
+} MfClassicKeyStatsRank;
+
+struct MfClassicKeyStats {
+    Storage* storage;
+    FuriString* path;
+    MfClassicKeyStatsRecord* records;
+    size_t count;
+    bool changed;
+
+    MfClassicKeyStatsRank* ranked;
+    size_t ranked_count;
+    size_t ranked_pos;
+};
+
+static bool mf_classic_key_stats_read_record(
+    FlipperFormat* flipper_format,
+    MfClassicKeyStatsRecord* record) {
+    uint8_t card_class[4];
+    uint32_t hits = 0;
+
+    if(!flipper_format_read_hex(flipper_format, "Key", record->key, sizeof(record->key)))
+        return false;
+    if(!flipper_format_read_hex(flipper_format, "Class", card_class, sizeof(card_class)))
+        return false;
+    if(!flipper_format_read_uint32(flipper_format, "Hits", &hits, 1)) return false;
+    if(!flipper_format_read_uint32(flipper_format, "Last hit", &record->last_hit, 1))
+        return false;
+
+    record->card_class = nfc_util_bytes2num(card_class, sizeof(card_class));
+    record->hits = MIN(hits, UINT16_MAX);
+    return true;
+}
+
+static bool mf_classic_key_stats_load(MfClassicKeyStats* stats) {
+    FlipperFormat* flipper_format = flipper_format_buffered_file_alloc(stats->storage);
+    FuriString* temp_str = furi_string_alloc();
+    bool loaded = false;
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(
+               flipper_format, furi_string_get_cstr(stats->path)))
+            break;
+
+        uint32_t version = 0;
+        if(!flipper_format_read_header(flipper_format, temp_str, &version)) break;
+        if(furi_string_cmp_str(temp_str, MF_CLASSIC_KEY_STATS_FILE_TYPE) ||
+           version != MF_CLASSIC_KEY_STATS_VERSION) {
+            FURI_LOG_W(TAG, "Unsupported statistics file");
+            break;
+        }
+
+        uint32_t count = 0;
+        if(!flipper_format_read_uint32(flipper_format, "Count", &count, 1)) break;
+        if(count > MF_CLASSIC_KEY_STATS_RECORDS_MAX) break;
+
+        size_t read = 0;
+        for(; read < count; read++) {
+            if(!mf_classic_key_stats_read_record(flipper_format, &stats->records[read])) break;
+        }
+        if(read != count) break;
+        stats->count = count;
+
+        loaded = true;
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(flipper_format);
+
+    return loaded;
+}
+
+MfClassicKeyStats* mf_classic_key_stats_alloc(Storage* storage, const char* path) {
+    furi_assert(storage);
+    furi_assert(path);
+
+    MfClassicKeyStats* stats = malloc(sizeof(MfClassicKeyStats));
+    stats->storage = storage;
+    stats->path = furi_string_alloc_set(path);
+    stats->records = malloc(sizeof(MfClassicKeyStatsRecord) * MF_CLASSIC_KEY_STATS_RECORDS_MAX);
+
+    if(mf_classic_key_stats_load(stats)) {
+        FURI_LOG_I(TAG, "Loaded %zu records", stats->count);
+    } else {
+        stats->count = 0;
+    }
+
+    return stats;
+}
+
+void mf_classic_key_stats_free(MfClassicKeyStats* stats) {
+    furi_assert(stats);
+
+    furi_string_free(stats->path);
+    free(stats->records);
+    free(stats->ranked);
+    free(stats);
+}
+
+bool mf_classic_key_stats_save(MfClassicKeyStats* stats) {
+    furi_assert(stats);
+
+    if(!stats->changed) return true;
+
+    FlipperFormat* flipper_format = flipper_format_file_alloc(stats->storage);
+    FuriString* dir_path = furi_string_alloc();
+    bool saved = false;
+
+    do {
+        path_extract_dirname(furi_string_get_cstr(stats->path), dir_path);
+        if(!storage_simply_mkdir(stats->storage, furi_string_get_cstr(dir_path))) break;
+        if(!flipper_format_file_open_always(flipper_format, furi_string_get_cstr(stats->path)))
+            break;
+
+        if(!flipper_format_write_header_cstr(
+               flipper_format, MF_CLASSIC_KEY_STATS_FILE_TYPE, MF_CLASSIC_KEY_STATS_VERSION))
+            break;
+        uint32_t count = stats->count;
+        if(!flipper_format_write_uint32(flipper_format, "Count", &count, 1)) break;
+
+        size_t written = 0;
+        for(; written < stats->count; written++) {
+            MfClassicKeyStatsRecord* record = &stats->records[written];
+            uint8_t card_class[4];
+            uint32_t hits = record->hits;
+            nfc_util_num2bytes(record->card_class, sizeof(card_class), card_class);
+
+            if(!flipper_format_write_hex(flipper_format, "Key", record->key, sizeof(record->key)))
+                break;
+            if(!flipper_format_write_hex(flipper_format, "Class", card_class, sizeof(card_class)))
+                break;
+            if(!flipper_format_write_uint32(flipper_format, "Hits", &hits, 1)) break;
+            if(!flipper_format_write_uint32(flipper_format, "Last hit", &record->last_hit, 1))
+                break;
+        }
+        if(written != stats->count) break;
+
+        stats->changed = false;
+        saved = true;
+    } while(false);
+
+    if(!saved) {
+        FURI_LOG_E(TAG, "Failed to save statistics");
+    }
+
+    furi_string_free(dir_path);
+    flipper_format_free(flipper_format);
+
+    return saved;
+}
+
+uint32_t mf_classic_key_stats_get_card_class(FuriHalNfcDevData* nfc_data) {
+    furi_assert(nfc_data);
+
+    // First byte of 4 byte UIDs is random, of 7 byte ones - manufacturer
+    uint8_t manufacturer = (nfc_data->uid_len == 7) ? nfc_data->uid[0] : 0;
+
+    return ((uint32_t)nfc_data->atqa[0] << 24) | ((uint32_t)nfc_data->atqa[1] << 16) |
+           ((uint32_t)nfc_data->sak << 8) | manufacturer;
+}
+
+/* Fewest hits, then the oldest */
+static size_t mf_classic_key_stats_get_weakest(MfClassicKeyStats* stats) {
+    size_t weakest = 0;
+    for(size_t i = 1; i < stats->count; i++) {
+        MfClassicKeyStatsRecord* record = &stats->records[i];
+        MfClassicKeyStatsRecord* other = &stats->records[weakest];
+        if(record->hits < other->hits ||
+           (record->hits == other->hits && record->last_hit < other->last_hit)) {
+            weakest = i;
+        }
+    }
+    return weakest;
+}
+
+void mf_classic_key_stats_add_hit(MfClassicKeyStats* stats, uint64_t key, uint32_t card_class) {
+    furi_assert(stats);
+
+    uint8_t key_bytes[6];
+    nfc_util_num2bytes(key, sizeof(key_bytes), key_bytes);
+
+    MfClassicKeyStatsRecord* record = NULL;
+    for(size_t i = 0; i < stats->count; i++) {
+        if(stats->records[i].card_class == card_class &&
+           memcmp(stats->records[i].key, key_bytes, sizeof(key_bytes)) == 0) {
+            record = &stats->records[i];
+            break;
+        }
+    }
+
+    if(!record) {
+        if(stats->count < MF_CLASSIC_KEY_STATS_RECORDS_MAX) {
+            record = &stats->records[stats->count++];
+        } else {
+            record = &stats->records[mf_classic_key_stats_get_weakest(stats)];
+        }
+        memcpy(record->key, key_bytes, sizeof(key_bytes));
+        record->card_class = card_class;
+        record->hits = 0;
+    }
+
+    if(record->hits < UINT16_MAX) record->hits++;
+    record->last_hit = furi_hal_rtc_get_timestamp();
+    stats->changed = true;
+}
+
+static int mf_classic_key_stats_rank_cmp(const void* a, const void* b) {
+    const MfClassicKeyStatsRank* rank_a = a;
+    const MfClassicKeyStatsRank* rank_b = b;
+
+    if(rank_a->score != rank_b->score) {
+        return (rank_a->score > rank_b->score) ? -1 : 1;
+    }
+    if(rank_a->last_hit != rank_b->last_hit) {
+        return (rank_a->last_hit > rank_b->last_hit) ? -1 : 1;
+    }
+    return 0;
+}
+
+size_t mf_classic_key_stats_rank(MfClassicKeyStats* stats, uint32_t card_class) {
+    furi_assert(stats);
+
+    free(stats->ranked);
+    stats->ranked = malloc(sizeof(MfClassicKeyStatsRank) * (stats->count + 1));
+    stats->ranked_count = 0;
+    stats->ranked_pos = 0;
+
+    // Same key may be stored for several card classes
+    for(size_t i = 0; i < stats->count; i++) {
+        MfClassicKeyStatsRecord* record = &stats->records[i];
+        uint64_t key = nfc_util_bytes2num(record->key, sizeof(record->key));
+
+        MfClassicKeyStatsRank* rank = NULL;
+        for(size_t j = 0; j < stats->ranked_count; j++) {
+            if(stats->ranked[j].key == key) {
+                rank = &stats->ranked[j];
+                break;
+            }
+        }
+        if(!rank) {
+            rank = &stats->ranked[stats->ranked_count++];
+            rank->key = key;
+            rank->score = 0;
+            rank->last_hit = 0;
+        }
+
+        uint32_t weight = (record->card_class == card_class) ? MF_CLASSIC_KEY_STATS_CLASS_WEIGHT :
+                                                               1;
+        rank->score += record->hits * weight;
+        rank->last_hit = MAX(rank->last_hit, record->last_hit);
+    }
+
+    qsort(
+        stats->ranked,
+        stats->ranked_count,
+        sizeof(MfClassicKeyStatsRank),
+        mf_classic_key_stats_rank_cmp);
+
+    return stats->ranked_count;
+}
+
+bool mf_classic_key_stats_get_next_key(MfClassicKeyStats* stats, uint64_t* key) {
+    furi_assert(stats);
+    furi_assert(key);
+
+    if(stats->ranked_pos >= stats->ranked_count) return false;
+
+    *key = stats->ranked[stats->ranked_pos++].key;
+    return true;
+}
+
+bool mf_classic_key_stats_is_ranked(MfClassicKeyStats* stats, uint64_t key) {
+    furi_assert(stats);
+
+    for(size_t i = 0; i < stats->ranked_count; i++) {
+        if(stats->ranked[i].key == key) return true;
+    }
+    return false;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdbool.h>
+#include <storage/storage.h>
+#include <furi_hal_nfc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MF_CLASSIC_KEY_STATS_PATH EXT_PATH("nfc/.cache/mf_classic_key_stats.txt")
+
+/** Stored key and card class pairs, least useful ones get replaced */
+#define MF_CLASSIC_KEY_STATS_RECORDS_MAX (256)
+
+typedef struct MfClassicKeyStats MfClassicKeyStats;
+
+/** Allocate MfClassicKeyStats instance and load statistics
+ *
+ * Missing or damaged file gives empty statistics.
+ *
+ * @param      storage  Storage instance
+ * @param[in]  path     statistics file path
+ *
+ * @return     MfClassicKeyStats instance
+ */
+MfClassicKeyStats* mf_classic_key_stats_alloc(Storage* storage, const char* path);
+
+/** Free MfClassicKeyStats instance, changes are not saved
+ *
+ * @param      stats  MfClassicKeyStats instance
+ */
+void mf_classic_key_stats_free(MfClassicKeyStats* stats);
+
+/** Save statistics if they were changed
+ *
+ * @param      stats  MfClassicKeyStats instance
+ *
+ * @return     true on success
+ */
+bool mf_classic_key_stats_save(MfClassicKeyStats* stats);
+
+/** Get card class
+ *
+ * Cards of the same class share ATQA, SAK and, for 7 byte UIDs, manufacturer.
+ *
+ * @param[in]  nfc_data  FuriHalNfcDevData of the card
+ *
+ * @return     card class
+ */
+uint32_t mf_classic_key_stats_get_card_class(FuriHalNfcDevData* nfc_data);
+
+/** Count successful authentication with the key
+ *
+ * @param      stats       MfClassicKeyStats instance
+ * @param[in]  key         key that opened a sector
+ * @param[in]  card_class  class of the card
+ */
+void mf_classic_key_stats_add_hit(MfClassicKeyStats* stats, uint64_t key, uint32_t card_class);
+
+/** Rank known keys and rewind to the best one
+ *
+ * Hits on cards of the same class weigh more, ties are broken by the last hit time.
+ *
+ * @param      stats       MfClassicKeyStats instance
+ * @param[in]  card_class  class of the card to attack
+ *
+ * @return     ranked keys count
+ */
+size_t mf_classic_key_stats_rank(MfClassicKeyStats* stats, uint32_t card_class);
+
+/** Get next ranked key
+ *
+ * @param      stats  MfClassicKeyStats instance
+ * @param[out] key    key
+ *
+ * @return     true if key was returned, false after the last one
+ */
+bool mf_classic_key_stats_get_next_key(MfClassicKeyStats* stats, uint64_t* key);
+
+/** Check if key is among ranked keys
+ *
+ * @param      stats  MfClassicKeyStats instance
+ * @param[in]  key    key
+ *
+ * @return     true if mf_classic_key_stats_get_next_key yields it
+ */
+bool mf_classic_key_stats_is_ranked(MfClassicKeyStats* stats, uint64_t key);
+
+#ifdef __cplusplus
+}
+#endif
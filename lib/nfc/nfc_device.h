@@ -59,6 +59,8 @@ typedef struct {
 typedef struct {
     MfClassicDict* dict;
     uint8_t current_sector;
+    uint16_t keys_per_second;
+    bool ranked_keys_tried; // Set by worker, cleared when a new attack starts
 } NfcMfClassicDictAttackData;
 
 typedef enum {
@@ -1021,6 +1021,12 @@ static bool nfc_worker_mf_get_b_key_from_sector_trailer(
     return false;
 }
 
+static void nfc_worker_mf_classic_add_key_hit(NfcWorker* nfc_worker, uint64_t key) {
+    if(nfc_worker->key_stats) {
+        mf_classic_key_stats_add_hit(nfc_worker->key_stats, key, nfc_worker->key_stats_card_class);
+    }
+}
+
 static void nfc_worker_mf_classic_key_attack(
     NfcWorker* nfc_worker,
     uint64_t key,
@@ -1059,6 +1065,7 @@ static void nfc_worker_mf_classic_key_attack(
                 FURI_LOG_D(TAG, "Trying A key for sector %d, key: %012llX", i, key);
                 if(mf_classic_authenticate(tx_rx, block_num, key, MfClassicKeyA)) {
                     mf_classic_set_key_found(data, i, MfClassicKeyA, key);
+                    nfc_worker_mf_classic_add_key_hit(nfc_worker, key);
                     FURI_LOG_D(TAG, "Key A found: %012llX", key);
                     nfc_worker->callback(NfcWorkerEventFoundKeyA, nfc_worker->context);
 
@@ -1066,6 +1073,7 @@ static void nfc_worker_mf_classic_key_attack(
                     if(nfc_worker_mf_get_b_key_from_sector_trailer(tx_rx, i, key, &found_key)) {
                         FURI_LOG_D(TAG, "Found B key via reading sector %d", i);
                         mf_classic_set_key_found(data, i, MfClassicKeyB, found_key);
+                        nfc_worker_mf_classic_add_key_hit(nfc_worker, found_key);
 
                         if(nfc_worker->state == NfcWorkerStateMfClassicDictAttack) {
                             nfc_worker->callback(NfcWorkerEventFoundKeyB, nfc_worker->context);
@@ -1078,6 +1086,7 @@ static void nfc_worker_mf_classic_key_attack(
                 FURI_LOG_D(TAG, "Trying B key for sector %d, key: %012llX", i, key);
                 if(mf_classic_authenticate(tx_rx, block_num, key, MfClassicKeyB)) {
                     mf_classic_set_key_found(data, i, MfClassicKeyB, key);
+                    nfc_worker_mf_classic_add_key_hit(nfc_worker, key);
                     FURI_LOG_D(TAG, "Key B found: %012llX", key);
                     nfc_worker->callback(NfcWorkerEventFoundKeyB, nfc_worker->context);
                 }
@@ -1097,6 +1106,135 @@ static void nfc_worker_mf_classic_key_attack(
     nfc_worker->callback(NfcWorkerEventKeyAttackStop, nfc_worker->context);
 }
 
+/* Drops keys known before the attack, e.g. from the key cache, that no longer open the card */
+static void
+    nfc_worker_mf_classic_verify_keys(NfcWorker* nfc_worker, FuriHalNfcTxRxContext* tx_rx) {
+    MfClassicData* data = &nfc_worker->dev_data->mf_classic_data;
+    uint32_t total_sectors = mf_classic_get_total_sectors_num(data->type);
+    const MfClassicKey key_types[] = {MfClassicKeyA, MfClassicKeyB};
+
+    for(size_t i = 0; i < total_sectors; i++) {
+        if(mf_classic_is_sector_read(data, i)) continue;
+        uint8_t block_num = mf_classic_get_sector_trailer_block_num_by_sector(i);
+        MfClassicSectorTrailer* sec_trailer = mf_classic_get_sector_trailer_by_sector(data, i);
+
+        for(size_t j = 0; j < COUNT_OF(key_types); j++) {
+            if(!mf_classic_is_key_found(data, i, key_types[j])) continue;
+            uint8_t* key_bytes =
+                (key_types[j] == MfClassicKeyA) ? sec_trailer->key_a : sec_trailer->key_b;
+            uint64_t key = nfc_util_bytes2num(key_bytes, 6);
+
+            // Without the card in the field nothing can be told about the key
+            uint32_t cuid;
+            furi_hal_nfc_sleep();
+            if(!furi_hal_nfc_activate_nfca(200, &cuid)) return;
+            if(!mf_classic_authenticate_skip_activate(
+                   tx_rx, block_num, key, key_types[j], true, cuid)) {
+                mf_classic_set_key_not_found(data, i, key_types[j]);
+                FURI_LOG_D(TAG, "Key %d%c not valid anymore", i, j ? 'B' : 'A');
+            }
+        }
+    }
+}
+
+/* Tries the key on every sector key still unknown. Failed authentication halts the card,
+ * so each attempt needs its own activation. Returns false if the card was lost. */
+static bool nfc_worker_mf_classic_dict_attack_check_key(
+    NfcWorker* nfc_worker,
+    FuriHalNfcTxRxContext* tx_rx,
+    uint64_t key) {
+    MfClassicData* data = &nfc_worker->dev_data->mf_classic_data;
+    NfcMfClassicDictAttackData* dict_attack_data =
+        &nfc_worker->dev_data->mf_classic_dict_attack_data;
+    uint32_t total_sectors = mf_classic_get_total_sectors_num(data->type);
+    const MfClassicKey key_types[] = {MfClassicKeyA, MfClassicKeyB};
+
+    for(size_t i = 0; i < total_sectors; i++) {
+        if(mf_classic_is_sector_read(data, i)) continue;
+        uint8_t block_num = mf_classic_get_sector_trailer_block_num_by_sector(i);
+
+        for(size_t j = 0; j < COUNT_OF(key_types); j++) {
+            if(mf_classic_is_key_found(data, i, key_types[j])) continue;
+
+            uint32_t cuid;
+            furi_hal_nfc_sleep();
+            if(!furi_hal_nfc_activate_nfca(200, &cuid)) return false;
+            if(!mf_classic_authenticate_skip_activate(
+                   tx_rx, block_num, key, key_types[j], true, cuid)) {
+                continue;
+            }
+
+            dict_attack_data->current_sector = i;
+            mf_classic_set_key_found(data, i, key_types[j], key);
+            nfc_worker_mf_classic_add_key_hit(nfc_worker, key);
+            FURI_LOG_D(TAG, "Key %d%c found: %012llX", i, j ? 'B' : 'A', key);
+            nfc_worker->callback(
+                j ? NfcWorkerEventFoundKeyB : NfcWorkerEventFoundKeyA, nfc_worker->context);
+
+            uint64_t found_key;
+            if(key_types[j] == MfClassicKeyA && !mf_classic_is_key_found(data, i, MfClassicKeyB) &&
+               nfc_worker_mf_get_b_key_from_sector_trailer(tx_rx, i, key, &found_key)) {
+                FURI_LOG_D(TAG, "Found B key via reading sector %d", i);
+                mf_classic_set_key_found(data, i, MfClassicKeyB, found_key);
+                nfc_worker_mf_classic_add_key_hit(nfc_worker, found_key);
+                nfc_worker->callback(NfcWorkerEventFoundKeyB, nfc_worker->context);
+
+                // Later sectors get the dictionary key anyway, but not the one read from the card
+                if(found_key != key && i + 1 < total_sectors) {
+                    nfc_worker_mf_classic_key_attack(nfc_worker, found_key, tx_rx, i + 1);
+                }
+            }
+        }
+
+        if(mf_classic_is_key_found(data, i, MfClassicKeyA) &&
+           mf_classic_is_key_found(data, i, MfClassicKeyB)) {
+            mf_classic_read_sector(tx_rx, data, i);
+            if(mf_classic_is_sector_read(data, i)) {
+                nfc_worker->callback(NfcWorkerEventNewSector, nfc_worker->context);
+            }
+        }
+        if(nfc_worker->state != NfcWorkerStateMfClassicDictAttack) break;
+    }
+
+    return true;
+}
+
+static bool nfc_worker_mf_classic_is_all_keys_found(MfClassicData* data) {
+    uint32_t total_sectors = mf_classic_get_total_sectors_num(data->type);
+    for(size_t i = 0; i < total_sectors; i++) {
+        if(!mf_classic_is_key_found(data, i, MfClassicKeyA) ||
+           !mf_classic_is_key_found(data, i, MfClassicKeyB)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Repeats the key until it was checked with the card in the field. Returns false if stopped */
+static bool nfc_worker_mf_classic_dict_attack_try_key(
+    NfcWorker* nfc_worker,
+    FuriHalNfcTxRxContext* tx_rx,
+    uint64_t key,
+    bool* card_present,
+    bool* card_lost) {
+    *card_lost = false;
+    while(!nfc_worker_mf_classic_dict_attack_check_key(nfc_worker, tx_rx, key)) {
+        *card_lost = true;
+        if(*card_present) {
+            nfc_worker->callback(NfcWorkerEventNoCardDetected, nfc_worker->context);
+            *card_present = false;
+        }
+        if(nfc_worker->state != NfcWorkerStateMfClassicDictAttack) return false;
+        furi_delay_ms(100);
+    }
+    if(!*card_present) {
+        nfc_worker->callback(NfcWorkerEventCardDetected, nfc_worker->context);
+        *card_present = true;
+    }
+
+    return nfc_worker->state == NfcWorkerStateMfClassicDictAttack;
+}
+
 void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
     furi_assert(nfc_worker);
     furi_assert(nfc_worker->callback);
@@ -1106,10 +1244,9 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
         &nfc_worker->dev_data->mf_classic_dict_attack_data;
     uint32_t total_sectors = mf_classic_get_total_sectors_num(data->type);
     uint64_t key = 0;
-    uint64_t prev_key = 0;
     FuriHalNfcTxRxContext tx_rx = {};
-    bool card_found_notified = true;
-    bool card_removed_notified = false;
+    bool card_present = true;
+    bool card_lost = false;
 
     // Load dictionary
     MfClassicDict* dict = dict_attack_data->dict;
@@ -1121,121 +1258,80 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
 
     FURI_LOG_D(
         TAG, "Start Dictionary attack, Key Count %lu", mf_classic_dict_get_total_keys(dict));
-    for(size_t i = 0; i < total_sectors; i++) {
-        FURI_LOG_I(TAG, "Sector %d", i);
-        nfc_worker->callback(NfcWorkerEventNewSector, nfc_worker->context);
-        uint8_t block_num = mf_classic_get_sector_trailer_block_num_by_sector(i);
-        if(mf_classic_is_sector_read(data, i)) continue;
-        if(mf_classic_is_key_found(data, i, MfClassicKeyA) &&
-           mf_classic_is_key_found(data, i, MfClassicKeyB))
-            continue;
-        uint16_t key_index = 0;
-        while(mf_classic_dict_get_next_key(dict, &key)) {
-            FURI_LOG_T(TAG, "Key %d", key_index);
-            if(++key_index % NFC_DICT_KEY_BATCH_SIZE == 0) {
-                nfc_worker->callback(NfcWorkerEventNewDictKeyBatch, nfc_worker->context);
+
+    nfc_worker->key_stats =
+        mf_classic_key_stats_alloc(nfc_worker->storage, MF_CLASSIC_KEY_STATS_PATH);
+    nfc_worker->key_stats_card_class =
+        mf_classic_key_stats_get_card_class(&nfc_worker->dev_data->nfc_data);
+    size_t ranked_keys =
+        mf_classic_key_stats_rank(nfc_worker->key_stats, nfc_worker->key_stats_card_class);
+    FURI_LOG_D(
+        TAG,
+        "Card class %08lX, %zu keys with hits",
+        nfc_worker->key_stats_card_class,
+        ranked_keys);
+
+    nfc_worker_mf_classic_verify_keys(nfc_worker, &tx_rx);
+    dict_attack_data->keys_per_second = 0;
+
+    // Keys that opened cards before go first, best ones for this kind of card.
+    // Once per attack, following dictionaries only skip them.
+    bool running = true;
+    if(!dict_attack_data->ranked_keys_tried) {
+        while(running && !nfc_worker_mf_classic_is_all_keys_found(data) &&
+              mf_classic_key_stats_get_next_key(nfc_worker->key_stats, &key)) {
+            running = nfc_worker_mf_classic_dict_attack_try_key(
+                nfc_worker, &tx_rx, key, &card_present, &card_lost);
+        }
+        dict_attack_data->ranked_keys_tried = running;
+    }
+
+    // Single dictionary pass, every key is tried on all sectors at once
+    uint32_t key_index = 0;
+    uint32_t keys_timed = 0;
+    uint32_t start_tick = furi_get_tick();
+    while(running && !nfc_worker_mf_classic_is_all_keys_found(data) &&
+          mf_classic_dict_get_next_key(dict, &key)) {
+        FURI_LOG_T(TAG, "Key %lu", key_index);
+
+        if(!mf_classic_key_stats_is_ranked(nfc_worker->key_stats, key)) {
+            running = nfc_worker_mf_classic_dict_attack_try_key(
+                nfc_worker, &tx_rx, key, &card_present, &card_lost);
+            if(!running) break;
+            // Only time keys checked with the card present
+            if(card_lost) {
+                start_tick = furi_get_tick();
+                keys_timed = 0;
             }
-            furi_hal_nfc_sleep();
-            uint32_t cuid;
-            if(furi_hal_nfc_activate_nfca(200, &cuid)) {
-                bool deactivated = false;
-                if(!card_found_notified) {
-                    nfc_worker->callback(NfcWorkerEventCardDetected, nfc_worker->context);
-                    card_found_notified = true;
-                    card_removed_notified = false;
-                    nfc_worker_mf_classic_key_attack(nfc_worker, prev_key, &tx_rx, i);
-                    deactivated = true;
-                }
-                FURI_LOG_D(TAG, "Try to auth to sector %d with key %012llX", i, key);
-                if(!mf_classic_is_key_found(data, i, MfClassicKeyA)) {
-                    if(mf_classic_authenticate_skip_activate(
-                           &tx_rx, block_num, key, MfClassicKeyA, !deactivated, cuid)) {
-                        mf_classic_set_key_found(data, i, MfClassicKeyA, key);
-                        FURI_LOG_D(TAG, "Key A found: %012llX", key);
-                        nfc_worker->callback(NfcWorkerEventFoundKeyA, nfc_worker->context);
-
-                        uint64_t found_key;
-                        if(nfc_worker_mf_get_b_key_from_sector_trailer(
-                               &tx_rx, i, key, &found_key)) {
-                            FURI_LOG_D(TAG, "Found B key via reading sector %d", i);
-                            mf_classic_set_key_found(data, i, MfClassicKeyB, found_key);
-
-                            if(nfc_worker->state == NfcWorkerStateMfClassicDictAttack) {
-                                nfc_worker->callback(NfcWorkerEventFoundKeyB, nfc_worker->context);
-                            }
-
-                            nfc_worker_mf_classic_key_attack(nfc_worker, found_key, &tx_rx, i + 1);
-                            break;
-                        }
-                        nfc_worker_mf_classic_key_attack(nfc_worker, key, &tx_rx, i + 1);
-                    }
-                    furi_hal_nfc_sleep();
-                    deactivated = true;
-                } else {
-                    // If the key A is marked as found and matches the searching key, invalidate it
-                    MfClassicSectorTrailer* sec_trailer =
-                        mf_classic_get_sector_trailer_by_sector(data, i);
-
-                    uint8_t current_key[6];
-                    nfc_util_num2bytes(key, 6, current_key);
-
-                    if(mf_classic_is_key_found(data, i, MfClassicKeyA) &&
-                       memcmp(sec_trailer->key_a, current_key, 6) == 0) {
-                        if(!mf_classic_authenticate_skip_activate(
-                               &tx_rx, block_num, key, MfClassicKeyA, !deactivated, cuid)) {
-                            mf_classic_set_key_not_found(data, i, MfClassicKeyA);
-                            FURI_LOG_D(TAG, "Key %dA not found in attack", i);
-                        }
-                    }
-                    furi_hal_nfc_sleep();
-                    deactivated = true;
-                }
-                if(!mf_classic_is_key_found(data, i, MfClassicKeyB)) {
-                    if(mf_classic_authenticate_skip_activate(
-                           &tx_rx, block_num, key, MfClassicKeyB, !deactivated, cuid)) { //-V547
-                        FURI_LOG_D(TAG, "Key B found: %012llX", key);
-                        mf_classic_set_key_found(data, i, MfClassicKeyB, key);
-                        nfc_worker->callback(NfcWorkerEventFoundKeyB, nfc_worker->context);
-                        nfc_worker_mf_classic_key_attack(nfc_worker, key, &tx_rx, i + 1);
-                    }
-                    deactivated = true; //-V1048
-                } else {
-                    // If the key B is marked as found and matches the searching key, invalidate it
-                    MfClassicSectorTrailer* sec_trailer =
-                        mf_classic_get_sector_trailer_by_sector(data, i);
-
-                    uint8_t current_key[6];
-                    nfc_util_num2bytes(key, 6, current_key);
-
-                    if(mf_classic_is_key_found(data, i, MfClassicKeyB) &&
-                       memcmp(sec_trailer->key_b, current_key, 6) == 0) {
-                        if(!mf_classic_authenticate_skip_activate(
-                               &tx_rx, block_num, key, MfClassicKeyB, !deactivated, cuid)) { //-V547
-                            mf_classic_set_key_not_found(data, i, MfClassicKeyB);
-                            FURI_LOG_D(TAG, "Key %dB not found in attack", i);
-                        }
-                        furi_hal_nfc_sleep();
-                        deactivated = true; //-V1048
-                    }
-                }
-                if(mf_classic_is_key_found(data, i, MfClassicKeyA) &&
-                   mf_classic_is_key_found(data, i, MfClassicKeyB))
-                    break;
-                if(nfc_worker->state != NfcWorkerStateMfClassicDictAttack) break;
-            } else {
-                if(!card_removed_notified) {
-                    nfc_worker->callback(NfcWorkerEventNoCardDetected, nfc_worker->context);
-                    card_removed_notified = true;
-                    card_found_notified = false;
+            keys_timed++;
+        }
+
+        if(++key_index % NFC_DICT_KEY_BATCH_SIZE == 0) {
+            uint32_t elapsed = furi_get_tick() - start_tick;
+            if(elapsed) {
+                dict_attack_data->keys_per_second =
+                    (uint64_t)keys_timed * furi_kernel_get_tick_frequency() / elapsed;
+            }
+            nfc_worker->callback(NfcWorkerEventNewDictKeyBatch, nfc_worker->context);
+        }
+    }
+
+    // Sectors with one key left unknown
+    if(nfc_worker->state == NfcWorkerStateMfClassicDictAttack) {
+        for(size_t i = 0; i < total_sectors; i++) {
+            if(!mf_classic_is_sector_read(data, i)) {
+                mf_classic_read_sector(&tx_rx, data, i);
+                if(mf_classic_is_sector_read(data, i)) {
+                    nfc_worker->callback(NfcWorkerEventNewSector, nfc_worker->context);
                 }
-                if(nfc_worker->state != NfcWorkerStateMfClassicDictAttack) break;
             }
-            prev_key = key;
         }
-        if(nfc_worker->state != NfcWorkerStateMfClassicDictAttack) break;
-        mf_classic_read_sector(&tx_rx, data, i);
-        mf_classic_dict_rewind(dict);
     }
+
+    mf_classic_key_stats_save(nfc_worker->key_stats);
+    mf_classic_key_stats_free(nfc_worker->key_stats);
+    nfc_worker->key_stats = NULL;
+
     if(nfc_worker->state == NfcWorkerStateMfClassicDictAttack) {
         nfc_worker->callback(NfcWorkerEventSuccess, nfc_worker->context);
     } else {
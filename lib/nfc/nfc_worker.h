@@ -62,7 +62,7 @@ typedef enum {
 
     // Read Mifare Classic events
     NfcWorkerEventNoDictFound,
-    NfcWorkerEventNewSector,
+    NfcWorkerEventNewSector, // Sector read during dict attack
     NfcWorkerEventNewDictKeyBatch,
     NfcWorkerEventFoundKeyA,
     NfcWorkerEventFoundKeyB,
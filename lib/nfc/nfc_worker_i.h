@@ -17,6 +17,7 @@
 #include <lib/nfc/protocols/nfcv.h>
 #include <lib/nfc/protocols/slix.h>
 #include <lib/nfc/helpers/reader_analyzer.h>
+#include <lib/nfc/helpers/mf_classic_key_stats.h>
 
 struct NfcWorker {
     FuriThread* thread;
@@ -32,6 +33,9 @@ struct NfcWorker {
     NfcWorkerState state;
 
     ReaderAnalyzer* reader_analyzer;
+
+    MfClassicKeyStats* key_stats; /* only during dictionary attack */
+    uint32_t key_stats_card_class;
 };
 
 void nfc_worker_change_state(NfcWorker* nfc_worker, NfcWorkerState state);
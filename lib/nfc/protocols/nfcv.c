@@ -483,6 +483,20 @@ void nfcv_emu_send(
     digital_sequence_send(nfcv->emu_air.nfcv_signal);
     furi_hal_gpio_write(&gpio_spi_r_mosi, GPIO_LEVEL_UNMODULATED);
 
+    /* reported only after the response is out, a late or broken one is lost anyway */
+    DigitalSequenceStats stats;
+    digital_sequence_get_stats(nfcv->emu_air.nfcv_signal, &stats);
+    if(stats.deadline_misses || stats.underruns || stats.timeouts) {
+        FURI_LOG_D(
+            TAG,
+            "Response %luus late (prepare %luus), %lu underruns, %lu timeouts",
+            stats.late_time_max,
+            stats.prepare_time_max,
+            stats.underruns,
+            stats.timeouts);
+        digital_sequence_reset_stats(nfcv->emu_air.nfcv_signal);
+    }
+
     if(tx_rx->sniff_tx) {
         tx_rx->sniff_tx(data, length * 8, false, tx_rx->sniff_context);
     }
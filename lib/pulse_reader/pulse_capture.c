@@ -0,0 +1,344 @@
+#include "pulse_capture.h"
+#include "pulse_reader_i.h"
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi_hal_gpio.h>
+
+#include <stm32wbxx_ll_dma.h>
+#include <stm32wbxx_ll_dmamux.h>
+#include <stm32wbxx_ll_tim.h>
+
+/* DMA interrupt flags are 4 bits per channel, LL_DMA_CHANNEL_x is the channel index */
+#define PULSE_CAPTURE_DMA_FLAG(dma_channel, flag) ((flag) << ((dma_channel)*4U))
+
+typedef struct {
+    DMA_TypeDef* dma;
+    uint32_t dma_channel; /* timer values, GPIO samples go to the next channel */
+    FuriHalInterruptId dma_irq;
+    uint32_t generator;
+    uint32_t request;
+} PulseCaptureResource;
+
+/* DMA1 channels 1 and 2 are used by DigitalSignal, DMA2 is taken by SubGhz, infrared,
+ * RFID, external CC1101 and SPI. First entry matches PulseReader, they share TIM2 anyway */
+static const PulseCaptureResource pulse_capture_resources[PULSE_CAPTURE_CHANNELS_MAX] = {
+    {DMA1,
+     LL_DMA_CHANNEL_4,
+     FuriHalInterruptIdDma1Ch4,
+     LL_DMAMUX_REQ_GEN_0,
+     LL_DMAMUX_REQ_GENERATOR0},
+    {DMA1,
+     LL_DMA_CHANNEL_6,
+     FuriHalInterruptIdDma1Ch6,
+     LL_DMAMUX_REQ_GEN_1,
+     LL_DMAMUX_REQ_GENERATOR1},
+};
+
+typedef struct {
+    const GpioPin* gpio;
+    const PulseCaptureResource* resource;
+    uint32_t* timer_buffer;
+    uint32_t* gpio_buffer;
+    uint32_t pos; /* ring index of the next unread edge */
+    uint32_t read; /* edges consumed since start, wraps like written */
+    uint32_t written; /* timer values written since start, as of the last check */
+    volatile uint32_t wraps; /* completed passes of the timer DMA over the ring */
+    bool level;
+} PulseCaptureChannel;
+
+struct PulseCapture {
+    PulseCaptureChannel channels[PULSE_CAPTURE_CHANNELS_MAX];
+    size_t count;
+    uint32_t size;
+    uint32_t* buffer;
+    GpioPull pull;
+    PulseCaptureStats stats;
+};
+
+PulseCapture* pulse_capture_alloc(const GpioPin* const* gpios, size_t count, uint32_t size) {
+    furi_check(gpios);
+    furi_check(count > 0 && count <= PULSE_CAPTURE_CHANNELS_MAX);
+    furi_check(size > 1);
+
+    PulseCapture* capture = malloc(sizeof(PulseCapture));
+    capture->count = count;
+    capture->size = size;
+    capture->pull = GpioPullNo;
+    capture->buffer = malloc(count * size * 2 * sizeof(uint32_t));
+
+    for(size_t i = 0; i < count; i++) {
+        /* one EXTI line per pin number */
+        for(size_t j = 0; j < i; j++) {
+            furi_check(gpios[j]->pin != gpios[i]->pin);
+        }
+
+        PulseCaptureChannel* channel = &capture->channels[i];
+        channel->gpio = gpios[i];
+        channel->resource = &pulse_capture_resources[i];
+        channel->timer_buffer = &capture->buffer[i * size * 2];
+        channel->gpio_buffer = &capture->buffer[i * size * 2 + size];
+    }
+
+    return capture;
+}
+
+void pulse_capture_free(PulseCapture* capture) {
+    furi_assert(capture);
+
+    free(capture->buffer);
+    free(capture);
+}
+
+void pulse_capture_set_pull(PulseCapture* capture, GpioPull pull) {
+    furi_assert(capture);
+
+    capture->pull = pull;
+}
+
+static void pulse_capture_setup_dma(
+    const PulseCaptureResource* resource,
+    uint32_t dma_channel,
+    uint32_t source,
+    uint32_t* buffer,
+    uint32_t size) {
+    LL_DMA_InitTypeDef dma_config = {
+        .Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY,
+        .PeriphOrM2MSrcAddress = source,
+        .PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT,
+        .PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_WORD,
+        .MemoryOrM2MDstAddress = (uint32_t)buffer,
+        .MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT,
+        .MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_WORD,
+        .Mode = LL_DMA_MODE_CIRCULAR,
+        .NbData = size,
+        .PeriphRequest = resource->request, /* executes LL_DMA_SetPeriphRequest */
+        .Priority = LL_DMA_PRIORITY_VERYHIGH,
+    };
+
+    LL_DMA_Init(resource->dma, dma_channel, &dma_config);
+    LL_DMA_EnableChannel(resource->dma, dma_channel);
+}
+
+static void pulse_capture_dma_isr(void* context) {
+    PulseCaptureChannel* channel = context;
+    const PulseCaptureResource* resource = channel->resource;
+
+    if(resource->dma->ISR & PULSE_CAPTURE_DMA_FLAG(resource->dma_channel, DMA_ISR_TCIF1)) {
+        resource->dma->IFCR = PULSE_CAPTURE_DMA_FLAG(resource->dma_channel, DMA_IFCR_CTCIF1);
+        channel->wraps++;
+    }
+}
+
+void pulse_capture_start(PulseCapture* capture) {
+    furi_assert(capture);
+
+    /* nothing keeps track of DMA channels, at least make sure they are not running */
+    for(size_t i = 0; i < capture->count; i++) {
+        const PulseCaptureResource* resource = capture->channels[i].resource;
+        furi_check(!LL_DMA_IsEnabledChannel(resource->dma, resource->dma_channel));
+        furi_check(!LL_DMA_IsEnabledChannel(resource->dma, resource->dma_channel + 1));
+        furi_check(!LL_DMAMUX_IsEnabledRequestGen(NULL, resource->generator));
+    }
+
+    furi_hal_bus_enable(FuriHalBusTIM2);
+
+    /* start counter */
+    LL_TIM_SetCounterMode(TIM2, LL_TIM_COUNTERMODE_UP);
+    LL_TIM_SetClockDivision(TIM2, LL_TIM_CLOCKDIVISION_DIV1);
+    LL_TIM_SetPrescaler(TIM2, 0);
+    LL_TIM_SetAutoReload(TIM2, 0xFFFFFFFF);
+    LL_TIM_SetCounter(TIM2, 0);
+    LL_TIM_EnableCounter(TIM2);
+
+    for(size_t i = 0; i < capture->count; i++) {
+        PulseCaptureChannel* channel = &capture->channels[i];
+        const PulseCaptureResource* resource = channel->resource;
+
+        /* generator gets fed by EXTI_LINEn, triggers on rising edge of the interrupt */
+        LL_DMAMUX_SetRequestSignalID(
+            NULL, resource->generator, GET_DMAMUX_EXTI_LINE(channel->gpio->pin));
+        LL_DMAMUX_SetRequestGenPolarity(NULL, resource->generator, LL_DMAMUX_REQ_GEN_POL_RISING);
+        LL_DMAMUX_EnableRequestGen(NULL, resource->generator);
+
+        /* we need the EXTI to be configured as interrupt generating line, but no ISR registered */
+        furi_hal_gpio_init_ex(
+            channel->gpio,
+            GpioModeInterruptRiseFall,
+            capture->pull,
+            GpioSpeedVeryHigh,
+            GpioAltFnUnused);
+
+        channel->pos = 0;
+        channel->read = 0;
+        channel->written = 0;
+        channel->wraps = 0;
+        channel->level = (channel->gpio->port->IDR & channel->gpio->pin) != 0;
+
+        pulse_capture_setup_dma(
+            resource,
+            resource->dma_channel,
+            (uint32_t) & (TIM2->CNT),
+            channel->timer_buffer,
+            capture->size);
+
+        /* count passes over the ring, so the reader can tell when it got lapped */
+        resource->dma->IFCR = PULSE_CAPTURE_DMA_FLAG(resource->dma_channel, DMA_IFCR_CTCIF1);
+        furi_hal_interrupt_set_isr(resource->dma_irq, pulse_capture_dma_isr, channel);
+        LL_DMA_EnableIT_TC(resource->dma, resource->dma_channel);
+
+        pulse_capture_setup_dma(
+            resource,
+            resource->dma_channel + 1,
+            (uint32_t) & (channel->gpio->port->IDR),
+            channel->gpio_buffer,
+            capture->size);
+    }
+}
+
+void pulse_capture_stop(PulseCapture* capture) {
+    furi_assert(capture);
+
+    for(size_t i = 0; i < capture->count; i++) {
+        const PulseCaptureResource* resource = capture->channels[i].resource;
+        LL_DMA_DisableChannel(resource->dma, resource->dma_channel);
+        LL_DMA_DisableChannel(resource->dma, resource->dma_channel + 1);
+        LL_DMA_DisableIT_TC(resource->dma, resource->dma_channel);
+        furi_hal_interrupt_set_isr(resource->dma_irq, NULL, NULL);
+        LL_DMAMUX_DisableRequestGen(NULL, resource->generator);
+    }
+
+    LL_TIM_DisableCounter(TIM2);
+    furi_hal_bus_disable(FuriHalBusTIM2);
+
+    for(size_t i = 0; i < capture->count; i++) {
+        furi_hal_gpio_init_simple(capture->channels[i].gpio, GpioModeAnalog);
+    }
+}
+
+static uint32_t pulse_capture_get_available(PulseCapture* capture, PulseCaptureChannel* channel) {
+    const PulseCaptureResource* resource = channel->resource;
+    uint32_t size = capture->size;
+
+    uint32_t wraps;
+    uint32_t timer_pos;
+    uint32_t gpio_pos;
+    do {
+        wraps = channel->wraps;
+        timer_pos = size - LL_DMA_GetDataLength(resource->dma, resource->dma_channel);
+        gpio_pos = size - LL_DMA_GetDataLength(resource->dma, resource->dma_channel + 1);
+    } while(wraps != channel->wraps);
+
+    uint32_t written = wraps * size + timer_pos;
+    /* position already restarted, but the wrap interrupt is still pending */
+    if((int32_t)(written - channel->written) < 0) {
+        written += size;
+    }
+    channel->written = written;
+
+    /* both channels serve the same request, GPIO samples are at most one behind,
+     * only take complete timer and GPIO pairs */
+    uint32_t pairs = written - timer_pos + gpio_pos;
+    if(gpio_pos > timer_pos) {
+        pairs -= size;
+    }
+
+    return pairs - channel->read;
+}
+
+static void
+    pulse_capture_skip(PulseCapture* capture, PulseCaptureChannel* channel, uint32_t count) {
+    channel->read += count;
+    channel->pos = (channel->pos + count) % capture->size;
+
+    /* last skipped sample is old, but not overwritten yet */
+    uint32_t last = (channel->pos + capture->size - 1) % capture->size;
+    channel->level = (channel->gpio_buffer[last] & channel->gpio->pin) != 0;
+}
+
+size_t pulse_capture_read(
+    PulseCapture* capture,
+    PulseCaptureEdge* edges,
+    size_t edges_max,
+    uint32_t timeout_us) {
+    furi_assert(capture);
+    furi_assert(edges);
+
+    uint32_t available[PULSE_CAPTURE_CHANNELS_MAX];
+    uint32_t start_time = DWT->CYCCNT;
+    uint32_t timeout_ticks = timeout_us * furi_hal_cortex_instructions_per_microsecond();
+
+    do {
+        uint32_t total = 0;
+        for(size_t i = 0; i < capture->count; i++) {
+            available[i] = pulse_capture_get_available(capture, &capture->channels[i]);
+            total += available[i];
+        }
+
+        if(total) break;
+
+        if(DWT->CYCCNT - start_time > timeout_ticks) {
+            return 0;
+        }
+    } while(true);
+
+    /* the ring got lapped and oldest edges were overwritten. Keep half of it, so the DMA
+     * doesn't catch up with the reader again right away */
+    for(size_t i = 0; i < capture->count; i++) {
+        if(available[i] > capture->size) {
+            capture->stats.overruns++;
+            pulse_capture_skip(capture, &capture->channels[i], available[i] - capture->size / 2);
+            available[i] = capture->size / 2;
+        }
+    }
+
+    /* merge channels, oldest edge first */
+    size_t count = 0;
+    while(count < edges_max) {
+        size_t oldest = PULSE_CAPTURE_CHANNELS_MAX;
+        uint32_t oldest_timestamp = 0;
+
+        for(size_t i = 0; i < capture->count; i++) {
+            if(!available[i]) continue;
+
+            PulseCaptureChannel* channel = &capture->channels[i];
+            uint32_t timestamp = channel->timer_buffer[channel->pos];
+            if(oldest == PULSE_CAPTURE_CHANNELS_MAX ||
+               (int32_t)(timestamp - oldest_timestamp) < 0) {
+                oldest = i;
+                oldest_timestamp = timestamp;
+            }
+        }
+
+        if(oldest == PULSE_CAPTURE_CHANNELS_MAX) break;
+
+        PulseCaptureChannel* channel = &capture->channels[oldest];
+        bool level = (channel->gpio_buffer[channel->pos] & channel->gpio->pin) != 0;
+
+        /* the GPIO did not toggle, so we lost an edge in between */
+        if(level == channel->level) {
+            capture->stats.lost_edges++;
+        }
+        channel->level = level;
+
+        edges[count].channel = oldest;
+        edges[count].level = level;
+        edges[count].timestamp = oldest_timestamp;
+        count++;
+
+        channel->pos = (channel->pos + 1) % capture->size;
+        channel->read++;
+        available[oldest]--;
+    }
+
+    capture->stats.edges += count;
+
+    return count;
+}
+
+void pulse_capture_get_stats(PulseCapture* capture, PulseCaptureStats* stats) {
+    furi_assert(capture);
+    furi_assert(stats);
+
+    *stats = capture->stats;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <furi_hal_gpio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** maximum number of captured GPIOs, limited by DMA channel pairs no other driver uses */
+#define PULSE_CAPTURE_CHANNELS_MAX (2)
+
+/**
+ * single captured edge
+ */
+typedef struct {
+    uint8_t channel; /**< index of the GPIO passed to pulse_capture_alloc */
+    bool level; /**< level after the edge */
+    uint32_t timestamp; /**< TIM2 counter, 64MHz, common for all channels */
+} PulseCaptureEdge;
+
+typedef struct {
+    uint32_t edges; /**< edges returned so far */
+    uint32_t lost_edges; /**< edges missing between two samples of the same level */
+    uint32_t overruns; /**< times a ring was overwritten before read, older edges were lost */
+} PulseCaptureStats;
+
+/* using an anonymous type */
+typedef struct PulseCapture PulseCapture;
+
+/** Allocate a PulseCapture object
+ *
+ * Every GPIO gets its own DMAMUX request generator and pair of DMA channels,
+ * all rings share one allocation. GPIOs must have different pin numbers,
+ * as each one needs its own EXTI line.
+ *
+ * @param[in]  gpios       GPIOs to capture, will get configured as inputs.
+ * @param[in]  count       number of GPIOs, up to PULSE_CAPTURE_CHANNELS_MAX
+ * @param[in]  size        number of edges to buffer per GPIO
+ */
+PulseCapture* pulse_capture_alloc(const GpioPin* const* gpios, size_t count, uint32_t size);
+
+/** Free a PulseCapture object
+ *
+ * @param[in]  capture     previously allocated PulseCapture object.
+ */
+void pulse_capture_free(PulseCapture* capture);
+
+/** Set GPIO pull direction for all GPIOs
+ *
+ * By default the pull direction is GpioPullNo.
+ *
+ * @param[in]  capture     previously allocated PulseCapture object.
+ * @param[in]  pull        GPIO pull direction
+ */
+void pulse_capture_set_pull(PulseCapture* capture, GpioPull pull);
+
+/** Start capturing
+ *
+ * Uses TIM2, DMA1 channels 4 to 7 and DMAMUX request generators like
+ * pulse_reader_start, so the two can't run at the same time. Crashes if these
+ * DMA channels are already running.
+ * Ensure that interrupts are always enabled, as the used EXTI lines are handled as ones.
+ *
+ * @param[in]  capture     previously allocated PulseCapture object.
+ */
+void pulse_capture_start(PulseCapture* capture);
+
+/** Stop capturing
+ *
+ * @param[in]  capture     previously allocated PulseCapture object.
+ */
+void pulse_capture_stop(PulseCapture* capture);
+
+/** Read a batch of edges
+ *
+ * Waits for the specified time until at least one edge gets captured, then
+ * returns everything buffered, up to edges_max, ordered by timestamp across
+ * all channels.
+ *
+ * @param[in]  capture     previously allocated PulseCapture object.
+ * @param[out] edges       array to fill
+ * @param[in]  edges_max   edges array size
+ * @param[in]  timeout_us  time to wait for the first edge [µs]
+ *
+ * @returns the number of edges read, 0 on timeout
+ */
+size_t pulse_capture_read(
+    PulseCapture* capture,
+    PulseCaptureEdge* edges,
+    size_t edges_max,
+    uint32_t timeout_us);
+
+/** Get capture statistics
+ *
+ * @param[in]  capture     previously allocated PulseCapture object.
+ * @param[out] stats       PulseCaptureStats to fill
+ */
+void pulse_capture_get_stats(PulseCapture* capture, PulseCaptureStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
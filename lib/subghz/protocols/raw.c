@@ -13,6 +13,8 @@
 
 #define TAG "SubGhzProtocolRaw"
 #define SUBGHZ_DOWNLOAD_MAX_SIZE 512
+#define SUBGHZ_RAW_BUFFER_COUNT 4
+#define SUBGHZ_RAW_WRITER_STACK_SIZE 2048
 
 static const SubGhzBlockConst subghz_protocol_raw_const = {
     .te_short = 50,
@@ -21,6 +23,12 @@ static const SubGhzBlockConst subghz_protocol_raw_const = {
     .min_count_bit_for_found = 0,
 };
 
+/* Filled buffer handed to the writer thread, NULL data stops the thread */
+typedef struct {
+    int32_t* data;
+    size_t count;
+} SubGhzProtocolRawBuffer;
+
 struct SubGhzProtocolDecoderRAW {
     SubGhzProtocolDecoderBase base;
 
@@ -33,6 +41,16 @@ struct SubGhzProtocolDecoderRAW {
     size_t sample_write;
     bool last_level;
     bool pause;
+
+    int32_t* buffers;
+    FuriMessageQueue* free_queue;
+    FuriMessageQueue* full_queue;
+    FuriThread* writer;
+
+    size_t dropped_samples;
+    uint32_t write_count;
+    uint32_t write_time_total;
+    uint32_t write_time_max;
 };
 
 struct SubGhzProtocolEncoderRAW {
@@ -83,6 +101,80 @@ const SubGhzProtocol subghz_protocol_raw = {
     .encoder = &subghz_protocol_raw_encoder,
 };
 
+static int32_t subghz_protocol_raw_writer_thread(void* context) {
+    SubGhzProtocolDecoderRAW* instance = context;
+    SubGhzProtocolRawBuffer buffer;
+    bool is_write_error = false;
+
+    while(furi_message_queue_get(instance->full_queue, &buffer, FuriWaitForever) ==
+          FuriStatusOk) {
+        if(!buffer.data) break;
+
+        uint32_t start = furi_get_tick();
+        if(!is_write_error &&
+           !flipper_format_write_int32(
+               instance->flipper_file, "RAW_Data", buffer.data, buffer.count)) {
+            FURI_LOG_E(TAG, "Unable to add RAW_Data");
+            is_write_error = true;
+        }
+        uint32_t write_time = furi_get_tick() - start;
+
+        instance->write_count++;
+        instance->write_time_total += write_time;
+        if(write_time > instance->write_time_max) instance->write_time_max = write_time;
+
+        furi_check(
+            furi_message_queue_put(instance->free_queue, &buffer.data, 0) == FuriStatusOk);
+    }
+
+    return 0;
+}
+
+static void subghz_protocol_raw_writer_start(SubGhzProtocolDecoderRAW* instance) {
+    instance->buffers =
+        malloc(SUBGHZ_RAW_BUFFER_COUNT * SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
+    instance->free_queue = furi_message_queue_alloc(SUBGHZ_RAW_BUFFER_COUNT, sizeof(int32_t*));
+    // One extra slot for the stop request
+    instance->full_queue =
+        furi_message_queue_alloc(SUBGHZ_RAW_BUFFER_COUNT + 1, sizeof(SubGhzProtocolRawBuffer));
+
+    instance->upload_raw = instance->buffers;
+    for(size_t i = 1; i < SUBGHZ_RAW_BUFFER_COUNT; i++) {
+        int32_t* data = &instance->buffers[i * SUBGHZ_DOWNLOAD_MAX_SIZE];
+        furi_message_queue_put(instance->free_queue, &data, 0);
+    }
+
+    instance->writer = furi_thread_alloc_ex(
+        "SubGhzRawWriter",
+        SUBGHZ_RAW_WRITER_STACK_SIZE,
+        subghz_protocol_raw_writer_thread,
+        instance);
+    furi_thread_start(instance->writer);
+}
+
+static void subghz_protocol_raw_writer_stop(SubGhzProtocolDecoderRAW* instance) {
+    SubGhzProtocolRawBuffer buffer = {.data = NULL, .count = 0};
+    furi_message_queue_put(instance->full_queue, &buffer, FuriWaitForever);
+    furi_thread_join(instance->writer);
+    furi_thread_free(instance->writer);
+    instance->writer = NULL;
+
+    furi_message_queue_free(instance->full_queue);
+    furi_message_queue_free(instance->free_queue);
+    free(instance->buffers);
+    instance->buffers = NULL;
+    instance->upload_raw = NULL;
+
+    FURI_LOG_I(
+        TAG,
+        "Written %zu samples in %lu blocks, dropped %zu, write max %lums, avg %lums",
+        instance->sample_write,
+        instance->write_count,
+        instance->dropped_samples,
+        instance->write_time_max,
+        instance->write_count ? instance->write_time_total / instance->write_count : 0);
+}
+
 bool subghz_protocol_raw_save_to_file_init(
     SubGhzProtocolDecoderRAW* instance,
     const char* dev_name,
@@ -158,11 +250,16 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
-        instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
-        instance->file_is_open = RAWFileIsOpenWrite;
+        instance->ind_write = 0;
         instance->sample_write = 0;
         instance->last_level = false;
         instance->pause = false;
+        instance->dropped_samples = 0;
+        instance->write_count = 0;
+        instance->write_time_total = 0;
+        instance->write_time_max = 0;
+        subghz_protocol_raw_writer_start(instance);
+        instance->file_is_open = RAWFileIsOpenWrite;
         init = true;
     } while(0);
 
@@ -171,31 +268,27 @@ bool subghz_protocol_raw_save_to_file_init(
     return init;
 }
 
-static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* instance) {
+/* Hand filled buffer to the writer thread and take a free one, never blocks */
+static void subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* instance) {
     furi_assert(instance);
 
-    bool is_write = false;
-    if(instance->file_is_open == RAWFileIsOpenWrite) {
-        if(!flipper_format_write_int32(
-               instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
-            FURI_LOG_E(TAG, "Unable to add RAW_Data");
-        } else {
-            instance->sample_write += instance->ind_write;
-            instance->ind_write = 0;
-            is_write = true;
-        }
+    SubGhzProtocolRawBuffer buffer = {.data = instance->upload_raw, .count = instance->ind_write};
+    furi_check(furi_message_queue_put(instance->full_queue, &buffer, 0) == FuriStatusOk);
+    instance->sample_write += instance->ind_write;
+    instance->ind_write = 0;
+
+    if(furi_message_queue_get(instance->free_queue, &instance->upload_raw, 0) != FuriStatusOk) {
+        instance->upload_raw = NULL;
     }
-    return is_write;
 }
 
 void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
     furi_assert(instance);
 
-    if(instance->file_is_open == RAWFileIsOpenWrite && instance->ind_write)
-        subghz_protocol_raw_save_to_file_write(instance);
-    if(instance->file_is_open != RAWFileIsOpenClose) {
-        free(instance->upload_raw);
-        instance->upload_raw = NULL;
+    if(instance->file_is_open == RAWFileIsOpenWrite) {
+        instance->file_is_open = RAWFileIsOpenClose;
+        if(instance->ind_write) subghz_protocol_raw_save_to_file_write(instance);
+        subghz_protocol_raw_writer_stop(instance);
         flipper_format_file_close(instance->flipper_file);
         flipper_format_free(instance->flipper_file);
         furi_record_close(RECORD_STORAGE);
@@ -216,6 +309,19 @@ size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance)
     return instance->sample_write + instance->ind_write;
 }
 
+void subghz_protocol_raw_get_record_stats(
+    SubGhzProtocolDecoderRAW* instance,
+    SubGhzProtocolRawRecordStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+
+    stats->dropped_samples = instance->dropped_samples;
+    stats->write_count = instance->write_count;
+    stats->write_time_max = instance->write_time_max;
+    stats->write_time_avg =
+        instance->write_count ? instance->write_time_total / instance->write_count : 0;
+}
+
 void* subghz_protocol_decoder_raw_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolDecoderRAW* instance = malloc(sizeof(SubGhzProtocolDecoderRAW));
@@ -247,7 +353,16 @@ void subghz_protocol_decoder_raw_feed(void* context, bool level, uint32_t durati
     furi_assert(context);
     SubGhzProtocolDecoderRAW* instance = context;
     // Add check if we got duration higher than 1 second, we skipping it, temp fix
-    if((!instance->pause && (instance->upload_raw != NULL)) && (duration < ((uint32_t)1000000))) {
+    if((!instance->pause && (instance->file_is_open == RAWFileIsOpenWrite)) &&
+       (duration < ((uint32_t)1000000))) {
+        if(!instance->upload_raw &&
+           furi_message_queue_get(instance->free_queue, &instance->upload_raw, 0) !=
+               FuriStatusOk) {
+            // Writer is behind, last_level is kept so levels still alternate after the gap
+            if(duration > subghz_protocol_raw_const.te_short) instance->dropped_samples++;
+            return;
+        }
+
         if(duration > subghz_protocol_raw_const.te_short) {
             if(instance->last_level != level) {
                 instance->last_level = (level ? true : false);
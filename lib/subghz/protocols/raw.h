@@ -13,6 +13,13 @@ typedef void (*SubGhzProtocolEncoderRAWCallbackEnd)(void* context);
 typedef struct SubGhzProtocolDecoderRAW SubGhzProtocolDecoderRAW;
 typedef struct SubGhzProtocolEncoderRAW SubGhzProtocolEncoderRAW;
 
+typedef struct {
+    size_t dropped_samples; /**< samples lost while all buffers were waiting for storage */
+    uint32_t write_count; /**< buffers written to file */
+    uint32_t write_time_max; /**< longest buffer write, ms */
+    uint32_t write_time_avg; /**< average buffer write, ms */
+} SubGhzProtocolRawRecordStats;
+
 extern const SubGhzProtocolDecoder subghz_protocol_raw_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_raw_encoder;
 extern const SubGhzProtocol subghz_protocol_raw;
@@ -42,6 +49,17 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance);
  */
 size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance);
 
+/**
+ * Get recording statistics of SubGhzProtocolDecoderRAW.
+ * Samples are written to file by a separate thread, so the decoder
+ * drops them only if all buffers are still waiting for storage.
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param stats Pointer to a SubGhzProtocolRawRecordStats to fill
+ */
+void subghz_protocol_raw_get_record_stats(
+    SubGhzProtocolDecoderRAW* instance,
+    SubGhzProtocolRawRecordStats* stats);
+
 /**
  * Allocate SubGhzProtocolDecoderRAW.
  * @param environment Pointer to a SubGhzEnvironment instance
@@ -4,6 +4,9 @@
 #include "protocols/protocol_items.h"
 
 #include <m-array.h>
+#include <toolbox/profiler_probe.h>
+
+PROFILER_PROBE_DEFINE(subghz_receiver_decode);
 
 typedef struct {
     SubGhzProtocolEncoderBase* base;
@@ -61,6 +64,7 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration) {
     furi_assert(instance);
     furi_assert(instance->slots);
+    PROFILER_PROBE_SCOPE(subghz_receiver_decode);
 
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
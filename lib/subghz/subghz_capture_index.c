@@ -0,0 +1,538 @@
+#include "subghz_capture_index.h"
+#include "types.h"
+#include "protocols/raw.h"
+
+#include <furi.h>
+#include <toolbox/dir_walk.h>
+#include <toolbox/path.h>
+#include <toolbox/crc32_calc.h>
+
+#define TAG "SubGhzCaptureIndex"
+
+#define SUBGHZ_CAPTURE_INDEX_MAGIC (0x58494753UL) /* "SGIX" */
+#define SUBGHZ_CAPTURE_INDEX_VERSION (2)
+#define SUBGHZ_CAPTURE_INDEX_TEMP_SUFFIX ".tmp"
+/* Captures are checked for changes by size and CRC of the beginning, which holds the header */
+#define SUBGHZ_CAPTURE_INDEX_CRC_SIZE (512)
+
+/* RAW sampling: first values of each line, up to a total */
+#define SUBGHZ_CAPTURE_INDEX_RAW_LINE_SAMPLES (64)
+#define SUBGHZ_CAPTURE_INDEX_RAW_SAMPLES (2048)
+/* Histogram bin N holds pulses of 2^(N+6)..2^(N+7)-1 us, edge bins are open */
+#define SUBGHZ_CAPTURE_INDEX_HISTOGRAM_SHIFT (7)
+#define SUBGHZ_CAPTURE_INDEX_HISTOGRAM_SCALE (255)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint32_t record_count;
+} __attribute__((packed)) SubGhzCaptureIndexHeader;
+
+/* On-disk record, followed by path_length bytes of relative path */
+typedef struct {
+    SubGhzCaptureFingerprint fingerprint;
+    uint32_t size;
+    uint32_t crc;
+    uint8_t path_length;
+} __attribute__((packed)) SubGhzCaptureIndexRecord;
+
+/* Previous index entry, fingerprint is read back from file by offset */
+typedef struct {
+    uint32_t path_hash;
+    uint32_t size;
+    uint32_t crc;
+    uint32_t offset;
+} SubGhzCaptureIndexEntry;
+
+typedef struct {
+    File* file;
+    SubGhzCaptureIndexEntry* entries;
+    size_t entry_count;
+} SubGhzCaptureIndexPrevious;
+
+static uint32_t subghz_capture_index_hash(const char* data, uint32_t hash) {
+    while(*data) {
+        hash = (hash ^ (uint8_t)*data++) * 16777619UL;
+    }
+    return hash;
+}
+
+static uint32_t subghz_capture_index_hash_str(const char* data) {
+    return subghz_capture_index_hash(data, 2166136261UL);
+}
+
+static void subghz_capture_fingerprint_add_histogram(
+    uint32_t* histogram,
+    const int32_t* samples,
+    size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        if(!samples[i]) continue;
+        uint32_t duration = (samples[i] > 0) ? samples[i] : -samples[i];
+        int32_t bin = (32 - __builtin_clz(duration)) - SUBGHZ_CAPTURE_INDEX_HISTOGRAM_SHIFT;
+        bin = CLAMP(bin, SUBGHZ_CAPTURE_INDEX_HISTOGRAM_BINS - 1, 0);
+        if(samples[i] < 0) bin += SUBGHZ_CAPTURE_INDEX_HISTOGRAM_BINS;
+        histogram[bin]++;
+    }
+}
+
+static void subghz_capture_fingerprint_normalize_histogram(
+    SubGhzCaptureFingerprint* fingerprint,
+    const uint32_t* histogram) {
+    for(size_t level = 0; level < 2; level++) {
+        const uint32_t* bins = &histogram[level * SUBGHZ_CAPTURE_INDEX_HISTOGRAM_BINS];
+        uint32_t total = 0;
+        for(size_t i = 0; i < SUBGHZ_CAPTURE_INDEX_HISTOGRAM_BINS; i++) {
+            total += bins[i];
+        }
+        if(!total) continue;
+        for(size_t i = 0; i < SUBGHZ_CAPTURE_INDEX_HISTOGRAM_BINS; i++) {
+            fingerprint->histogram[level * SUBGHZ_CAPTURE_INDEX_HISTOGRAM_BINS + i] =
+                bins[i] * SUBGHZ_CAPTURE_INDEX_HISTOGRAM_SCALE / total;
+        }
+    }
+}
+
+static bool subghz_capture_fingerprint_load_raw(
+    FlipperFormat* flipper_format,
+    SubGhzCaptureFingerprint* fingerprint) {
+    int32_t* samples = malloc(SUBGHZ_CAPTURE_INDEX_RAW_LINE_SAMPLES * sizeof(int32_t));
+    uint32_t histogram[SUBGHZ_CAPTURE_INDEX_HISTOGRAM_BINS * 2] = {0};
+    size_t total = 0;
+    uint32_t count = 0;
+
+    while(total < SUBGHZ_CAPTURE_INDEX_RAW_SAMPLES &&
+          flipper_format_get_value_count(flipper_format, "RAW_Data", &count) && count) {
+        count = MIN(count, (uint32_t)SUBGHZ_CAPTURE_INDEX_RAW_LINE_SAMPLES);
+        if(!flipper_format_read_int32(flipper_format, "RAW_Data", samples, count)) break;
+        subghz_capture_fingerprint_add_histogram(histogram, samples, count);
+        total += count;
+    }
+
+    free(samples);
+    subghz_capture_fingerprint_normalize_histogram(fingerprint, histogram);
+
+    return total > 0;
+}
+
+bool subghz_capture_fingerprint_load(
+    FlipperFormat* flipper_format,
+    SubGhzCaptureFingerprint* fingerprint) {
+    furi_assert(flipper_format);
+    furi_assert(fingerprint);
+
+    memset(fingerprint, 0, sizeof(SubGhzCaptureFingerprint));
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t temp_data32;
+    bool result = false;
+
+    do {
+        if(!flipper_format_rewind(flipper_format)) break;
+        if(!flipper_format_read_header(flipper_format, temp_str, &temp_data32)) break;
+        if(furi_string_cmp_str(temp_str, SUBGHZ_KEY_FILE_TYPE) &&
+           furi_string_cmp_str(temp_str, SUBGHZ_RAW_FILE_TYPE)) {
+            break;
+        }
+
+        if(!flipper_format_read_uint32(flipper_format, "Frequency", &fingerprint->frequency, 1))
+            break;
+
+        if(!flipper_format_read_string(flipper_format, "Preset", temp_str)) break;
+        fingerprint->preset_hash = subghz_capture_index_hash_str(furi_string_get_cstr(temp_str));
+        if(!furi_string_cmp_str(temp_str, "FuriHalSubGhzPresetCustom")) {
+            // Custom presets are told apart by their registers
+            if(!flipper_format_read_string(flipper_format, "Custom_preset_data", temp_str)) break;
+            fingerprint->preset_hash = subghz_capture_index_hash(
+                furi_string_get_cstr(temp_str), fingerprint->preset_hash);
+        }
+
+        if(!flipper_format_read_string(flipper_format, "Protocol", temp_str)) break;
+        fingerprint->protocol_hash =
+            subghz_capture_index_hash_str(furi_string_get_cstr(temp_str));
+
+        if(!furi_string_cmp_str(temp_str, SUBGHZ_PROTOCOL_RAW_NAME)) {
+            result = subghz_capture_fingerprint_load_raw(flipper_format, fingerprint);
+            break;
+        }
+
+        // Bit and Key are optional, some protocols store their data differently
+        if(flipper_format_read_uint32(flipper_format, "Bit", &temp_data32, 1)) {
+            fingerprint->bit = temp_data32;
+        }
+        if(flipper_format_read_string(flipper_format, "Key", temp_str)) {
+            fingerprint->key_hash = subghz_capture_index_hash_str(furi_string_get_cstr(temp_str));
+        }
+        result = true;
+    } while(false);
+
+    furi_string_free(temp_str);
+    return result;
+}
+
+uint8_t subghz_capture_fingerprint_compare(
+    const SubGhzCaptureFingerprint* fingerprint,
+    const SubGhzCaptureFingerprint* other) {
+    furi_assert(fingerprint);
+    furi_assert(other);
+
+    if(fingerprint->protocol_hash != other->protocol_hash) return 0;
+
+    bool is_same_frequency = (fingerprint->frequency == other->frequency);
+    bool is_same_preset = (fingerprint->preset_hash == other->preset_hash);
+    uint8_t score = 0;
+
+    if(fingerprint->protocol_hash != subghz_capture_index_hash_str(SUBGHZ_PROTOCOL_RAW_NAME)) {
+        score = 40;
+        if(fingerprint->bit == other->bit) score += 10;
+        if(fingerprint->key_hash == other->key_hash) score += 30;
+        if(is_same_frequency) score += 10;
+        if(is_same_preset) score += 10;
+    } else if(is_same_preset) {
+        uint32_t distance = 0;
+        for(size_t i = 0; i < COUNT_OF(fingerprint->histogram); i++) {
+            distance += (fingerprint->histogram[i] > other->histogram[i]) ?
+                            (fingerprint->histogram[i] - other->histogram[i]) :
+                            (other->histogram[i] - fingerprint->histogram[i]);
+        }
+        // Two levels, each normalized to SCALE, so distance is at most 4 * SCALE
+        const uint32_t distance_max = 4 * SUBGHZ_CAPTURE_INDEX_HISTOGRAM_SCALE;
+        score = 20 + 60 * (distance_max - MIN(distance, distance_max)) / distance_max;
+        if(is_same_frequency) score += 20;
+    }
+
+    return score;
+}
+
+static int subghz_capture_index_entry_cmp(const void* a, const void* b) {
+    const SubGhzCaptureIndexEntry* entry_a = a;
+    const SubGhzCaptureIndexEntry* entry_b = b;
+    if(entry_a->path_hash == entry_b->path_hash) return 0;
+    return (entry_a->path_hash < entry_b->path_hash) ? -1 : 1;
+}
+
+static bool subghz_capture_index_read_header(File* file, uint32_t* record_count) {
+    SubGhzCaptureIndexHeader header;
+    if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) return false;
+    if(header.magic != SUBGHZ_CAPTURE_INDEX_MAGIC ||
+       header.version != SUBGHZ_CAPTURE_INDEX_VERSION) {
+        return false;
+    }
+    *record_count = header.record_count;
+    return true;
+}
+
+static void subghz_capture_index_previous_load(
+    SubGhzCaptureIndexPrevious* previous,
+    Storage* storage,
+    const char* index_path) {
+    previous->file = storage_file_alloc(storage);
+    previous->entries = NULL;
+    previous->entry_count = 0;
+
+    uint32_t record_count = 0;
+    if(!storage_file_open(previous->file, index_path, FSAM_READ, FSOM_OPEN_EXISTING)) return;
+    if(!subghz_capture_index_read_header(previous->file, &record_count)) return;
+
+    // Don't trust a damaged header with the allocation size
+    uint64_t size_left = storage_file_size(previous->file) - sizeof(SubGhzCaptureIndexHeader);
+    record_count = MIN(record_count, size_left / sizeof(SubGhzCaptureIndexRecord));
+
+    char path[SUBGHZ_CAPTURE_INDEX_PATH_MAX];
+    previous->entries = malloc(record_count * sizeof(SubGhzCaptureIndexEntry));
+    for(size_t i = 0; i < record_count; i++) {
+        SubGhzCaptureIndexEntry* entry = &previous->entries[previous->entry_count];
+        SubGhzCaptureIndexRecord record;
+
+        entry->offset = storage_file_tell(previous->file);
+        if(storage_file_read(previous->file, &record, sizeof(record)) != sizeof(record)) break;
+        if(storage_file_read(previous->file, path, record.path_length) != record.path_length)
+            break;
+        path[record.path_length] = '\0';
+
+        entry->path_hash = subghz_capture_index_hash_str(path);
+        entry->size = record.size;
+        entry->crc = record.crc;
+        previous->entry_count++;
+    }
+
+    qsort(
+        previous->entries,
+        previous->entry_count,
+        sizeof(SubGhzCaptureIndexEntry),
+        subghz_capture_index_entry_cmp);
+}
+
+static void subghz_capture_index_previous_free(SubGhzCaptureIndexPrevious* previous) {
+    free(previous->entries);
+    storage_file_close(previous->file);
+    storage_file_free(previous->file);
+}
+
+static bool subghz_capture_index_previous_find(
+    SubGhzCaptureIndexPrevious* previous,
+    const char* path,
+    uint32_t size,
+    uint32_t crc,
+    SubGhzCaptureFingerprint* fingerprint) {
+    if(!previous->entry_count) return false;
+
+    SubGhzCaptureIndexEntry key = {.path_hash = subghz_capture_index_hash_str(path)};
+    SubGhzCaptureIndexEntry* entry = bsearch(
+        &key,
+        previous->entries,
+        previous->entry_count,
+        sizeof(SubGhzCaptureIndexEntry),
+        subghz_capture_index_entry_cmp);
+    if(!entry) return false;
+
+    // bsearch may land anywhere in a run of equal hashes
+    while(entry > previous->entries && (entry - 1)->path_hash == key.path_hash) {
+        entry--;
+    }
+
+    char stored_path[SUBGHZ_CAPTURE_INDEX_PATH_MAX];
+    const SubGhzCaptureIndexEntry* end = previous->entries + previous->entry_count;
+    for(; entry < end && entry->path_hash == key.path_hash; entry++) {
+        if(entry->size != size || entry->crc != crc) continue;
+
+        SubGhzCaptureIndexRecord record;
+        if(!storage_file_seek(previous->file, entry->offset, true)) continue;
+        if(storage_file_read(previous->file, &record, sizeof(record)) != sizeof(record))
+            continue;
+        if(storage_file_read(previous->file, stored_path, record.path_length) !=
+           record.path_length)
+            continue;
+        stored_path[record.path_length] = '\0';
+
+        if(!strcmp(stored_path, path)) {
+            *fingerprint = record.fingerprint;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool subghz_capture_index_get_crc(
+    File* file,
+    const char* path,
+    uint8_t* buffer,
+    uint32_t* crc) {
+    bool result = false;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        size_t read = storage_file_read(file, buffer, SUBGHZ_CAPTURE_INDEX_CRC_SIZE);
+        if(storage_file_get_error(file) == FSE_OK) {
+            *crc = crc32_calc_buffer(0, buffer, read);
+            result = true;
+        }
+    }
+
+    storage_file_close(file);
+    return result;
+}
+
+static bool subghz_capture_index_filter(const char* name, FileInfo* fileinfo, void* context) {
+    UNUSED(context);
+    if(file_info_is_dir(fileinfo)) return false;
+
+    size_t name_length = strlen(name);
+    size_t extension_length = strlen(SUBGHZ_APP_FILENAME_EXTENSION);
+    return name_length > extension_length &&
+           !strcmp(name + name_length - extension_length, SUBGHZ_APP_FILENAME_EXTENSION);
+}
+
+bool subghz_capture_index_build(
+    Storage* storage,
+    const char* dir_path,
+    SubGhzCaptureIndexBuildStats* stats) {
+    furi_assert(storage);
+    furi_assert(dir_path);
+
+    uint32_t start = furi_get_tick();
+    SubGhzCaptureIndexBuildStats build_stats = {0};
+    bool result = false;
+
+    FuriString* index_path = furi_string_alloc();
+    FuriString* temp_path = furi_string_alloc();
+    FuriString* file_path = furi_string_alloc();
+    path_concat(dir_path, SUBGHZ_CAPTURE_INDEX_FILE_NAME, index_path);
+    furi_string_printf(
+        temp_path, "%s" SUBGHZ_CAPTURE_INDEX_TEMP_SUFFIX, furi_string_get_cstr(index_path));
+
+    SubGhzCaptureIndexPrevious previous;
+    subghz_capture_index_previous_load(&previous, storage, furi_string_get_cstr(index_path));
+
+    File* file = storage_file_alloc(storage);
+    File* capture_file = storage_file_alloc(storage);
+    uint8_t* crc_buffer = malloc(SUBGHZ_CAPTURE_INDEX_CRC_SIZE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    dir_walk_set_filter_cb(dir_walk, subghz_capture_index_filter, NULL);
+
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(temp_path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Unable to create %s", furi_string_get_cstr(temp_path));
+            break;
+        }
+
+        // Record count is filled in when the walk is done
+        SubGhzCaptureIndexHeader header = {
+            .magic = SUBGHZ_CAPTURE_INDEX_MAGIC,
+            .version = SUBGHZ_CAPTURE_INDEX_VERSION,
+            .record_count = 0,
+        };
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(!dir_walk_open(dir_walk, dir_path)) break;
+
+        bool is_write_error = false;
+        FileInfo fileinfo;
+        size_t dir_path_length = strlen(dir_path);
+        while(dir_walk_read(dir_walk, file_path, &fileinfo) == DirWalkOK) {
+            const char* relative_path = furi_string_get_cstr(file_path) + dir_path_length + 1;
+            size_t path_length = strlen(relative_path);
+            if(path_length >= SUBGHZ_CAPTURE_INDEX_PATH_MAX) continue;
+
+            SubGhzCaptureIndexRecord record = {
+                .size = fileinfo.size,
+                .path_length = path_length,
+            };
+            if(!subghz_capture_index_get_crc(
+                   capture_file, furi_string_get_cstr(file_path), crc_buffer, &record.crc)) {
+                build_stats.failed++;
+                continue;
+            }
+
+            if(!subghz_capture_index_previous_find(
+                   &previous, relative_path, record.size, record.crc, &record.fingerprint)) {
+                build_stats.parsed++;
+                bool is_parsed =
+                    flipper_format_file_open_existing(
+                        flipper_format, furi_string_get_cstr(file_path)) &&
+                    subghz_capture_fingerprint_load(flipper_format, &record.fingerprint);
+                flipper_format_file_close(flipper_format);
+                if(!is_parsed) {
+                    build_stats.failed++;
+                    continue;
+                }
+            }
+
+            if(storage_file_write(file, &record, sizeof(record)) != sizeof(record) ||
+               storage_file_write(file, relative_path, path_length) != path_length) {
+                is_write_error = true;
+                break;
+            }
+            build_stats.files++;
+        }
+        if(is_write_error) break;
+
+        header.record_count = build_stats.files;
+        if(!storage_file_seek(file, 0, true)) break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        result = true;
+    } while(false);
+
+    dir_walk_close(dir_walk);
+    dir_walk_free(dir_walk);
+    flipper_format_free(flipper_format);
+    free(crc_buffer);
+    storage_file_free(capture_file);
+    storage_file_close(file);
+    storage_file_free(file);
+    subghz_capture_index_previous_free(&previous);
+
+    if(result) {
+        storage_common_remove(storage, furi_string_get_cstr(index_path));
+        result = storage_common_rename(
+                     storage,
+                     furi_string_get_cstr(temp_path),
+                     furi_string_get_cstr(index_path)) == FSE_OK;
+    } else {
+        storage_common_remove(storage, furi_string_get_cstr(temp_path));
+    }
+
+    build_stats.time = furi_get_tick() - start;
+    FURI_LOG_I(
+        TAG,
+        "Indexed %zu captures, parsed %zu, failed %zu in %lums",
+        build_stats.files,
+        build_stats.parsed,
+        build_stats.failed,
+        build_stats.time);
+    if(stats) *stats = build_stats;
+
+    furi_string_free(file_path);
+    furi_string_free(temp_path);
+    furi_string_free(index_path);
+
+    return result;
+}
+
+size_t subghz_capture_index_query(
+    Storage* storage,
+    const char* dir_path,
+    const SubGhzCaptureFingerprint* fingerprint,
+    uint8_t min_score,
+    SubGhzCaptureIndexMatch* matches,
+    size_t matches_max) {
+    furi_assert(storage);
+    furi_assert(dir_path);
+    furi_assert(fingerprint);
+    furi_assert(matches);
+
+    size_t match_count = 0;
+    FuriString* index_path = furi_string_alloc();
+    path_concat(dir_path, SUBGHZ_CAPTURE_INDEX_FILE_NAME, index_path);
+    File* file = storage_file_alloc(storage);
+
+    do {
+        uint32_t record_count = 0;
+        if(!storage_file_open(
+               file, furi_string_get_cstr(index_path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(!subghz_capture_index_read_header(file, &record_count)) {
+            FURI_LOG_W(TAG, "Unsupported index in %s", dir_path);
+            break;
+        }
+
+        SubGhzCaptureIndexRecord record;
+        char path[SUBGHZ_CAPTURE_INDEX_PATH_MAX];
+        for(uint32_t i = 0; i < record_count; i++) {
+            if(storage_file_read(file, &record, sizeof(record)) != sizeof(record)) break;
+
+            uint8_t score = subghz_capture_fingerprint_compare(fingerprint, &record.fingerprint);
+            // Keep matches sorted by score, find where this one goes
+            size_t position = match_count;
+            while(position > 0 && matches[position - 1].score < score) {
+                position--;
+            }
+
+            if(score < min_score || !score || position >= matches_max) {
+                if(!storage_file_seek(file, storage_file_tell(file) + record.path_length, true))
+                    break;
+                continue;
+            }
+
+            // Read path before shifting matches, so a failed read leaves them intact
+            if(storage_file_read(file, path, record.path_length) != record.path_length) break;
+            path[record.path_length] = '\0';
+
+            if(match_count < matches_max) match_count++;
+            memmove(
+                &matches[position + 1],
+                &matches[position],
+                (match_count - position - 1) * sizeof(SubGhzCaptureIndexMatch));
+
+            SubGhzCaptureIndexMatch* match = &matches[position];
+            match->score = score;
+            memcpy(match->path, path, record.path_length + 1);
+        }
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_string_free(index_path);
+
+    return match_count;
+}
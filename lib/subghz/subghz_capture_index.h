@@ -0,0 +1,110 @@
+/**
+ * @file subghz_capture_index.h
+ * SubGhz: saved capture fingerprint index
+ *
+ * Every .sub file under a directory is reduced to a small fingerprint:
+ * protocol, preset, frequency, bit count and key hash, or a pulse length
+ * histogram for RAW captures. Fingerprints are kept in a single index file
+ * in that directory, so looking for captures similar to a new one only
+ * reads the index instead of parsing every file.
+ */
+#pragma once
+
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUBGHZ_CAPTURE_INDEX_FILE_NAME ".subghz_index"
+
+/** Pulse length bins per level, see subghz_capture_fingerprint_load */
+#define SUBGHZ_CAPTURE_INDEX_HISTOGRAM_BINS (8)
+
+/** Longest indexed path relative to the index directory, including terminator */
+#define SUBGHZ_CAPTURE_INDEX_PATH_MAX (UINT8_MAX + 1)
+
+typedef struct {
+    uint32_t protocol_hash;
+    uint32_t preset_hash;
+    uint32_t frequency;
+    uint32_t key_hash; /**< 0 for RAW */
+    uint16_t bit; /**< 0 for RAW */
+    uint8_t histogram[SUBGHZ_CAPTURE_INDEX_HISTOGRAM_BINS * 2]; /**< marks, then spaces */
+} __attribute__((packed)) SubGhzCaptureFingerprint;
+
+typedef struct {
+    uint8_t score; /**< 1..100 */
+    char path[SUBGHZ_CAPTURE_INDEX_PATH_MAX]; /**< relative to the index directory */
+} SubGhzCaptureIndexMatch;
+
+typedef struct {
+    size_t files; /**< captures in the index */
+    size_t parsed; /**< new or changed captures */
+    size_t failed; /**< captures that could not be parsed */
+    uint32_t time; /**< ms */
+} SubGhzCaptureIndexBuildStats;
+
+/** Extract fingerprint from a key or RAW capture
+ *
+ * RAW captures are sampled: only part of each RAW_Data line and a limited
+ * number of lines contribute to the histogram.
+ *
+ * @param flipper_format FlipperFormat with the capture, rewound before reading
+ * @param fingerprint SubGhzCaptureFingerprint to fill
+ * @return true on success
+ */
+bool subghz_capture_fingerprint_load(
+    FlipperFormat* flipper_format,
+    SubGhzCaptureFingerprint* fingerprint);
+
+/** Compare two fingerprints
+ *
+ * Different protocols never match. RAW captures also need the same preset,
+ * since the histogram depends on demodulation.
+ *
+ * @param fingerprint first SubGhzCaptureFingerprint
+ * @param other second SubGhzCaptureFingerprint
+ * @return similarity score, 0..100
+ */
+uint8_t subghz_capture_fingerprint_compare(
+    const SubGhzCaptureFingerprint* fingerprint,
+    const SubGhzCaptureFingerprint* other);
+
+/** Build or update index of captures in a directory and its subdirectories
+ *
+ * Fingerprints of files with unchanged size and header CRC are taken from
+ * the previous index.
+ *
+ * @param storage Storage instance
+ * @param dir_path directory to index
+ * @param stats SubGhzCaptureIndexBuildStats to fill, may be NULL
+ * @return true on success
+ */
+bool subghz_capture_index_build(
+    Storage* storage,
+    const char* dir_path,
+    SubGhzCaptureIndexBuildStats* stats);
+
+/** Find indexed captures similar to the fingerprint
+ *
+ * @param storage Storage instance
+ * @param dir_path indexed directory
+ * @param fingerprint SubGhzCaptureFingerprint to look for
+ * @param min_score lowest score to report
+ * @param matches array to fill, best matches first
+ * @param matches_max matches array size
+ * @return number of matches found
+ */
+size_t subghz_capture_index_query(
+    Storage* storage,
+    const char* dir_path,
+    const SubGhzCaptureFingerprint* fingerprint,
+    uint8_t min_score,
+    SubGhzCaptureIndexMatch* matches,
+    size_t matches_max);
+
+#ifdef __cplusplus
+}
+#endif
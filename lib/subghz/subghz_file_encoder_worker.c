@@ -8,6 +8,27 @@
 #define TAG "SubGhzFileEncoderWorker"
 
 #define SUBGHZ_FILE_ENCODER_LOAD 512
+/* Every duration takes at least 2 bytes of text, so a chunk always fits into LOAD */
+#define SUBGHZ_FILE_ENCODER_CHUNK_SIZE 512
+#define SUBGHZ_FILE_ENCODER_BATCH_SIZE 64
+#define SUBGHZ_FILE_ENCODER_DURATION_MAX 1000000
+#define SUBGHZ_FILE_ENCODER_DURATION_OVERFLOW 100
+
+static const char subghz_file_encoder_raw_key[] = "RAW_Data";
+
+typedef enum {
+    SubGhzFileEncoderParserStateKey,
+    SubGhzFileEncoderParserStateValues,
+} SubGhzFileEncoderParserState;
+
+typedef struct {
+    SubGhzFileEncoderParserState state;
+    size_t key_length;
+    bool key_match;
+    uint32_t value;
+    bool value_negative;
+    bool value_present;
+} SubGhzFileEncoderParser;
 
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
@@ -24,6 +45,16 @@ struct SubGhzFileEncoderWorker {
     FuriString* file_path;
     const SubGhzDevice* device;
 
+    SubGhzFileEncoderParser parser;
+    uint8_t chunk[SUBGHZ_FILE_ENCODER_CHUNK_SIZE];
+    int32_t batch[SUBGHZ_FILE_ENCODER_BATCH_SIZE];
+    size_t batch_count;
+
+    uint32_t bytes_parsed;
+    uint32_t durations_parsed;
+    uint32_t read_us;
+    uint32_t parse_us;
+
     SubGhzFileEncoderWorkerCallbackEnd callback_end;
     void* context_end;
 };
@@ -38,7 +69,15 @@ void subghz_file_encoder_worker_callback_end(
     instance->context_end = context_end;
 }
 
-void subghz_file_encoder_worker_add_level_duration(
+static void subghz_file_encoder_worker_flush(SubGhzFileEncoderWorker* instance) {
+    if(instance->batch_count) {
+        furi_stream_buffer_send(
+            instance->stream, instance->batch, instance->batch_count * sizeof(int32_t), 100);
+        instance->batch_count = 0;
+    }
+}
+
+static void subghz_file_encoder_worker_add_level_duration(
     SubGhzFileEncoderWorker* instance,
     int32_t duration) {
     bool res = true;
@@ -50,47 +89,87 @@ void subghz_file_encoder_worker_add_level_duration(
 
     if(res) {
         instance->level = !instance->level;
-        furi_stream_buffer_send(instance->stream, &duration, sizeof(int32_t), 100);
+        instance->batch[instance->batch_count++] = duration;
+        instance->durations_parsed++;
+        if(instance->batch_count == SUBGHZ_FILE_ENCODER_BATCH_SIZE) {
+            subghz_file_encoder_worker_flush(instance);
+        }
     } else {
         FURI_LOG_E(TAG, "Invalid level in the stream");
     }
 }
 
-bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
-    char* str1;
-    int32_t temp_ds = 0;
-    bool res = false;
-    // Line sample: "RAW_Data: -1, 2, -2..."
-
-    // Look for a key in the line
-    str1 = strstr(strStart, "RAW_Data: ");
-
-    if(str1 != NULL) {
-        // Skip key
-        str1 = strchr(str1, ' ');
-
-        // Check that there is still an element in the line
-        while(strchr(str1, ' ') != NULL) {
-            str1 = strchr(str1, ' ');
-
-            // Skip space
-            str1 += 1;
-            //
-            temp_ds = atoi(str1);
-            if((temp_ds < -1000000) || (temp_ds > 1000000)) {
-                if(temp_ds > 0) {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)100);
-                } else {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)-100);
+static void subghz_file_encoder_worker_parser_reset(SubGhzFileEncoderParser* parser) {
+    parser->state = SubGhzFileEncoderParserStateKey;
+    parser->key_length = 0;
+    parser->key_match = true;
+    parser->value = 0;
+    parser->value_negative = false;
+    parser->value_present = false;
+}
+
+static void subghz_file_encoder_worker_parser_end_value(SubGhzFileEncoderWorker* instance) {
+    SubGhzFileEncoderParser* parser = &instance->parser;
+    if(parser->value_present) {
+        int32_t duration = (parser->value > SUBGHZ_FILE_ENCODER_DURATION_MAX) ?
+                               SUBGHZ_FILE_ENCODER_DURATION_OVERFLOW :
+                               (int32_t)parser->value;
+        subghz_file_encoder_worker_add_level_duration(
+            instance, parser->value_negative ? -duration : duration);
+    }
+    parser->value = 0;
+    parser->value_negative = false;
+    parser->value_present = false;
+}
+
+/** Parse a chunk of file continuing from where the previous one ended
+ *
+ * Line sample: "RAW_Data: -1 2 -2..."
+ *
+ * @return false if a line without RAW_Data key was found
+ */
+static bool subghz_file_encoder_worker_parse(
+    SubGhzFileEncoderWorker* instance,
+    const uint8_t* data,
+    size_t size) {
+    SubGhzFileEncoderParser* parser = &instance->parser;
+
+    for(size_t i = 0; i < size; i++) {
+        const char c = data[i];
+
+        if(parser->state == SubGhzFileEncoderParserStateValues) {
+            if(c >= '0' && c <= '9') {
+                // Saturate, anything above the limit is replaced anyway
+                if(parser->value <= SUBGHZ_FILE_ENCODER_DURATION_MAX) {
+                    parser->value = parser->value * 10 + (c - '0');
                 }
-                //FURI_LOG_I("PARSE", "Number overflow - %d", atoi(str1));
+                parser->value_present = true;
             } else {
-                subghz_file_encoder_worker_add_level_duration(instance, temp_ds);
+                subghz_file_encoder_worker_parser_end_value(instance);
+                if(c == '-') {
+                    parser->value_negative = true;
+                } else if(c == '\n') {
+                    subghz_file_encoder_worker_parser_reset(parser);
+                }
+            }
+        } else if(c == ':') {
+            if(!parser->key_match || parser->key_length != strlen(subghz_file_encoder_raw_key)) {
+                return false;
+            }
+            parser->state = SubGhzFileEncoderParserStateValues;
+        } else if(c == '\n') {
+            // Empty line has no RAW_Data key either
+            return false;
+        } else if(c != ' ' && c != '\r' && c != '\t') {
+            if(parser->key_length >= strlen(subghz_file_encoder_raw_key) ||
+               subghz_file_encoder_raw_key[parser->key_length] != c) {
+                parser->key_match = false;
             }
+            parser->key_length++;
         }
-        res = true;
     }
-    return res;
+
+    return true;
 }
 
 void subghz_file_encoder_worker_get_text_progress(
@@ -160,24 +239,54 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         FURI_LOG_I(TAG, "Start transmission");
     } while(0);
 
+    subghz_file_encoder_worker_parser_reset(&instance->parser);
+    instance->batch_count = 0;
+    instance->bytes_parsed = 0;
+    instance->durations_parsed = 0;
+    instance->read_us = 0;
+    instance->parse_us = 0;
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
     while(res && instance->worker_running) {
         size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
         if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
-                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                    break;
-                }
+            uint32_t read_start = DWT->CYCCNT;
+            size_t read = stream_read(stream, instance->chunk, SUBGHZ_FILE_ENCODER_CHUNK_SIZE);
+            uint32_t parse_start = DWT->CYCCNT;
+
+            bool more = (read > 0);
+            if(more) {
+                more = subghz_file_encoder_worker_parse(instance, instance->chunk, read);
             } else {
+                // File may end without a new line
+                subghz_file_encoder_worker_parser_end_value(instance);
+            }
+            if(!more) {
                 subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                break;
             }
+            subghz_file_encoder_worker_flush(instance);
+
+            instance->bytes_parsed += read;
+            instance->read_us += (parse_start - read_start) / cycles_per_us;
+            instance->parse_us += (DWT->CYCCNT - parse_start) / cycles_per_us;
+            if(!more) break;
         } else {
             furi_delay_ms(1);
         }
     }
+    uint32_t parse_rate =
+        instance->parse_us ?
+            (uint32_t)((uint64_t)instance->bytes_parsed * 1000 / instance->parse_us / 1024) :
+            0;
+    FURI_LOG_I(
+        TAG,
+        "Parsed %lu bytes, %lu durations, read %luus, parse %luus (%luKB/s)",
+        instance->bytes_parsed,
+        instance->durations_parsed,
+        instance->read_us,
+        instance->parse_us,
+        parse_rate);
+
     //waiting for the end of the transfer
     if(instance->is_storage_slow) {
         FURI_LOG_E(TAG, "Storage is slow");
@@ -1,6 +1,7 @@
 #include "compress.h"
 
 #include <furi.h>
+#include <stm32wbxx.h>
 #include <lib/heatshrink/heatshrink_encoder.h>
 #include <lib/heatshrink/heatshrink_decoder.h>
 
@@ -24,9 +25,16 @@ _Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
 
 struct CompressIcon {
     heatshrink_decoder* decoder;
+    /* Source of decoded_buff contents, only set for data residing in flash */
+    const uint8_t* decoded_src;
     uint8_t decoded_buff[COMPRESS_ICON_DECODED_BUFF_SIZE];
 };
 
+static bool compress_icon_is_in_flash(const uint8_t* icon_data) {
+    uint32_t address = (uint32_t)icon_data;
+    return (address >= FLASH_BASE) && (address < (FLASH_BASE + FLASH_SIZE));
+}
+
 CompressIcon* compress_icon_alloc() {
     CompressIcon* instance = malloc(sizeof(CompressIcon));
     instance->decoder = heatshrink_decoder_alloc(
@@ -51,7 +59,10 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
     furi_assert(decoded_buff);
 
     CompressHeader* header = (CompressHeader*)icon_data;
-    if(header->is_compressed) {
+    if(header->is_compressed && (instance->decoded_src == icon_data)) {
+        /* Same frame drawn again: flash contents can't change under us */
+        *decoded_buff = instance->decoded_buff;
+    } else if(header->is_compressed) {
         size_t data_processed = 0;
         heatshrink_decoder_sink(
             instance->decoder,
@@ -70,12 +81,24 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
             }
         }
         heatshrink_decoder_reset(instance->decoder);
+        instance->decoded_src = compress_icon_is_in_flash(icon_data) ? icon_data : NULL;
         *decoded_buff = instance->decoded_buff;
     } else {
         *decoded_buff = (uint8_t*)&icon_data[1];
     }
 }
 
+size_t compress_icon_get_compressed_size(const uint8_t* icon_data) {
+    furi_assert(icon_data);
+
+    CompressHeader* header = (CompressHeader*)icon_data;
+    if(header->is_compressed) {
+        return sizeof(CompressHeader) + header->compressed_buff_size;
+    } else {
+        return 0;
+    }
+}
+
 struct Compress {
     heatshrink_encoder* encoder;
     heatshrink_decoder* decoder;
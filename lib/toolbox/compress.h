@@ -30,7 +30,9 @@ void compress_icon_free(CompressIcon* instance);
 /** Decompress icon
  *
  * @warning    decoded_buff pointer set by this function is valid till next
- *             `compress_icon_decode` or `compress_icon_free` call
+ *             `compress_icon_decode` or `compress_icon_free` call. Contents
+ *             must not be modified: last decoded flash-resident icon is
+ *             reused without decoding it again.
  *
  * @param      instance      The Compress Icon instance
  * @param      icon_data     pointer to icon data
@@ -38,6 +40,14 @@ void compress_icon_free(CompressIcon* instance);
  */
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** decoded_buff);
 
+/** Get size of compressed icon data
+ *
+ * @param      icon_data  pointer to icon data
+ *
+ * @return     size of icon data including header, 0 if data is not compressed
+ */
+size_t compress_icon_get_compressed_size(const uint8_t* icon_data);
+
 /** Compress control structure */
 typedef struct Compress Compress;
 
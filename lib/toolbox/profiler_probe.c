@@ -0,0 +1,142 @@
+#include "profiler_probe.h"
+
+#include <furi.h>
+#include <furi_hal_cortex.h>
+
+/* Provided by the linker script */
+extern ProfilerProbe __profiler_probes_start[];
+extern ProfilerProbe __profiler_probes_end[];
+
+void profiler_probe_record(ProfilerProbe* probe, uint32_t cycles) {
+    probe->count++;
+    probe->total += cycles;
+    if(cycles < probe->min) probe->min = cycles;
+    if(cycles > probe->max) probe->max = cycles;
+
+    // log4 of duration
+    uint32_t bucket = cycles ? (31 - __CLZ(cycles)) / 2 : 0;
+    probe->histogram[MIN(bucket, (uint32_t)PROFILER_PROBE_HISTOGRAM_SIZE - 1)]++;
+}
+
+size_t profiler_probe_get_count() {
+    return __profiler_probes_end - __profiler_probes_start;
+}
+
+ProfilerProbe* profiler_probe_get(size_t index) {
+    furi_check(index < profiler_probe_get_count());
+    return &__profiler_probes_start[index];
+}
+
+ProfilerProbe* profiler_probe_find(const char* name) {
+    furi_assert(name);
+
+    for(ProfilerProbe* probe = __profiler_probes_start; probe < __profiler_probes_end; probe++) {
+        if(strcmp(probe->name, name) == 0) return probe;
+    }
+    return NULL;
+}
+
+void profiler_probe_reset(ProfilerProbe* probe) {
+    furi_assert(probe);
+
+    FURI_CRITICAL_ENTER();
+    probe->count = 0;
+    probe->total = 0;
+    probe->min = UINT32_MAX;
+    probe->max = 0;
+    memset(probe->histogram, 0, sizeof(probe->histogram));
+    FURI_CRITICAL_EXIT();
+}
+
+void profiler_probe_reset_all() {
+    for(ProfilerProbe* probe = __profiler_probes_start; probe < __profiler_probes_end; probe++) {
+        profiler_probe_reset(probe);
+    }
+}
+
+/* Statistics may change under our feet, work on a consistent copy */
+static void profiler_probe_snapshot(ProfilerProbe* probe, ProfilerProbe* snapshot) {
+    FURI_CRITICAL_ENTER();
+    *snapshot = *probe;
+    FURI_CRITICAL_EXIT();
+}
+
+void profiler_probe_dump() {
+    uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
+    printf("Probes:\r\n");
+    for(ProfilerProbe* probe = __profiler_probes_start; probe < __profiler_probes_end; probe++) {
+        ProfilerProbe snapshot;
+        profiler_probe_snapshot(probe, &snapshot);
+        if(!snapshot.count) continue;
+
+        uint32_t avg = snapshot.total / snapshot.count;
+        printf(
+            "\t%s[%lu]: total %lu us, avg %lu us, min %lu clk, avg %lu clk, max %lu clk\r\n",
+            snapshot.name,
+            snapshot.count,
+            (uint32_t)(snapshot.total / cycles_per_us),
+            avg / cycles_per_us,
+            snapshot.min,
+            avg,
+            snapshot.max);
+
+        printf("\t\thistogram, clk:");
+        for(size_t i = 0; i < PROFILER_PROBE_HISTOGRAM_SIZE; i++) {
+            if(snapshot.histogram[i]) {
+                printf(" >=%lu: %lu", 1UL << (i * 2), snapshot.histogram[i]);
+            }
+        }
+        printf("\r\n");
+    }
+}
+
+void profiler_probe_info_get(PropertyValueCallback out, char sep, void* context) {
+    furi_assert(out);
+
+    FuriString* value = furi_string_alloc();
+    FuriString* key = furi_string_alloc();
+
+    PropertyValueContext property_context = {
+        .key = key, .value = value, .out = out, .sep = sep, .last = false, .context = context};
+
+    property_value_out(&property_context, NULL, 2, "format", "major", "1");
+    property_value_out(&property_context, NULL, 2, "format", "minor", "0");
+    property_value_out(
+        &property_context,
+        "%lu",
+        1,
+        "clock",
+        furi_hal_cortex_instructions_per_microsecond() * 1000000UL);
+
+    FuriString* histogram = furi_string_alloc();
+    for(ProfilerProbe* probe = __profiler_probes_start; probe < __profiler_probes_end; probe++) {
+        ProfilerProbe snapshot;
+        profiler_probe_snapshot(probe, &snapshot);
+
+        property_value_out(&property_context, "%lu", 2, snapshot.name, "count", snapshot.count);
+        property_value_out(&property_context, "%llu", 2, snapshot.name, "total", snapshot.total);
+        property_value_out(
+            &property_context, "%lu", 2, snapshot.name, "min", snapshot.count ? snapshot.min : 0);
+        property_value_out(&property_context, "%lu", 2, snapshot.name, "max", snapshot.max);
+
+        furi_string_reset(histogram);
+        for(size_t i = 0; i < PROFILER_PROBE_HISTOGRAM_SIZE; i++) {
+            furi_string_cat_printf(histogram, i ? ",%lu" : "%lu", snapshot.histogram[i]);
+        }
+        property_value_out(
+            &property_context,
+            NULL,
+            2,
+            snapshot.name,
+            "histogram",
+            furi_string_get_cstr(histogram));
+    }
+    furi_string_free(histogram);
+
+    property_context.last = true;
+    property_value_out(&property_context, "%zu", 1, "count", profiler_probe_get_count());
+
+    furi_string_free(key);
+    furi_string_free(value);
+}
@@ -0,0 +1,138 @@
+/**
+ * @file profiler_probe.h
+ * Statically registered cycle counting probes
+ *
+ * Probes are defined once with PROFILER_PROBE_DEFINE and land in a dedicated
+ * linker section, so start and stop are just a few instructions with no lookup.
+ * Firmware only: applications don't get the section.
+ *
+ * Nesting state is kept in the probe itself, not per thread, so a probe must
+ * only be placed in code that runs in one thread. Put it in the caller instead
+ * of a function shared between threads, or define a probe per call site.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stm32wbxx.h>
+#include "property.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Histogram buckets, bucket N counts durations of [4^N, 4^(N+1)) cycles */
+#define PROFILER_PROBE_HISTOGRAM_SIZE (16)
+
+typedef struct {
+    const char* name;
+    uint32_t depth; /**< nesting level of the running measurement, shared by all threads */
+    uint32_t start; /**< cycle counter at the outermost start */
+    uint32_t count;
+    uint64_t total;
+    uint32_t min;
+    uint32_t max;
+    uint32_t histogram[PROFILER_PROBE_HISTOGRAM_SIZE];
+} ProfilerProbe;
+
+/** Define and register a probe, once per firmware */
+#define PROFILER_PROBE_DEFINE(probe_name)                      \
+    ProfilerProbe profiler_probe_##probe_name                  \
+        __attribute__((section(".profiler_probes"), used)) = { \
+            .name = #probe_name,                               \
+            .min = UINT32_MAX,                                 \
+    }
+
+/** Make a probe defined in another file visible */
+#define PROFILER_PROBE_DECLARE(probe_name) extern ProfilerProbe profiler_probe_##probe_name
+
+/** Get a probe by name */
+#define PROFILER_PROBE(probe_name) (&profiler_probe_##probe_name)
+
+/** Measure the rest of the enclosing scope */
+#define PROFILER_PROBE_SCOPE(probe_name)                                                  \
+    ProfilerProbe* profiler_probe_scope_##probe_name                                      \
+        __attribute__((cleanup(profiler_probe_scope_exit))) = PROFILER_PROBE(probe_name); \
+    profiler_probe_start(profiler_probe_scope_##probe_name)
+
+/** Add a measured duration to statistics, use profiler_probe_stop instead
+ *
+ * @param      probe   ProfilerProbe instance
+ * @param[in]  cycles  duration in CPU cycles
+ */
+void profiler_probe_record(ProfilerProbe* probe, uint32_t cycles);
+
+/** Start measurement
+ *
+ * Nested starts of the same probe are counted, only the outermost pair is
+ * measured. Starts from another thread would be counted as nested ones, so a
+ * probe must be used from a single thread only.
+ *
+ * @param      probe  ProfilerProbe instance
+ */
+static inline void profiler_probe_start(ProfilerProbe* probe) {
+    if(probe->depth++ == 0) {
+        probe->start = DWT->CYCCNT;
+    }
+}
+
+/** Stop measurement
+ *
+ * @param      probe  ProfilerProbe instance
+ */
+static inline void profiler_probe_stop(ProfilerProbe* probe) {
+    if(probe->depth && --probe->depth == 0) {
+        profiler_probe_record(probe, DWT->CYCCNT - probe->start);
+    }
+}
+
+static inline void profiler_probe_scope_exit(ProfilerProbe** probe) {
+    profiler_probe_stop(*probe);
+}
+
+/** Get registered probes count
+ *
+ * @return     probes count
+ */
+size_t profiler_probe_get_count();
+
+/** Get registered probe
+ *
+ * @param[in]  index  probe index, less than profiler_probe_get_count
+ *
+ * @return     ProfilerProbe instance
+ */
+ProfilerProbe* profiler_probe_get(size_t index);
+
+/** Find registered probe by name
+ *
+ * @param[in]  name  probe name
+ *
+ * @return     ProfilerProbe instance or NULL
+ */
+ProfilerProbe* profiler_probe_find(const char* name);
+
+/** Reset statistics of a probe, running measurement is kept
+ *
+ * @param      probe  ProfilerProbe instance
+ */
+void profiler_probe_reset(ProfilerProbe* probe);
+
+/** Reset statistics of all probes */
+void profiler_probe_reset_all();
+
+/** Print statistics of all probes that have been hit */
+void profiler_probe_dump();
+
+/** Get statistics of all probes as properties
+ *
+ * @param      out      property value callback
+ * @param[in]  sep      key parts separator
+ * @param      context  callback context
+ */
+void profiler_probe_info_get(PropertyValueCallback out, char sep, void* context);
+
+#ifdef __cplusplus
+}
+#endif
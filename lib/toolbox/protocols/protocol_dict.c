@@ -1,5 +1,8 @@
 #include <furi.h>
 #include "protocol_dict.h"
+#include "../profiler_probe.h"
+
+PROFILER_PROBE_DEFINE(protocol_dict_decoders_feed_batch);
 
 struct ProtocolDict {
     const ProtocolBase** base;
@@ -144,6 +147,37 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
     return ready_protocol_id;
 }
 
+ProtocolId protocol_dict_decoders_feed_batch_by_feature(
+    ProtocolDict* dict,
+    uint32_t feature,
+    bool level,
+    const uint32_t* durations,
+    size_t count,
+    size_t* consumed) {
+    PROFILER_PROBE_SCOPE(protocol_dict_decoders_feed_batch);
+    ProtocolId ready_protocol_id = PROTOCOL_NO;
+    // Decoders after the ready one only need to run up to it, ties go to the lower id
+    size_t limit = count;
+
+    for(size_t i = 0; i < dict->count; i++) {
+        if(!(dict->base[i]->features & feature)) continue;
+        ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
+        if(!fn) continue;
+
+        void* data = dict->data[i];
+        for(size_t j = 0; j < limit; j++) {
+            if(fn(data, level ^ (j & 1), durations[j])) {
+                ready_protocol_id = i;
+                limit = j;
+                break;
+            }
+        }
+    }
+
+    *consumed = (ready_protocol_id == PROTOCOL_NO) ? count : limit + 1;
+    return ready_protocol_id;
+}
+
 ProtocolId protocol_dict_decoders_feed_by_id(
     ProtocolDict* dict,
     size_t protocol_index,
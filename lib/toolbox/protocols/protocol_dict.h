@@ -48,6 +48,19 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
     bool level,
     uint32_t duration);
 
+/* Same as feeding durations one by one with protocol_dict_decoders_feed_by_feature
+ * until some decoder is ready, but every decoder runs through the batch at once.
+ * Levels alternate starting from `level`. `consumed` receives the number of durations
+ * up to and including the one that made a decoder ready. After a ready result the
+ * state of other decoders is undefined, restart them with protocol_dict_decoders_start. */
+ProtocolId protocol_dict_decoders_feed_batch_by_feature(
+    ProtocolDict* dict,
+    uint32_t feature,
+    bool level,
+    const uint32_t* durations,
+    size_t count,
+    size_t* consumed);
+
 ProtocolId protocol_dict_decoders_feed_by_id(
     ProtocolDict* dict,
     size_t protocol_index,
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+
+import bisect
+import struct
+from collections import Counter
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+from flipper.app import App
+from flipper.storage import FlipperStorage
+from flipper.utils.cdc import resolve_port
+
+# Matches FuriHalProfilerSample
+SAMPLE_FORMAT = "<III"
+SAMPLE_SIZE = struct.calcsize(SAMPLE_FORMAT)
+CHUNK_HEADER_FORMAT = "<H"
+CHUNK_HEADER_SIZE = struct.calcsize(CHUNK_HEADER_FORMAT)
+
+
+class Symbolizer:
+    def __init__(self, elf_path=None):
+        self.starts = []
+        self.functions = []
+        if not elf_path:
+            return
+
+        with open(elf_path, "rb") as file:
+            elf = ELFFile(file)
+            symbols = []
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for symbol in section.iter_symbols():
+                    if symbol["st_info"]["type"] != "STT_FUNC":
+                        continue
+                    # Thumb functions have the lowest address bit set
+                    start = symbol["st_value"] & ~1
+                    symbols.append((start, start + symbol["st_size"], symbol.name))
+
+        symbols.sort()
+        self.starts = [symbol[0] for symbol in symbols]
+        self.functions = symbols
+
+    def __call__(self, address):
+        if address == 0:
+            return "[interrupt]"
+        i = bisect.bisect_right(self.starts, address) - 1
+        if i >= 0:
+            start, end, name = self.functions[i]
+            if start <= address < end:
+                return name
+        return f"0x{address:08x}"
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser.add_argument("-e", "--elf", help="Firmware ELF for symbols")
+        self.parser.add_argument(
+            "-t", "--time", type=int, default=5000, help="Recording time, ms"
+        )
+        self.parser.add_argument(
+            "-o", "--output", help="Folded stacks output for flamegraph.pl"
+        )
+        self.parser.add_argument(
+            "-n", "--top", type=int, default=20, help="Hot functions to show"
+        )
+        self.parser.set_defaults(func=self.record)
+
+    def _read_exact(self, storage: FlipperStorage, size: int) -> bytes:
+        while len(storage.read.buffer) < size:
+            data = storage.port.read(max(1, storage.port.in_waiting))
+            if not data:
+                raise Exception("Timeout while reading samples")
+            storage.read.buffer.extend(data)
+        data = bytes(storage.read.buffer[:size])
+        storage.read.buffer = storage.read.buffer[size:]
+        return data
+
+    def _record(self, storage: FlipperStorage):
+        samples = []
+        storage.send(f"profiler record {self.args.time}\r")
+        storage.read.until("Ready" + storage.CLI_EOL)
+
+        while True:
+            header = self._read_exact(storage, CHUNK_HEADER_SIZE)
+            (count,) = struct.unpack(CHUNK_HEADER_FORMAT, header)
+            if count == 0:
+                break
+            data = self._read_exact(storage, count * SAMPLE_SIZE)
+            samples.extend(struct.iter_unpack(SAMPLE_FORMAT, data))
+
+        summary = {}
+        threads = {0: "Interrupts"}
+        text = storage.read.until(storage.CLI_PROMPT).decode("ascii", "replace")
+        for line in text.split(storage.CLI_EOL):
+            if line.startswith("Thread "):
+                _, thread, name = line.split(" ", 2)
+                threads[int(thread, 16)] = name
+            elif ": " in line:
+                key, value = line.split(": ", 1)
+                summary[key] = int(value)
+
+        return samples, summary, threads
+
+    def record(self):
+        if not (port := resolve_port(self.logger, self.args.port)):
+            return 1
+
+        symbolize = Symbolizer(self.args.elf)
+
+        with FlipperStorage(port) as storage:
+            self.logger.info(f"Recording for {self.args.time}ms")
+            samples, summary, threads = self._record(storage)
+
+        sleep_ticks = summary.get("Sleep ticks", 0)
+        dropped = summary.get("Dropped", 0)
+        total = len(samples) + sleep_ticks + dropped
+        if total == 0:
+            self.logger.error("No samples")
+            return 1
+
+        def percent(count):
+            return f"{count * 100 / total:5.1f}%"
+
+        self.logger.info(
+            f"{total} ticks, sleep {percent(sleep_ticks)}, dropped {dropped}"
+        )
+        self.logger.warning(
+            "Samples are taken on OS tick, work in phase with it is biased"
+        )
+
+        thread_counts = Counter(thread for _, _, thread in samples)
+        print(f"\n{'CPU':>6}  Thread")
+        for thread, count in thread_counts.most_common():
+            print(f"{percent(count)}  {threads.get(thread, f'0x{thread:08x}')}")
+
+        function_counts = Counter(symbolize(pc) for pc, _, _ in samples)
+        print(f"\n{'CPU':>6}  Function")
+        for function, count in function_counts.most_common(self.args.top):
+            print(f"{percent(count)}  {function}")
+
+        if self.args.output:
+            stacks = Counter()
+            for pc, lr, thread in samples:
+                name = threads.get(thread, f"0x{thread:08x}")
+                if pc == 0:
+                    stacks[name] += 1
+                else:
+                    stacks[f"{name};{symbolize(lr & ~1)};{symbolize(pc)}"] += 1
+            with open(self.args.output, "w") as file:
+                for stack, count in stacks.items():
+                    file.write(f"{stack} {count}\n")
+            self.logger.info(f"Folded stacks saved to {self.args.output}")
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+
+import os
+import threading
+import time
+
+from flipper.app import App
+from flipper.storage import FlipperStorage
+from flipper.utils.cdc import resolve_port
+
+
+class Main(App):
+    # Multiples of the 64 byte packet size end transfers with a ZLP
+    DEFAULT_SIZES = [1, 63, 64, 65, 512, 4096, 65536, 1048576]
+
+    def init(self):
+        self.parser.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser.add_argument(
+            "-s",
+            "--size",
+            type=int,
+            action="append",
+            help="Transfer size, may be repeated",
+        )
+        self.parser.add_argument(
+            "-c", "--count", type=int, default=1, help="Iterations per size"
+        )
+        self.parser.set_defaults(func=self.loopback)
+
+    def _transfer(self, storage: FlipperStorage, size: int) -> float:
+        data = os.urandom(size)
+
+        storage.send(f"vcp loopback {size}\r")
+        storage.read.until("Ready" + storage.CLI_EOL)
+
+        # Device echoes while we are still sending, so write from another thread
+        writer = threading.Thread(target=storage.port.write, args=(data,))
+        start = time.monotonic()
+        writer.start()
+
+        received = bytearray(storage.read.buffer)
+        storage.read.buffer = bytearray()
+        while len(received) < size:
+            chunk = storage.port.read(max(1, storage.port.in_waiting))
+            if not chunk:
+                break
+            received.extend(chunk)
+
+        elapsed = time.monotonic() - start
+        writer.join()
+        # Anything past the echoed data belongs to the prompt
+        storage.read.buffer = received[size:]
+        storage.read.until(storage.CLI_PROMPT)
+
+        if received[:size] != data:
+            raise Exception(f"Data mismatch: sent {size}, received {len(received)}")
+
+        return elapsed
+
+    def loopback(self):
+        if not (port := resolve_port(self.logger, self.args.port)):
+            return 1
+
+        sizes = self.args.size or self.DEFAULT_SIZES
+        with FlipperStorage(port) as storage:
+            storage.send_and_wait_prompt("vcp reset\r")
+
+            for size in sizes:
+                for _ in range(self.args.count):
+                    try:
+                        elapsed = self._transfer(storage, size)
+                    except Exception as e:
+                        self.logger.error(f"{size} bytes: {e}")
+                        return 1
+                    rate = size * 2 / elapsed / 1024 / 1024 if elapsed else 0
+                    self.logger.info(
+                        f"{size} bytes in {elapsed * 1000:.1f}ms, {rate:.2f} MB/s both ways"
+                    )
+
+            stats = storage.send_and_wait_prompt("vcp stats\r")
+            for line in stats.decode("ascii").split(storage.CLI_EOL)[1:]:
+                if line:
+                    self.logger.info(line)
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()